@@ -1,6 +1,7 @@
 #include "PluginProcessor.h"
 #include <random>
 #include "PluginEditor.h"
+#include "BinaryPluginState.h"
 
 // TODO: When going from vital to arprand, and then changing a value it crashes.
 // TODO: Attach debugger to reaper and mess around till it crashes
@@ -26,6 +27,19 @@ AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
 {
 }
 
+void AudioPluginAudioProcessor::SetRandomSeed (uint32_t seed)
+{
+	randomGenerator.seed (seed);
+}
+
+int AudioPluginAudioProcessor::drawInRange (int minimum, int maximum)
+{
+	const auto numValues = static_cast<uint64_t> (maximum - minimum + 1);
+
+	// Scales the 32-bit draw onto [0, numValues).
+	return minimum + static_cast<int> ((static_cast<uint64_t> (randomGenerator()) * numValues) >> 32);
+}
+
 juce::AudioProcessorValueTreeState::ParameterLayout AudioPluginAudioProcessor::createParameterLayout()
 {
 	std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameterList;
@@ -191,11 +205,11 @@ void AudioPluginAudioProcessor::handleArpStep (
     // --------------------------------------------------------------
     // 3. Pick a random held note (no repeats)
     // --------------------------------------------------------------
-    std::uniform_int_distribution<size_t> noteDist (0, heldNotes.size() - 1);
-    int selectedNote = heldNotes[noteDist (randomGenerator)];
+    const int lastNoteIndex = static_cast<int> (heldNotes.size()) - 1;
+    int selectedNote = heldNotes[static_cast<size_t> (drawInRange (0, lastNoteIndex))];
 
     while (selectedNote == previousPlayedNote && heldNotes.size() > 1)
-        selectedNote = heldNotes[noteDist (randomGenerator)];
+        selectedNote = heldNotes[static_cast<size_t> (drawInRange (0, lastNoteIndex))];
 
     // --------------------------------------------------------------
     // 4. Octave transposition (safe parameter access)
@@ -219,8 +233,7 @@ void AudioPluginAudioProcessor::handleArpStep (
 
         if (minOct < maxOct)
         {
-            std::uniform_int_distribution<int> octDist (minOct, maxOct);
-            const int octaveOffset = octDist (randomGenerator);
+            const int octaveOffset = drawInRange (minOct, maxOct);
             selectedNote += octaveOffset * 12;
             selectedNote = juce::jlimit (0, 127, selectedNote);
         }
@@ -588,14 +601,17 @@ juce::AudioProcessorEditor* AudioPluginAudioProcessor::createEditor()
 //==============================================================================
 void AudioPluginAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-	// Save all parameters as XML
-	auto xmlState = parameters.copyState().createXml();
-	copyXmlToBinary(*xmlState, destData);
+	// Parameter table in layout order (append new parameters at the end).
+	BinaryPluginState::Write(*this, destData);
 }
 
 void AudioPluginAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-	// Load parameters from XML
+	// processBlock reads the raw values, so Read needs no parameter batch.
+	if (BinaryPluginState::Read(*this, data, sizeInBytes))
+		return;
+
+	// Sessions saved before the binary format are XML.
 	std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
 	if (xmlState != nullptr)
@@ -38,6 +38,10 @@ public:
 
     double BPM = 120.0;
 
+    // Replaces the random_device seed, for reproducible output (Tools/Golden). Not thread
+    // safe: call before processing starts.
+    void SetRandomSeed (uint32_t seed);
+
     //==============================================================================
     int getNumPrograms() override;
     int getCurrentProgram() override;
@@ -60,6 +64,11 @@ private:
 		juce::MidiBuffer& OutputMidiBuffer
 	);
 
+	// Uniform in [minimum, maximum]. Maps the generator's output itself rather than going
+	// through std::uniform_int_distribution, whose algorithm differs between standard
+	// libraries, so a seed gives the same notes on every platform.
+	int drawInRange (int minimum, int maximum);
+
     //==============================================================================
     std::vector<int> heldNotes;       // Vector of held MIDI note numbers, sorted
     std::set<int> heldNotesSet;       // For quick lookup
@@ -0,0 +1,154 @@
+// ArpRandGolden: golden-output regression test. Plays fixed chords into the arpeggiator
+// under a running 120 BPM transport with a fixed seed, and checks every MIDI event it sends
+// (sample position and bytes) against the goldens in Tools/Golden/Goldens. Exits with 1 on
+// any difference or missing golden. Registered with CTest when built with
+// -DDR_BUILD_TOOLS=ON, once Tools/Golden/Goldens exists.
+//
+//   ArpRandGolden --goldens=<folder> [--update] [--allow-missing]
+//
+// --update rewrites the goldens from this build; see Utils/GoldenRegression.h at the repo
+// root.
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include "GoldenRegression.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double SampleRate = 48000.0;
+    constexpr int BlockSize = 512;
+    constexpr uint32_t RandomSeed = 0x5EEDC0DE;
+
+    // A transport that is always playing at a fixed tempo, moved on by hand every block.
+    class GoldenPlayHead : public juce::AudioPlayHead
+    {
+    public:
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo position;
+            position.setIsPlaying(true);
+            position.setBpm(120.0);
+            position.setTimeInSamples(TimeInSamples);
+
+            return position;
+        }
+
+        juce::int64 TimeInSamples = 0;
+    };
+
+    struct NoteEvent
+    {
+        int64_t SamplePosition = 0;
+        int NoteNumber = 0;
+        bool IsNoteOn = true;
+    };
+
+    // Feeds the note events in at their sample positions, block by block, and returns what
+    // the arpeggiator sent, one GoldenRegression::DescribeMidiEvent line per event.
+    juce::StringArray render(const std::vector<std::pair<const char*, float>>& settings,
+                             const std::vector<NoteEvent>& input,
+                             double seconds)
+    {
+        AudioPluginAudioProcessor processor;
+        GoldenPlayHead playHead;
+
+        for (const auto& [parameterID, value] : settings)
+        {
+            auto* parameter = processor.parameters.getParameter(parameterID);
+            jassert(parameter != nullptr);
+
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        }
+
+        processor.SetRandomSeed(RandomSeed);
+        processor.setPlayHead(&playHead);
+        processor.setRateAndBufferSizeDetails(SampleRate, BlockSize);
+        processor.prepareToPlay(SampleRate, BlockSize);
+
+        const auto totalSamples = static_cast<int64_t>(seconds * SampleRate);
+        juce::StringArray output;
+
+        for (int64_t blockStart = 0; blockStart < totalSamples; blockStart += BlockSize)
+        {
+            const int blockSamples = static_cast<int>(std::min<int64_t>(BlockSize, totalSamples - blockStart));
+
+            juce::MidiBuffer midi;
+
+            for (const auto& event : input)
+            {
+                if (event.SamplePosition < blockStart || event.SamplePosition >= blockStart + blockSamples)
+                    continue;
+
+                const auto message = event.IsNoteOn
+                    ? juce::MidiMessage::noteOn(1, event.NoteNumber, static_cast<juce::uint8>(100))
+                    : juce::MidiMessage::noteOff(1, event.NoteNumber);
+
+                midi.addEvent(message, static_cast<int>(event.SamplePosition - blockStart));
+            }
+
+            // A MIDI effect gets no audio channels, only the block length.
+            juce::AudioBuffer<float> audio(0, blockSamples);
+
+            playHead.TimeInSamples = blockStart;
+            processor.processBlock(audio, midi);
+
+            for (const auto metadata : midi)
+                output.add(GoldenRegression::DescribeMidiEvent(blockStart + metadata.samplePosition, metadata.getMessage()));
+        }
+
+        processor.releaseResources();
+        processor.setPlayHead(nullptr);
+
+        return output;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList arguments(argc, argv);
+    const auto options = GoldenRegression::ReadOptions(arguments);
+
+    if (!options.has_value())
+        return 1;
+
+    // MIDI is compared exactly, so there is no budget.
+    GoldenRegression::Checker checker(*options);
+
+    // Synced 16ths over a held C major chord, spread over an octave either side. The chord
+    // starts off the grid and ends with every note released in one block.
+    checker.CheckMidi("ArpRand_Synced_Octaves", render(
+    {
+        { "arpRate",       0.4f },
+        { "isFreeMode",    0.0f },
+        { "isOctaves",     1.0f },
+        { "octaveLower", -12.0f },
+        { "octaveHigher", 12.0f }
+    },
+    {
+        {  1000, 60, true },  {  1000, 64, true },  {  1000, 67, true },
+        { 96000, 60, false }, { 96000, 64, false }, { 96000, 67, false }
+    }, 2.5));
+
+    // Free-running rate with the held notes changing under it: a fourth note joins halfway
+    // and one of the first three lets go before the rest.
+    checker.CheckMidi("ArpRand_Free_ChangingChord", render(
+    {
+        { "arpRate",    0.7f },
+        { "isFreeMode", 1.0f },
+        { "isOctaves",  0.0f }
+    },
+    {
+        {      0, 57, true },  {      0, 60, true },  {    300, 64, true },
+        {  48000, 69, true },  {  72000, 60, false },
+        { 108000, 57, false }, { 108000, 64, false }, { 108000, 69, false }
+    }, 2.5));
+
+    return checker.GetExitCode();
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+class BackgroundJob;
+
+// One low-priority thread shared by every plugin instance in the process, for the
+// maintenance work that must stay off the audio thread: coefficient design, chain
+// rebuilds, anything that allocates.
+//
+// The worker sleeps on a semaphore until a job is requested. Requesting raises the job's
+// atomic flag and, when no wake is pending yet, releases the semaphore. Neither takes a
+// lock (juce::WaitableEvent::signal would lock a mutex shared with this background
+// thread), so the audio thread can request jobs without risking priority inversion.
+// Results travel back through a LatestValueMailbox owned by the job's owner.
+class BackgroundWorker : private juce::Thread
+{
+public:
+    BackgroundWorker() : juce::Thread("DR Background Worker")
+    {
+        startThread(juce::Thread::Priority::background);
+    }
+
+    ~BackgroundWorker() override
+    {
+        signalThreadShouldExit();
+        wake();
+        stopThread(1000);
+    }
+
+private:
+    friend class BackgroundJob;
+
+    // Shared between a BackgroundJob and the worker, so a pass that copied the job list
+    // never touches a job that was destroyed meanwhile.
+    struct JobState
+    {
+        explicit JobState(std::function<void()> newTask) : Task(std::move(newTask)) {}
+
+        std::function<void()> Task;
+
+        std::atomic<bool> Requested { false };
+        std::atomic<bool> Active { false };
+        std::atomic<int> HoldCount { 0 };
+
+        // Held while the task runs. Only the job's own owner ever waits on it.
+        std::mutex RunMutex;
+        bool Registered = true;
+    };
+
+    using JobStatePtr = std::shared_ptr<JobState>;
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wakeSemaphore.acquire();
+
+            // Cleared before the pass, so a request made during it wakes the next one.
+            wakePending.store(false, std::memory_order_release);
+            runRequestedJobs();
+        }
+    }
+
+    void runRequestedJobs();
+
+    // Any thread, lock-free. At most one release is outstanding, which keeps the binary
+    // semaphore within its count.
+    void wake()
+    {
+        if (!wakePending.exchange(true, std::memory_order_acq_rel))
+            wakeSemaphore.release();
+    }
+
+    void addJob(const JobStatePtr& job)
+    {
+        const std::scoped_lock lock(jobsMutex);
+        jobs.push_back(job);
+    }
+
+    // Waits for a run of this job in flight, never for any other job.
+    void removeJob(const JobStatePtr& job)
+    {
+        {
+            const std::scoped_lock runLock(job->RunMutex);
+            job->Registered = false;
+        }
+
+        const std::scoped_lock lock(jobsMutex);
+        jobs.erase(std::remove(jobs.begin(), jobs.end(), job), jobs.end());
+    }
+
+    std::binary_semaphore wakeSemaphore { 0 };
+    std::atomic<bool> wakePending { false };
+
+    // Guards the list only; tasks run on a copy with the lock released.
+    std::mutex jobsMutex;
+    std::vector<JobStatePtr> jobs;
+
+    // Worker thread only. Reused between passes so copying the list rarely allocates.
+    std::vector<JobStatePtr> jobsSnapshot;
+};
+
+// A coalescing unit of work on the shared BackgroundWorker.
+//
+// Declare it after every member its task touches: it is then destroyed first, and its
+// destructor waits for a run in flight before the rest of the owner goes away.
+class BackgroundJob
+{
+public:
+    explicit BackgroundJob(std::function<void()> newTask)
+        : state(std::make_shared<BackgroundWorker::JobState>(std::move(newTask)))
+    {
+        worker->addJob(state);
+    }
+
+    ~BackgroundJob()
+    {
+        worker->removeJob(state);
+    }
+
+    // Any thread. Requests made before the task gets to run are merged.
+    void Request()
+    {
+        if (!state->Requested.exchange(true, std::memory_order_acq_rel))
+            worker->wake();
+    }
+
+    // Not realtime. Runs the task on the calling thread, then lets the worker pick up
+    // further requests. Owners call this at the end of their PrepareToPlay.
+    void RunNow()
+    {
+        {
+            const std::scoped_lock lock(state->RunMutex);
+
+            state->Requested.store(false, std::memory_order_relaxed);
+            state->Task();
+
+            state->Active.store(true, std::memory_order_release);
+        }
+
+        if (state->Requested.load(std::memory_order_acquire))
+            worker->wake();
+    }
+
+    // Not realtime. Keeps the worker away from the task (waiting for a run in flight)
+    // while the owner re-prepares the state it reads.
+    void Suspend()
+    {
+        const std::scoped_lock lock(state->RunMutex);
+        state->Active.store(false, std::memory_order_release);
+    }
+
+    // Any thread. While held, requests pile up without running; the first worker pass
+    // after the last Release() runs the task once for all of them.
+    // Used to batch a whole state restore into a single rebuild.
+    void Hold()
+    {
+        state->HoldCount.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void Release()
+    {
+        if (state->HoldCount.fetch_sub(1, std::memory_order_acq_rel) == 1
+            && state->Requested.load(std::memory_order_acquire))
+        {
+            worker->wake();
+        }
+    }
+
+private:
+    BackgroundWorker::JobStatePtr state;
+
+    juce::SharedResourcePointer<BackgroundWorker> worker;
+};
+
+inline void BackgroundWorker::runRequestedJobs()
+{
+    {
+        const std::scoped_lock lock(jobsMutex);
+        jobsSnapshot.assign(jobs.begin(), jobs.end());
+    }
+
+    for (const auto& job : jobsSnapshot)
+    {
+        if (threadShouldExit())
+            break;
+
+        const std::scoped_lock runLock(job->RunMutex);
+
+        if (!job->Registered
+            || !job->Active.load(std::memory_order_acquire)
+            || job->HoldCount.load(std::memory_order_acquire) > 0)
+        {
+            continue;
+        }
+
+        if (job->Requested.exchange(false, std::memory_order_acq_rel))
+            job->Task();
+    }
+
+    // Drops the references, so a job removed meanwhile is freed here rather than next pass.
+    jobsSnapshot.clear();
+}
@@ -1,6 +1,15 @@
 #include "Chronoverb.h"
 
 Chronoverb::Chronoverb()
+    : stageGraph({
+        &Chronoverb::processDeverbStep,
+        &Chronoverb::processPitchShifterStep,
+        &Chronoverb::processDistortionStep,
+        &Chronoverb::processPostFiltersStep,
+        &Chronoverb::processDuckingStep,
+        &Chronoverb::processTapeStep,
+        &Chronoverb::processMixStep,
+        &Chronoverb::processStereoStep })
 {
     // Must happen at class construction
     DeverbLeftRight = std::make_unique<Deverb>();
@@ -10,92 +19,107 @@ Chronoverb::Chronoverb()
     StereoLeftRight = std::make_unique<Stereo>();
     DuckingLeftRight = std::make_unique<Ducking>();
     FilterLeftRight = std::make_unique<Filters>();
+    TapeLeftRight = std::make_unique<Tape>();
+
+    WetSpectrum = std::make_unique<SpectrumAnalyzer>();
+
+    SetRandomSeed(randomSeed.load());
 }
 
 void Chronoverb::PrepareToPlay(double newSampleRate)
 {
     sampleRate = newSampleRate;
 
-    // Pre-allocate dry snapshot buffer — avoids heap allocation on the audio thread.
-    // 2 channels, 4096 samples covers all typical DAW block sizes.
-    drySnapshot.setSize(2, 4096, false, true, false);
+    // Pre-allocated so the audio thread never touches the heap.
+    scratchArena.setSize(8, MaxBlockSize, false, true, true);
+
+    wetLeft = scratchArena.getWritePointer(0);
+    wetRight = scratchArena.getWritePointer(1);
+    dryPathLeft = scratchArena.getWritePointer(2);
+    dryPathRight = scratchArena.getWritePointer(3);
+    drySnapshotLeft = scratchArena.getWritePointer(4);
+    drySnapshotRight = scratchArena.getWritePointer(5);
+    spectrumTapLeft = scratchArena.getWritePointer(6);
+    spectrumTapRight = scratchArena.getWritePointer(7);
 
-    DeverbLeftRight->PrepareToPlay(newSampleRate, *FilterLeftRight);
+    smoothingBank.Prepare(sampleRate, MaxBlockSize);
+    stageGraph.Prepare();
 
-    PitchShifterLeftRight->PrepareToPlay(sampleRate, *FilterLeftRight);
-    DistortionLeftRight->PrepareToPlay(static_cast<float>(sampleRate));
+    DeverbLeftRight->PrepareToPlay(newSampleRate, *FilterLeftRight, smoothingBank);
+
+    PitchShifterLeftRight->PrepareToPlay(sampleRate, *FilterLeftRight, smoothingBank);
+    DistortionLeftRight->PrepareToPlay(static_cast<float>(sampleRate), smoothingBank);
     StereoLeftRight->PrepareToPlay(sampleRate);
     DuckingLeftRight->PrepareToPlay(sampleRate);
     FilterLeftRight->PrepareToPlay(sampleRate);
+    TapeLeftRight->PrepareToPlay(sampleRate, smoothingBank);
+    WetSpectrum->PrepareToPlay(sampleRate);
+
+    pitchBypass.Prepare(sampleRate);
+    pitchBypass.Reset(PitchShifterLeftRight->IsAudible());
+
+    stereoBypass.Prepare(sampleRate);
+    stereoBypass.Reset(StereoLeftRight->IsAudible());
+
+    tapeBypass.Prepare(sampleRate);
+    tapeBypass.Reset(TapeLeftRight->IsAudible());
 }
 
 void Chronoverb::ProcessBlock(juce::AudioBuffer<float>& audioBuffer)
+{
+    const int numSamples = audioBuffer.getNumSamples();
+
+    if (numSamples <= MaxBlockSize)
+    {
+        processSubBlock(audioBuffer);
+        return;
+    }
+
+    // Longer host blocks run in MaxBlockSize pieces so the scratch arena never overflows.
+    // Each piece refers to the host's channels in place; nothing is allocated.
+    for (int blockStart = 0; blockStart < numSamples; blockStart += MaxBlockSize)
+    {
+        juce::AudioBuffer<float> subBlock(audioBuffer.getArrayOfWritePointers(), audioBuffer.getNumChannels(),
+                                          blockStart, std::min(MaxBlockSize, numSamples - blockStart));
+        processSubBlock(subBlock);
+    }
+}
+
+void Chronoverb::processSubBlock(juce::AudioBuffer<float>& audioBuffer)
 {
     const int numChannels = audioBuffer.getNumChannels();
     const int numSamples  = audioBuffer.getNumSamples();
 
     // Snapshot dry input before any writes — prevents re-processing own output.
-    for (int ch = 0; ch < std::min(numChannels, 2); ++ch)
-        drySnapshot.copyFrom(ch, 0, audioBuffer, ch, 0, numSamples);
+    juce::FloatVectorOperations::copy(drySnapshotLeft, audioBuffer.getReadPointer(0), numSamples);
 
-    const float* drySnapL = drySnapshot.getReadPointer(0);
-    const float* drySnapR = drySnapshot.getReadPointer(numChannels > 1 ? 1 : 0);
+    if (numChannels > 1)
+        juce::FloatVectorOperations::copy(drySnapshotRight, audioBuffer.getReadPointer(1), numSamples);
 
-    float* leftData  = audioBuffer.getWritePointer(0);
-    float* rightData = (numChannels > 1 ? audioBuffer.getWritePointer(1) : nullptr);
+    inputLeft = drySnapshotLeft;
+    inputRight = numChannels > 1 ? drySnapshotRight : drySnapshotLeft;
 
     DeverbLeftRight->ProcessBlock(audioBuffer);
 
     PitchShifterLeftRight->ProcessBlock(audioBuffer);
     FilterLeftRight->ProcessBlock(audioBuffer);
+    TapeLeftRight->ProcessBlock(audioBuffer);
 
-    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
-    {
-        const float dryLeft = drySnapL[sampleIndex];
-        const float dryRight = drySnapR[sampleIndex];
-
-        // 1) Delay/Reverb (Deverb)
-        auto [deverbLeft, deverbRight] =
-            DeverbLeftRight->ProcessSample(dryLeft, dryRight);
+    // Stage ProcessBlocks have set their targets; render this block's ramps.
+    smoothingBank.Advance(numSamples);
 
-        // 2) Pitch shifter
-        auto [pitchLeft, pitchRight] =
-            PitchShifterLeftRight->ProcessSample(deverbLeft, deverbRight);
+    pitchBypass.SetAudible(PitchShifterLeftRight->IsAudible());
+    stereoBypass.SetAudible(StereoLeftRight->IsAudible());
+    tapeBypass.SetAudible(TapeLeftRight->IsAudible());
 
-        // 3) Distortion
-        auto [distortionDryLeft, distortionDryRight, distortionWetLeft, distortionWetRight] =
-            DistortionLeftRight->ProcessSample(dryLeft, dryRight, pitchLeft, pitchRight);
+    // Run the stages in the user's order, one block call each.
+    const StageGraph::Plan& plan = stageGraph.AcquirePlan();
 
-        // 4) Post filters
-        float postFilteredLeft = distortionWetLeft;
-        float postFilteredRight = distortionWetRight;
+    for (int stepIndex = 0; stepIndex < plan.NumSteps; ++stepIndex)
+        plan.Steps[static_cast<size_t>(stepIndex)](*this, numSamples);
 
-        if (filtersOrder == 2)
-        {
-            auto [filteredL, filteredR] =
-                FilterLeftRight->ProcessSample(distortionWetLeft, distortionWetRight);
+    audioBuffer.copyFrom(0, 0, wetLeft, numSamples);
 
-            postFilteredLeft = filteredL;
-            postFilteredRight = filteredR;
-        }
-
-        // 5) Ducking (shouldn't duck by distortion signal, since distortion crushes dynamics)
-        auto [duckedWetLeft, duckedWetRight] =
-            DuckingLeftRight->ProcessSample(dryLeft, dryRight,
-                postFilteredLeft, postFilteredRight);
-
-        // 6) Dry/wet volume gain + combine
-        float gainedLeft = (distortionDryLeft * dryVolume) + (duckedWetLeft * wetVolume);
-        float gainedRight = (distortionDryRight * dryVolume) + (duckedWetRight * wetVolume);
-
-        // 7) Stereo
-        auto [stereoLeft, stereoRight] =
-            StereoLeftRight->ProcessSample(gainedLeft, gainedRight);
-
-        // Write to buffer
-        leftData[sampleIndex] = stereoLeft;
-
-        if (rightData != nullptr)
-            rightData[sampleIndex] = stereoRight;
-    }
+    if (numChannels > 1)
+        audioBuffer.copyFrom(1, 0, wetRight, numSamples);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <atomic>
 #include <memory>
 
 #include "NewDelayReverb/Stages/Old/Delay.h"
@@ -10,6 +11,11 @@
 #include "NewDelayReverb/Stages/Ducking.h"
 #include "NewDelayReverb/Stages/Stereo.h"
 #include "NewDelayReverb/Stages/Filters.h"
+#include "NewDelayReverb/Stages/Tape.h"
+#include "NewDelayReverb/Stages/Utils/StageBypass.h"
+#include "RandomStream.h"
+#include "SpectrumAnalyzer.h"
+#include "StageGraph.h"
 
 class DelayLine;
 class DampingFilter;
@@ -18,6 +24,9 @@ class DiffusionChain;
 class Chronoverb
 {
 public:
+    // Largest block the stages process in one go; ProcessBlock splits longer host blocks.
+    static constexpr int MaxBlockSize = 4096;
+
     Chronoverb();
 
     void PrepareToPlay(double sampleRate);
@@ -29,6 +38,10 @@ public:
     std::unique_ptr<Stereo> StereoLeftRight;
     std::unique_ptr<Ducking> DuckingLeftRight;
     std::unique_ptr<Filters> FilterLeftRight;
+    std::unique_ptr<Tape> TapeLeftRight;
+
+    // Wet chain spectrum for the editor, idle unless a spectrum view switches it on.
+    std::unique_ptr<SpectrumAnalyzer> WetSpectrum;
 
     //region Parameter Sets
     void SetHostTempo(float bpm) const;
@@ -44,12 +57,16 @@ public:
     void SetWetVolume(float newWetVolume);
 
     void SetStereoSpread(float newSpreadMinus1To1);       // -1..1
+    void SetStageOrder(int orderIndex);                   // See StageGraph::GetOrderNames
 
     // Pitch
     void SetPitchRangeLower(float pitchRangeLowerSemitones);
     void SetPitchRangeUpper(float pitchRangeUpperSemitones);
     void SetPitchSequence(int sequenceIndex);                // 0=Up, 1=Down, 2=Random
     void SetpitchWetMix(float wetVolume);
+    void SetPitchAlgorithm(int algorithmIndex);              // 0=Granular, 1=Phase Vocoder
+    void SetPitchGrainCount(int grainCountIndex);            // 0=2, 1=4, 2=8 grains (granular)
+    void SetPitchGrainWindow(int windowIndex);               // 0=Hann, 1=Sqrt-Hann, 2=Tukey, 3=Blackman
 
     // Distortion
     void SetDistortionModuleEnabled(int moduleIndex, bool enabled);
@@ -63,21 +80,84 @@ public:
     void SetDuckAttack(float newDuckAttack);
     void SetDuckRelease(float newDuckRelease);
 
+    // Tape
+    void SetTapeEnabled(bool enabled);
+    void SetTapeWobbleRate(float rateHz);              // 0.05..15 Hz
+    void SetTapeWobbleDepth(float depth01);
+    void SetTapeSaturation(float saturation01);
+    void SetTapeNoiseEnabled(bool enabled);
+
     // Filters
     void SetFiltersOrder(int newOrder);                 // 0 = off, 1 = pre, 2 = post
     void SetLowPassCutoff(float newLowpass);            // 500..9000 Hz
     void SetHighPassCutoff(float newHighpass);          // 10..2000 Hz
+
+    // Random: seeds every random stream in the chain (pitch sequences, diffusion jitter,
+    // tape hiss). Same seed and input, same output; the plugin saves it with its state.
+    void SetRandomSeed(uint32_t newSeed);
+    uint32_t GetRandomSeed() const;
     //endregion
 
+    // Setter calls between Begin and End only record their values; each derived rebuild
+    // (diffusion layouts, filter design, pitch sequences) then runs once at the end.
+    // Batches may nest. See PluginParameterRegistry::ApplyAll.
+    void BeginParameterBatch();
+    void EndParameterBatch();
+
 private:
+    // ProcessBlock's body, for at most MaxBlockSize samples.
+    void processSubBlock(juce::AudioBuffer<float>& audioBuffer);
+
+    //region Stage graph steps (ChronoverbStages.cpp)
+    static void processDeverbStep(Chronoverb& chronoverb, int numSamples);
+    static void processPitchShifterStep(Chronoverb& chronoverb, int numSamples);
+    static void processDistortionStep(Chronoverb& chronoverb, int numSamples);
+    static void processPostFiltersStep(Chronoverb& chronoverb, int numSamples);
+    static void processDuckingStep(Chronoverb& chronoverb, int numSamples);
+    static void processTapeStep(Chronoverb& chronoverb, int numSamples);
+    static void processMixStep(Chronoverb& chronoverb, int numSamples);
+    static void processStereoStep(Chronoverb& chronoverb, int numSamples);
+    //endregion
 
     double sampleRate = 48000.0;
     float hostTempoBpm = 120.0f;
 
-    juce::AudioBuffer<float> drySnapshot;
+    // One arena for all per-block scratch: wet L/R, the dry path L/R (distortion can
+    // target the dry signal too), the dry input snapshot L/R, then the spectrum tap L/R
+    // for taps inside a stage. Sized once; later PrepareToPlay calls reuse it.
+    juce::AudioBuffer<float> scratchArena;
+
+    float* drySnapshotLeft = nullptr;
+    float* drySnapshotRight = nullptr;
+    float* spectrumTapLeft = nullptr;
+    float* spectrumTapRight = nullptr;
+
+    const float* inputLeft = nullptr;
+    const float* inputRight = nullptr;
+    float* wetLeft = nullptr;
+    float* wetRight = nullptr;
+    float* dryPathLeft = nullptr;
+    float* dryPathRight = nullptr;
+
+    StageGraph stageGraph;
+
+    // Shared by every stage, advanced once per block before the stage graph runs.
+    SmoothingBank smoothingBank;
+
+    // Faded skips for stages whose parameters make them silent
+    StageBypass pitchBypass;
+    StageBypass stereoBypass;
+    StageBypass tapeBypass;
 
     static constexpr int NumDistortionModules = 3;
 
+    // Streams derived from randomSeed
+    enum RandomStreamIds : uint32_t
+    {
+        PitchShifterStream,
+        TapeStream
+    };
+
     //region Parameters
     float delayMilliseconds = 300.0f;
     int delayMode = 0;
@@ -102,9 +182,20 @@ private:
     int pitchSequence = 0;
     float pitchStereoEnabled01 = 0.0f;
     float pitchWetMix = 0.0f;
+    int pitchAlgorithm = 0;
+    int pitchGrainCountIndex = 1;
+    int pitchGrainWindow = 0;
 
     float duckAmount = 0.0f;
     float duckAttack = 0.0f;
     float duckRelease = 0.0f;
+
+    bool tapeEnabled = false;
+    float tapeWobbleRate = 1.0f;
+    float tapeWobbleDepth = 0.3f;
+    float tapeSaturation = 0.0f;
+    bool tapeNoiseEnabled = false;
+
+    std::atomic<uint32_t> randomSeed { static_cast<uint32_t>(RandomStream::DefaultSeed) };
     //endregion
 };
\ No newline at end of file
@@ -74,6 +74,11 @@ void Chronoverb::SetStereoSpread(float newSpreadMinus1To1)
     StereoLeftRight->SetStereoSpread(stereoSpread);
 }
 
+void Chronoverb::SetStageOrder(int orderIndex)
+{
+    stageGraph.SetOrderIndex(std::clamp(orderIndex, 0, StageGraph::GetNumOrders() - 1));
+}
+
 // Pitch
 void Chronoverb::SetPitchRangeLower(float pitchRangeLowerSemitones)
 {
@@ -99,6 +104,24 @@ void Chronoverb::SetpitchWetMix(float newPitchWetMix)
     PitchShifterLeftRight->SetPitchWetMix(pitchWetMix);
 }
 
+void Chronoverb::SetPitchAlgorithm(int algorithmIndex)
+{
+    pitchAlgorithm = std::clamp(algorithmIndex, 0, 1);
+    PitchShifterLeftRight->SetPitchAlgorithm(pitchAlgorithm);
+}
+
+void Chronoverb::SetPitchGrainCount(int grainCountIndex)
+{
+    pitchGrainCountIndex = std::clamp(grainCountIndex, 0, 2);
+    PitchShifterLeftRight->SetPitchGrainCount(2 << pitchGrainCountIndex);
+}
+
+void Chronoverb::SetPitchGrainWindow(int windowIndex)
+{
+    pitchGrainWindow = std::clamp(windowIndex, 0, 3);
+    PitchShifterLeftRight->SetPitchGrainWindow(pitchGrainWindow);
+}
+
 // Distortion
 void Chronoverb::SetDistortionModuleEnabled(int moduleIndex, bool enabled)
 {
@@ -160,6 +183,37 @@ void Chronoverb::SetDuckRelease(float newDuckRelease)
     DuckingLeftRight->SetDuckRelease(duckRelease);
 }
 
+// Tape
+void Chronoverb::SetTapeEnabled(bool enabled)
+{
+    tapeEnabled = enabled;
+    TapeLeftRight->SetEnabled(tapeEnabled);
+}
+
+void Chronoverb::SetTapeWobbleRate(float rateHz)
+{
+    tapeWobbleRate = std::clamp(rateHz, 0.05f, 15.0f);
+    TapeLeftRight->SetWobbleRate(tapeWobbleRate);
+}
+
+void Chronoverb::SetTapeWobbleDepth(float depth01)
+{
+    tapeWobbleDepth = clamp01(depth01);
+    TapeLeftRight->SetWobbleDepth(tapeWobbleDepth);
+}
+
+void Chronoverb::SetTapeSaturation(float saturation01)
+{
+    tapeSaturation = clamp01(saturation01);
+    TapeLeftRight->SetSaturation(tapeSaturation);
+}
+
+void Chronoverb::SetTapeNoiseEnabled(bool enabled)
+{
+    tapeNoiseEnabled = enabled;
+    TapeLeftRight->SetNoiseEnabled(tapeNoiseEnabled);
+}
+
 // Filters
 void Chronoverb::SetFiltersOrder(int newOrder)
 {
@@ -179,6 +233,37 @@ void Chronoverb::SetHighPassCutoff(float newHighpass)
     FilterLeftRight->SetHighPassCutoff(highpassCutoff);
 }
 
+// Random
+void Chronoverb::SetRandomSeed(uint32_t newSeed)
+{
+    randomSeed = newSeed;
+
+    PitchShifterLeftRight->SetRandomSeed(RandomStream::DeriveSeed(newSeed, PitchShifterStream));
+    TapeLeftRight->SetRandomSeed(RandomStream::DeriveSeed(newSeed, TapeStream));
+}
+
+uint32_t Chronoverb::GetRandomSeed() const
+{
+    return randomSeed;
+}
+
+// Batching
+void Chronoverb::BeginParameterBatch()
+{
+    DeverbLeftRight->BeginParameterBatch();
+    PitchShifterLeftRight->BeginParameterBatch();
+    FilterLeftRight->BeginParameterBatch();
+    stageGraph.BeginParameterBatch();
+}
+
+void Chronoverb::EndParameterBatch()
+{
+    stageGraph.EndParameterBatch();
+    DeverbLeftRight->EndParameterBatch();
+    PitchShifterLeftRight->EndParameterBatch();
+    FilterLeftRight->EndParameterBatch();
+}
+
 // TODO
 
 /*void Chronoverb::SetHPLPPrePost(float prePost01)
@@ -0,0 +1,196 @@
+#include "Chronoverb.h"
+
+// Block steps for the stage graph. Each one walks the shared scratch buffers once
+// and calls the stage's (non-virtual) ProcessSample, so reordering costs one
+// indirect call per stage per block.
+
+// Also hosts the spectrum's pre- and post-damping taps
+void Chronoverb::processDeverbStep(Chronoverb& chronoverb, int numSamples)
+{
+    auto& deverb = *chronoverb.DeverbLeftRight;
+    auto& spectrum = *chronoverb.WetSpectrum;
+
+    const bool spectrumActive = spectrum.IsActive();
+    const auto spectrumTap = spectrum.GetTapPoint();
+    const bool tapPreDamping = spectrumActive && spectrumTap == SpectrumAnalyzer::TapPoint::PreDamping;
+
+    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        const float dryLeft = chronoverb.inputLeft[sampleIndex];
+        const float dryRight = chronoverb.inputRight[sampleIndex];
+
+        auto [deverbLeft, deverbRight] = deverb.ProcessSample(dryLeft, dryRight);
+
+        chronoverb.wetLeft[sampleIndex] = deverbLeft;
+        chronoverb.wetRight[sampleIndex] = deverbRight;
+
+        chronoverb.dryPathLeft[sampleIndex] = dryLeft;
+        chronoverb.dryPathRight[sampleIndex] = dryRight;
+
+        if (tapPreDamping)
+        {
+            auto [preDampingLeft, preDampingRight] = deverb.GetLastPreDampingSample();
+
+            chronoverb.spectrumTapLeft[sampleIndex] = preDampingLeft;
+            chronoverb.spectrumTapRight[sampleIndex] = preDampingRight;
+        }
+    }
+
+    if (tapPreDamping)
+        spectrum.PushSamples(chronoverb.spectrumTapLeft, chronoverb.spectrumTapRight, numSamples);
+    else if (spectrumActive && spectrumTap == SpectrumAnalyzer::TapPoint::PostDamping)
+        spectrum.PushSamples(chronoverb.wetLeft, chronoverb.wetRight, numSamples);
+}
+
+// Bypassed while its wet mix is off
+void Chronoverb::processPitchShifterStep(Chronoverb& chronoverb, int numSamples)
+{
+    auto& pitchShifter = *chronoverb.PitchShifterLeftRight;
+    auto& bypass = chronoverb.pitchBypass;
+
+    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        const float inputWetLeft = chronoverb.wetLeft[sampleIndex];
+        const float inputWetRight = chronoverb.wetRight[sampleIndex];
+
+        const float pitchGain = bypass.GetNextGain();
+
+        if (pitchGain > 0.0f)
+        {
+            auto [shiftedLeft, shiftedRight] = pitchShifter.ProcessSample(inputWetLeft, inputWetRight);
+
+            chronoverb.wetLeft[sampleIndex] += (shiftedLeft - inputWetLeft) * pitchGain;
+            chronoverb.wetRight[sampleIndex] += (shiftedRight - inputWetRight) * pitchGain;
+        }
+        else
+        {
+            pitchShifter.KeepWarm(inputWetLeft, inputWetRight);
+        }
+    }
+}
+
+void Chronoverb::processDistortionStep(Chronoverb& chronoverb, int numSamples)
+{
+    auto& distortion = *chronoverb.DistortionLeftRight;
+
+    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        auto [distortionDryLeft, distortionDryRight, distortionWetLeft, distortionWetRight] =
+            distortion.ProcessSample(chronoverb.dryPathLeft[sampleIndex], chronoverb.dryPathRight[sampleIndex],
+                chronoverb.wetLeft[sampleIndex], chronoverb.wetRight[sampleIndex]);
+
+        chronoverb.dryPathLeft[sampleIndex] = distortionDryLeft;
+        chronoverb.dryPathRight[sampleIndex] = distortionDryRight;
+        chronoverb.wetLeft[sampleIndex] = distortionWetLeft;
+        chronoverb.wetRight[sampleIndex] = distortionWetRight;
+    }
+
+    auto& spectrum = *chronoverb.WetSpectrum;
+
+    if (spectrum.IsActive() && spectrum.GetTapPoint() == SpectrumAnalyzer::TapPoint::PostDistortion)
+        spectrum.PushSamples(chronoverb.wetLeft, chronoverb.wetRight, numSamples);
+}
+
+// Only in "post" mode, "pre" runs inside Deverb's feedback loop
+void Chronoverb::processPostFiltersStep(Chronoverb& chronoverb, int numSamples)
+{
+    if (chronoverb.filtersOrder != 2)
+        return;
+
+    auto& filters = *chronoverb.FilterLeftRight;
+
+    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        auto [filteredLeft, filteredRight] =
+            filters.ProcessSample(chronoverb.wetLeft[sampleIndex], chronoverb.wetRight[sampleIndex]);
+
+        chronoverb.wetLeft[sampleIndex] = filteredLeft;
+        chronoverb.wetRight[sampleIndex] = filteredRight;
+    }
+}
+
+// Keyed by the clean input, since distortion crushes dynamics
+void Chronoverb::processDuckingStep(Chronoverb& chronoverb, int numSamples)
+{
+    auto& ducking = *chronoverb.DuckingLeftRight;
+
+    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        auto [duckedWetLeft, duckedWetRight] =
+            ducking.ProcessSample(chronoverb.inputLeft[sampleIndex], chronoverb.inputRight[sampleIndex],
+                chronoverb.wetLeft[sampleIndex], chronoverb.wetRight[sampleIndex]);
+
+        chronoverb.wetLeft[sampleIndex] = duckedWetLeft;
+        chronoverb.wetRight[sampleIndex] = duckedWetRight;
+    }
+}
+
+// Bypassed while disabled, the tape delay and LFO keep running
+void Chronoverb::processTapeStep(Chronoverb& chronoverb, int numSamples)
+{
+    auto& tape = *chronoverb.TapeLeftRight;
+    auto& bypass = chronoverb.tapeBypass;
+
+    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        const float inputWetLeft = chronoverb.wetLeft[sampleIndex];
+        const float inputWetRight = chronoverb.wetRight[sampleIndex];
+
+        const float tapeGain = bypass.GetNextGain();
+
+        if (tapeGain > 0.0f)
+        {
+            auto [tapeLeft, tapeRight] = tape.ProcessSample(inputWetLeft, inputWetRight);
+
+            chronoverb.wetLeft[sampleIndex] += (tapeLeft - inputWetLeft) * tapeGain;
+            chronoverb.wetRight[sampleIndex] += (tapeRight - inputWetRight) * tapeGain;
+        }
+        else
+        {
+            tape.KeepWarm(inputWetLeft, inputWetRight);
+        }
+    }
+}
+
+// Dry/wet volume gain + combine, the result replaces the wet buffers
+void Chronoverb::processMixStep(Chronoverb& chronoverb, int numSamples)
+{
+    const float dryVolume = chronoverb.dryVolume;
+    const float wetVolume = chronoverb.wetVolume;
+
+    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        chronoverb.wetLeft[sampleIndex] =
+            (chronoverb.dryPathLeft[sampleIndex] * dryVolume) + (chronoverb.wetLeft[sampleIndex] * wetVolume);
+
+        chronoverb.wetRight[sampleIndex] =
+            (chronoverb.dryPathRight[sampleIndex] * dryVolume) + (chronoverb.wetRight[sampleIndex] * wetVolume);
+    }
+}
+
+// Bypassed at spread 0
+void Chronoverb::processStereoStep(Chronoverb& chronoverb, int numSamples)
+{
+    auto& stereo = *chronoverb.StereoLeftRight;
+    auto& bypass = chronoverb.stereoBypass;
+
+    for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        const float mixedLeft = chronoverb.wetLeft[sampleIndex];
+        const float mixedRight = chronoverb.wetRight[sampleIndex];
+
+        const float stereoGain = bypass.GetNextGain();
+
+        if (stereoGain > 0.0f)
+        {
+            auto [spreadLeft, spreadRight] = stereo.ProcessSample(mixedLeft, mixedRight);
+
+            chronoverb.wetLeft[sampleIndex] += (spreadLeft - mixedLeft) * stereoGain;
+            chronoverb.wetRight[sampleIndex] += (spreadRight - mixedRight) * stereoGain;
+        }
+        else
+        {
+            stereo.KeepWarm(mixedLeft, mixedRight);
+        }
+    }
+}
@@ -21,6 +21,7 @@ void ComputerKeyboardSquareSynth::PrepareToPlay(double NewSampleRate)
     for (Voice& VoiceRef : Voices)
     {
         VoiceRef.IsActive = false;
+        VoiceRef.IsSounding = false;
         VoiceRef.MidiNote = -1;
         VoiceRef.Phase = 0.0;
         VoiceRef.PhaseIncrement = 0.0;
@@ -28,6 +29,8 @@ void ComputerKeyboardSquareSynth::PrepareToPlay(double NewSampleRate)
         VoiceRef.TargetAmplitude = 0.0f;
     }
 
+    NumActiveVoices = 0;
+
     HeldKeys.clear();
 
     EventReadIndex.store(0, std::memory_order_relaxed);
@@ -46,49 +49,36 @@ void ComputerKeyboardSquareSynth::Process(juce::AudioBuffer<float>& AudioBuffer)
     if (NumChannels <= 0 || NumSamples <= 0)
         return;
 
-    for (int SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+    for (int BlockStart = 0; BlockStart < NumSamples && NumActiveVoices > 0; BlockStart += RenderBlockSize)
     {
-        float MixedSample = 0.0f;
+        const int BlockSamples = std::min(RenderBlockSize, NumSamples - BlockStart);
+
+        std::fill_n(MixBlock.begin(), BlockSamples, 0.0f);
 
-        for (Voice& VoiceRef : Voices)
+        for (int ListIndex = 0; ListIndex < NumActiveVoices;)
         {
-            // Slew amplitude towards target
-            float Delta = VoiceRef.TargetAmplitude - VoiceRef.Amplitude;
-            VoiceRef.Amplitude += AmplitudeSlew * Delta;
+            Voice& VoiceRef = Voices[static_cast<size_t>(ActiveVoiceIndices[static_cast<size_t>(ListIndex)])];
 
-            // Deactivate silent voices that are fully released
-            if (!VoiceRef.IsActive && std::abs(VoiceRef.Amplitude) < 1.0e-5f && VoiceRef.TargetAmplitude <= 0.0f)
+            if (RenderVoice(VoiceRef, BlockSamples))
             {
-                VoiceRef.MidiNote = -1;
-                VoiceRef.Amplitude = 0.0f;
-                VoiceRef.Phase = 0.0;
-                VoiceRef.PhaseIncrement = 0.0;
-
+                ++ListIndex;
                 continue;
             }
 
-            if (VoiceRef.IsActive || VoiceRef.Amplitude > 1.0e-6f)
-            {
-                // Square wave
-                float Oscillator = (VoiceRef.Phase < 0.5 ? 1.0f : -1.0f);
-
-                // Apply amplitude and master gain
-                MixedSample += (Oscillator * VoiceRef.Amplitude * OutputGain);
-
-                // Advance phase
-                VoiceRef.Phase += VoiceRef.PhaseIncrement;
+            // Fully released: free the voice and swap it out of the list
+            VoiceRef.IsSounding = false;
+            VoiceRef.MidiNote = -1;
+            VoiceRef.Amplitude = 0.0f;
+            VoiceRef.Phase = 0.0;
+            VoiceRef.PhaseIncrement = 0.0;
 
-                if (VoiceRef.Phase >= 1.0)
-                    VoiceRef.Phase -= 1.0;
-            }
+            ActiveVoiceIndices[static_cast<size_t>(ListIndex)] = ActiveVoiceIndices[static_cast<size_t>(--NumActiveVoices)];
         }
 
-        // Write the mixed sample to all channels (add in place)
+        // Add the mix to all channels (in place), applying master gain
         for (int ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
-        {
-            float* ChannelData = AudioBuffer.getWritePointer(ChannelIndex);
-            ChannelData[SampleIndex] += MixedSample;
-        }
+            juce::FloatVectorOperations::addWithMultiply(AudioBuffer.getWritePointer(ChannelIndex, BlockStart),
+                MixBlock.data(), OutputGain, BlockSamples);
     }
 }
 
@@ -168,6 +158,65 @@ void ComputerKeyboardSquareSynth::DrainNoteEvents()
     EventReadIndex.store(read, std::memory_order_release);
 }
 
+bool ComputerKeyboardSquareSynth::RenderVoice(Voice& VoiceRef, int NumSamples)
+{
+    double Phase = VoiceRef.Phase;
+    const double PhaseIncrement = VoiceRef.PhaseIncrement;
+
+    float Amplitude = VoiceRef.Amplitude;
+    const float TargetAmplitude = VoiceRef.TargetAmplitude;
+
+    for (int SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+    {
+        // Slew amplitude towards target
+        Amplitude += AmplitudeSlew * (TargetAmplitude - Amplitude);
+
+        if (!VoiceRef.IsActive && std::abs(Amplitude) < 1.0e-5f && TargetAmplitude <= 0.0f)
+            return false;
+
+        // Square wave, with both edges smoothed by a PolyBLEP residual
+        double FallingEdgePhase = Phase + 0.5;
+
+        if (FallingEdgePhase >= 1.0)
+            FallingEdgePhase -= 1.0;
+
+        float Oscillator = (Phase < 0.5 ? 1.0f : -1.0f);
+        Oscillator += PolyBlep(Phase, PhaseIncrement);
+        Oscillator -= PolyBlep(FallingEdgePhase, PhaseIncrement);
+
+        MixBlock[static_cast<size_t>(SampleIndex)] += Oscillator * Amplitude;
+
+        // Advance phase
+        Phase += PhaseIncrement;
+
+        if (Phase >= 1.0)
+            Phase -= 1.0;
+    }
+
+    VoiceRef.Phase = Phase;
+    VoiceRef.Amplitude = Amplitude;
+
+    return true;
+}
+
+// Correction for a unit upward step at phase 0, spread over one sample either side.
+float ComputerKeyboardSquareSynth::PolyBlep(double Phase, double PhaseIncrement)
+{
+    if (Phase < PhaseIncrement)
+    {
+        const double T = Phase / PhaseIncrement;
+        return static_cast<float>(T + T - T * T - 1.0);
+    }
+
+    if (Phase > 1.0 - PhaseIncrement)
+    {
+        const double T = (Phase - 1.0) / PhaseIncrement;
+        return static_cast<float>(T * T + T + T + 1.0);
+    }
+
+    return 0.0f;
+}
+
 double ComputerKeyboardSquareSynth::MidiNoteToFrequency(int MidiNote)
 {
     return 440.0 * std::pow(2.0, (static_cast<double>(MidiNote) - 69.0) / 12.0);
@@ -194,8 +243,15 @@ void ComputerKeyboardSquareSynth::NoteOn(int MidiNote)
 
     const double Frequency = MidiNoteToFrequency(MidiNote);
     VoiceRef.PhaseIncrement = (Frequency / std::max(1.0, SampleRate));
-    // Optional: reset phase to start waves in-phase
-    VoiceRef.Phase = 0.0;
+
+    // New voices start in phase; retriggered or stolen ones keep running so the
+    // waveform has no jump the PolyBLEP can't see.
+    if (!VoiceRef.IsSounding)
+    {
+        VoiceRef.Phase = 0.0;
+        VoiceRef.IsSounding = true;
+        ActiveVoiceIndices[static_cast<size_t>(NumActiveVoices++)] = VoiceIndex;
+    }
 }
 
 void ComputerKeyboardSquareSynth::NoteOff(int MidiNote)
@@ -227,7 +283,7 @@ int ComputerKeyboardSquareSynth::FindFreeVoiceIndex() const
     {
         const Voice& VoiceRef = Voices[static_cast<size_t>(Index)];
 
-        if (!VoiceRef.IsActive && VoiceRef.TargetAmplitude <= 0.0f && std::abs(VoiceRef.Amplitude) < 1.0e-5f)
+        if (!VoiceRef.IsSounding)
             return Index;
     }
 
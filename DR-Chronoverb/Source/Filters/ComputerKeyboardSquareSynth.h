@@ -1,6 +1,7 @@
 #pragma once
 
 #include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -11,6 +12,8 @@
 // - Simple polyphonic square-wave generator driven by computer keyboard keys.
 // - Intended for standalone plugin testing without a DAW.
 // - Keys are mapped to musical notes (two rows for a piano-like layout).
+// - Band-limited (PolyBLEP) squares. Only sounding voices are rendered, one block per
+//   voice into a mix scratch, which is then added to each channel in one vector pass.
 // - Call PrepareToPlay() in your processor, Process() each block, and
 //   forward key changes from your editor via HandleKeyChange().
 //
@@ -43,7 +46,8 @@ public:
 private:
     struct Voice
     {
-        bool IsActive = false;
+        bool IsActive = false;           // Key held
+        bool IsSounding = false;         // In the active voice list (held or releasing)
         int MidiNote = -1;
         double Phase = 0.0;
         double PhaseIncrement = 0.0;
@@ -63,9 +67,17 @@ private:
 
     static constexpr int MaxVoices = 16; // Simple polyphony limit
     static constexpr int EventQueueSize = 64;
+    static constexpr int RenderBlockSize = 256;
 
     std::vector<Voice> Voices;
 
+    // Indices into Voices of the voices currently sounding, in no particular order
+    std::array<int, MaxVoices> ActiveVoiceIndices {};
+    int NumActiveVoices = 0;
+
+    // Voices are summed here before one add per channel
+    std::array<float, RenderBlockSize> MixBlock {};
+
     // Map from key code to MIDI note
     std::unordered_map<int, int> KeyToMidi;
 
@@ -81,7 +93,11 @@ private:
 
     void DrainNoteEvents();
 
+    // Adds NumSamples of the voice into MixBlock. Returns false once it has fully released.
+    bool RenderVoice(Voice& VoiceRef, int NumSamples);
+
     // Helpers
+    static float PolyBlep(double Phase, double PhaseIncrement);
     static double MidiNoteToFrequency(int MidiNote);
     void NoteOn(int MidiNote);
     void NoteOff(int MidiNote);
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// MeasurementSignalGenerator
+// - Stimuli for capturing impulse responses: a single-sample impulse, an exponential
+//   (log) sine sweep, a maximum length sequence and a white noise burst.
+// - Designed to be used like ImpulseClickSynth: call PrepareToPlay(), then Process(buffer),
+//   which adds the running signal to every channel.
+// - Signals are rendered a block at a time and are fully deterministic. RenderSignal()
+//   produces the exact samples offline, which the measurement tool (Tools/Measurement)
+//   uses as the reference when deconvolving a capture.
+class MeasurementSignalGenerator
+{
+public:
+    enum class Signal
+    {
+        Impulse,
+        LogSweep,
+        Mls,
+        NoiseBurst
+    };
+
+    static constexpr float Amplitude = 0.5f;
+
+    static constexpr double SweepStartHz = 20.0;
+    static constexpr double SweepEndHz = 20000.0;
+    static constexpr double SweepSeconds = 6.0;
+
+    // 2^16 - 1 samples per period; the first period settles the reverb, the second is measured.
+    static constexpr int MlsOrder = 16;
+    static constexpr int MlsRepetitions = 2;
+
+    static constexpr double BurstSeconds = 0.5;
+
+    // Raised-cosine fades on the sweep and the noise burst, so neither starts with a click.
+    static constexpr double FadeSeconds = 0.005;
+
+    void PrepareToPlay(double newSampleRate)
+    {
+        sampleRate = (newSampleRate > 0.0 ? newSampleRate : 48000.0);
+        remainingSamples = 0;
+        pendingSignal.store(-1, std::memory_order_release);
+    }
+
+    // UI thread safe: (re)starts a signal from its first sample.
+    void Trigger(Signal signalToPlay)
+    {
+        pendingSignal.store(static_cast<int>(signalToPlay), std::memory_order_release);
+    }
+
+    bool IsRunning() const
+    {
+        return remainingSamples > 0;
+    }
+
+    void Process(juce::AudioBuffer<float>& buffer)
+    {
+        const int numChannels = buffer.getNumChannels();
+        const int numSamples = buffer.getNumSamples();
+
+        if (numChannels <= 0 || numSamples <= 0)
+            return;
+
+        const int requestedSignal = pendingSignal.exchange(-1, std::memory_order_acq_rel);
+
+        if (requestedSignal >= 0)
+            start(static_cast<Signal>(requestedSignal));
+
+        for (int blockStart = 0; blockStart < numSamples && remainingSamples > 0; blockStart += ScratchSize)
+        {
+            const int blockSamples = std::min({ ScratchSize, numSamples - blockStart, remainingSamples });
+
+            renderBlock(scratch.data(), blockSamples);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                juce::FloatVectorOperations::add(buffer.getWritePointer(channel, blockStart), scratch.data(), blockSamples);
+        }
+    }
+
+    static int GetLengthSamples(Signal signal, double signalSampleRate)
+    {
+        switch (signal)
+        {
+            case Signal::Impulse:    return 1;
+            case Signal::LogSweep:   return static_cast<int>(std::round(SweepSeconds * signalSampleRate));
+            case Signal::Mls:        return ((1 << MlsOrder) - 1) * MlsRepetitions;
+            case Signal::NoiseBurst: return static_cast<int>(std::round(BurstSeconds * signalSampleRate));
+        }
+
+        return 0;
+    }
+
+    // Not realtime. The whole signal, exactly as Process() plays it.
+    static std::vector<float> RenderSignal(Signal signal, double signalSampleRate)
+    {
+        MeasurementSignalGenerator generator;
+        generator.PrepareToPlay(signalSampleRate);
+        generator.start(signal);
+
+        std::vector<float> samples(static_cast<size_t>(generator.remainingSamples));
+
+        for (size_t blockStart = 0; blockStart < samples.size(); blockStart += ScratchSize)
+        {
+            const int blockSamples = static_cast<int>(std::min(samples.size() - blockStart, static_cast<size_t>(ScratchSize)));
+            generator.renderBlock(samples.data() + blockStart, blockSamples);
+        }
+
+        return samples;
+    }
+
+private:
+    static constexpr int ScratchSize = 256;
+
+    void start(Signal newSignal)
+    {
+        signal = newSignal;
+        position = 0;
+        lengthSamples = GetLengthSamples(signal, sampleRate);
+        remainingSamples = lengthSamples;
+        fadeSamples = std::max(1, static_cast<int>(std::round(FadeSeconds * sampleRate)));
+
+        // phase(t) = 2 pi f0 L (e^(t / L) - 1), with L = T / ln(f1 / f0)
+        const double endHz = std::min(SweepEndHz, 0.475 * sampleRate);
+        const double rateConstant = SweepSeconds / std::log(endHz / SweepStartHz);
+
+        sweepPhaseScale = juce::MathConstants<double>::twoPi * SweepStartHz * rateConstant;
+        sweepGrowth = std::exp(1.0 / (sampleRate * rateConstant));
+        sweepExponential = 1.0;
+
+        mlsState = 1;
+        noiseState = NoiseSeed;
+    }
+
+    // Writes the next numSamples (at most remainingSamples) and advances.
+    void renderBlock(float* destination, int numSamples)
+    {
+        switch (signal)
+        {
+            case Signal::Impulse:
+                std::fill_n(destination, numSamples, 0.0f);
+
+                if (position == 0)
+                    destination[0] = Amplitude;
+
+                break;
+
+            case Signal::LogSweep:
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const double phase = sweepPhaseScale * (sweepExponential - 1.0);
+                    sweepExponential *= sweepGrowth;
+
+                    destination[i] = static_cast<float>(std::sin(phase)) * Amplitude * getFadeGain(position + i);
+                }
+
+                break;
+
+            case Signal::Mls:
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    // Galois LFSR for x^16 + x^14 + x^13 + x^11 + 1
+                    const uint32_t outputBit = mlsState & 1u;
+                    mlsState >>= 1;
+
+                    if (outputBit != 0)
+                        mlsState ^= MlsTaps;
+
+                    destination[i] = (outputBit != 0 ? Amplitude : -Amplitude);
+                }
+
+                break;
+
+            case Signal::NoiseBurst:
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    // xorshift32, uniform in [-1, 1)
+                    noiseState ^= noiseState << 13;
+                    noiseState ^= noiseState >> 17;
+                    noiseState ^= noiseState << 5;
+
+                    const float uniform = static_cast<float>(noiseState * (1.0 / 2147483648.0) - 1.0);
+                    destination[i] = uniform * Amplitude * getFadeGain(position + i);
+                }
+
+                break;
+        }
+
+        position += numSamples;
+        remainingSamples -= numSamples;
+    }
+
+    float getFadeGain(int samplePosition) const
+    {
+        const int distanceFromEdge = std::min(samplePosition, lengthSamples - 1 - samplePosition);
+
+        if (distanceFromEdge >= fadeSamples)
+            return 1.0f;
+
+        const double fraction = static_cast<double>(distanceFromEdge) / static_cast<double>(fadeSamples);
+        return static_cast<float>(0.5 - 0.5 * std::cos(juce::MathConstants<double>::pi * fraction));
+    }
+
+    static constexpr uint32_t MlsTaps = 0xB400u;
+    static constexpr uint32_t NoiseSeed = 0x9E3779B9u;
+
+    double sampleRate = 48000.0;
+
+    std::atomic<int> pendingSignal { -1 };
+
+    Signal signal = Signal::Impulse;
+    int position = 0;
+    int lengthSamples = 0;
+    int remainingSamples = 0;
+    int fadeSamples = 1;
+
+    double sweepPhaseScale = 0.0;
+    double sweepGrowth = 1.0;
+    double sweepExponential = 1.0;
+
+    uint32_t mlsState = 1;
+    uint32_t noiseState = NoiseSeed;
+
+    std::array<float, ScratchSize> scratch {};
+};
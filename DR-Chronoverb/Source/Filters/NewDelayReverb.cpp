@@ -42,6 +42,10 @@ void NewDelayReverb::PrepareToPlay(double newSampleRate)
     delayDiffusionReadLeft->Prepare(sampleRate);
     delayDiffusionReadRight->Prepare(sampleRate);
 
+    // A jitter stream per chain, so left and right stay decorrelated
+    delayDiffusionReadLeft->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 0));
+    delayDiffusionReadRight->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 1));
+
     if (delayDiffusionReadLeft) delayDiffusionReadLeft->ClearState();
     if (delayDiffusionReadRight) delayDiffusionReadRight->ClearState();
 
@@ -51,6 +55,8 @@ void NewDelayReverb::PrepareToPlay(double newSampleRate)
 
     delayDiffusionWriteLeft->Prepare(sampleRate);
     delayDiffusionWriteRight->Prepare(sampleRate);
+    delayDiffusionWriteLeft->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 2));
+    delayDiffusionWriteRight->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 3));
 
     if (delayDiffusionWriteLeft) delayDiffusionWriteLeft->ClearState();
     if (delayDiffusionWriteRight) delayDiffusionWriteRight->ClearState();
@@ -60,6 +66,8 @@ void NewDelayReverb::PrepareToPlay(double newSampleRate)
     reverbDiffusionRight = std::make_unique<DiffusionChain>();
     reverbDiffusionLeft->Prepare(sampleRate);
     reverbDiffusionRight->Prepare(sampleRate);
+    reverbDiffusionLeft->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 4));
+    reverbDiffusionRight->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 5));
 
     // Force full rebuild
     lastBuiltQualityStages = -1;
@@ -103,6 +111,8 @@ void NewDelayReverb::PrepareToPlay(double newSampleRate)
 
     pitchDiffusionLeft->Prepare(sampleRate);
     pitchDiffusionRight->Prepare(sampleRate);
+    pitchDiffusionLeft->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 6));
+    pitchDiffusionRight->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 7));
 
     lastPitchDiffFeedbackL = 0.0f;
     lastPitchDiffFeedbackR = 0.0f;
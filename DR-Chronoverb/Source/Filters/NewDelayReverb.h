@@ -18,8 +18,9 @@ class DiffusionChain;
 class NewDelayReverb
 {
 public:
-    // Delay-mode tunings: shorter, natural-spacing delays for discrete-tap blur.
-    std::vector<float> DelayTunings =
+    // Delay-mode tunings: shorter, natural-spacing delays for discrete-tap blur. The tuning
+    // sets are constants, so they are static and every instance reads the same copy.
+    static inline const std::vector<float> DelayTunings =
     {
         10.0, 15.0, 22.0, 33.0, 50.0, 75.0, 113.0, 170.0    // Natural
         //7.0, 13.0, 19.0, 29.0, 53.0, 79.0, 113.0, 149.0   // Generated primes
@@ -29,16 +30,11 @@ public:
     };
 
     // Reverb-mode tunings: longer, prime-spaced delays for lush modal density.
-    std::vector<float> ReverbTunings =
+    static inline const std::vector<float> ReverbTunings =
     {
         29.0f, 37.0f, 43.0f, 53.0f, 71.0f, 89.0f, 113.0f, 149.0f
     };
 
-    std::vector<float> PitchMaskTunings
-    {
-        5.0f, 8.0f, 12.0f, 17.0f, 23.0f, 31.0f, 43.0f, 59.0f
-    };
-
     void PrepareToPlay(double sampleRate);
     void ProcessBlock(juce::AudioBuffer<float>& audioBuffer);
 
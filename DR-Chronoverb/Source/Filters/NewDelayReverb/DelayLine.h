@@ -14,7 +14,14 @@ class DelayLine
 public:
     explicit DelayLine(int maxSamples)
     {
-        buffer.resize(std::max(1, maxSamples), 0.0f);
+        Resize(maxSamples);
+    }
+
+    // Clears the line. Keeps the existing allocation when it is already large enough,
+    // so re-preparing at the same sample rate doesn't touch the heap.
+    void Resize(int maxSamples)
+    {
+        buffer.assign(static_cast<size_t>(std::max(1, maxSamples)), 0.0f);
         writeIndex = 0;
     }
 
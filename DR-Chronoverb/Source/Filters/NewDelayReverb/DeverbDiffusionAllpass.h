@@ -140,15 +140,48 @@ public:
         writeIndex = 0;
     }
 
+    // Buffer size SetDelayMilliseconds would grow to for this delay. Reads only
+    // prepare-time settings, so it can be called from the background worker.
+    [[nodiscard]] int GetRequiredBufferSize(float delayMilliseconds) const
+    {
+        const int delaySamples = std::max(
+            1,
+            static_cast<int>(std::round((std::max(1.0f, delayMilliseconds) * static_cast<float>(sampleRate)) / 1000.0f)));
+
+        return getRequiredBufferSize(delaySamples);
+    }
+
+    [[nodiscard]] int GetBufferSize() const
+    {
+        return static_cast<int>(buffer.size());
+    }
+
+    // Takes over a larger buffer allocated elsewhere, keeping the current contents in
+    // place exactly like an in-place resize would. The old buffer is handed back through
+    // newBuffer so it can be freed off the audio thread.
+    void AdoptBuffer(std::vector<float>& newBuffer)
+    {
+        if (newBuffer.size() <= buffer.size())
+            return;
+
+        std::copy(buffer.begin(), buffer.end(), newBuffer.begin());
+        buffer.swap(newBuffer);
+    }
+
 private:
-    void ensureBufferSize()
+    [[nodiscard]] int getRequiredBufferSize(int delaySamples) const
     {
         // Extra headroom: +4 for interpolation safety, and enough
         // for the maximum jitter offset that could be applied later.
         const int maxJitterSamples = static_cast<int>(
             std::ceil((maxJitterDepthMs * static_cast<float>(sampleRate)) / 1000.0f));
 
-        const int minSize = std::max(4, delaySamplesInteger + maxJitterSamples + 4);
+        return std::max(4, delaySamples + maxJitterSamples + 4);
+    }
+
+    void ensureBufferSize()
+    {
+        const int minSize = getRequiredBufferSize(delaySamplesInteger);
 
         if (static_cast<int>(buffer.size()) < minSize)
             buffer.resize(static_cast<size_t>(minSize), 0.0f);
@@ -1,8 +1,10 @@
 #include "DeverbDiffusionChain.h"
 
 void DeverbDiffusionChain::Prepare(double newSampleRate, std::array<float, MaxStages> stageTunings,
-    float jitterRate, float jitterDepth)
+    float jitterRate, float jitterDepth, SmoothingBank& smoothingBank)
 {
+    layoutJob.Suspend();
+
     sampleRate = std::max(1.0, newSampleRate);
     stageTuningsMs = stageTunings;
 
@@ -14,8 +16,11 @@ void DeverbDiffusionChain::Prepare(double newSampleRate, std::array<float, MaxSt
     for (size_t i = 0; i < MaxStages; ++i)
         totalTuningMs += stageTuningsMs[i];
 
-    for (auto& allpass : allpasses)
-        allpass.Prepare(sampleRate);
+    for (size_t i = 0; i < MaxStages; ++i)
+    {
+        allpasses[i].Prepare(sampleRate);
+        stageBufferSizes[i].store(allpasses[i].GetBufferSize(), std::memory_order_release);
+    }
 
     // Initialize LFO phases spread evenly to decorrelate stages
     for (size_t i = 0; i < MaxStages; ++i)
@@ -30,16 +35,27 @@ void DeverbDiffusionChain::Prepare(double newSampleRate, std::array<float, MaxSt
                       / static_cast<float>(sampleRate);
     }
 
-    rebuildStageDelays();
-    Reset();
-
     gainSlewCoefficient = 1.0f / (0.01f * static_cast<float>(sampleRate));         // ~10 ms
 
+    for (auto& smoother : stageGainSmoothers)
+    {
+        smoother = smoothingBank.Register(SmoothingBank::RampType::Exponential, 0.0f);
+        smoother.SetCoefficient(gainSlewCoefficient);
+    }
+
     // Prevent startup
     targetQualityCompensation  = 1.0f;
 
-    distributedTuningsMs = buildDistributedTunings(activeStages);
-    distributedGainMultipliers = buildDistributedGains(targetStageGains, activeStages);
+    distributedGainMultipliers = buildDistributedGains(targetStageGains,
+        static_cast<size_t>(requestedStages.load()));
+
+    Reset();
+}
+
+void DeverbDiffusionChain::RebuildLayoutNow()
+{
+    layoutJob.RunNow();
+    applyStageLayout();
 }
 
 void DeverbDiffusionChain::Reset()
@@ -59,18 +75,21 @@ void DeverbDiffusionChain::SetDiffusionAmount(float newAmount01)
 void DeverbDiffusionChain::SetDiffusionSize(float newSize01)
 {
     //size01 = std::clamp(newSize01, 0.0f, 1.0f);
-    size01 = newSize01;
-    rebuildStageDelays();
+    if (newSize01 == requestedSize01)
+        return;
+
+    requestedSize01 = newSize01;
+    layoutJob.Request();
 }
 
 void DeverbDiffusionChain::SetDiffusionQuality(int newStageCount)
 {
-    activeStages = static_cast<size_t>(std::clamp(newStageCount, 1, MaxStages));
+    requestedStages = std::clamp(newStageCount, 1, MaxStages);
 
-    distributedTuningsMs = buildDistributedTunings(activeStages);
-    distributedGainMultipliers = buildDistributedGains(targetStageGains, activeStages);
+    distributedGainMultipliers = buildDistributedGains(targetStageGains,
+        static_cast<size_t>(requestedStages.load()));
 
-    rebuildStageDelays();
+    layoutJob.Request();
 
     // No compensation
     targetQualityCompensation = 1.0f;
@@ -83,12 +102,31 @@ void DeverbDiffusionChain::SetStageGains(float baseGain, std::array<float, MaxSt
     for (size_t i = 0; i < MaxStages; ++i)
         targetStageGains[i] = baseGain * stageGains[i];
 
-    distributedGainMultipliers = buildDistributedGains(targetStageGains, activeStages);
+    distributedGainMultipliers = buildDistributedGains(targetStageGains,
+        static_cast<size_t>(requestedStages.load()));
 
     // No compensation — gain redistribution handles consistency
     targetQualityCompensation  = 1.0f;
 }
 
+void DeverbDiffusionChain::BeginParameterBatch()
+{
+    layoutJob.Hold();
+}
+
+void DeverbDiffusionChain::EndParameterBatch()
+{
+    layoutJob.Release();
+}
+
+void DeverbDiffusionChain::ProcessBlock()
+{
+    applyStageLayout();
+
+    for (size_t stageIndex = 0; stageIndex < MaxStages; ++stageIndex)
+        stageGainSmoothers[stageIndex].SetTarget(distributedGainMultipliers[stageIndex]);
+}
+
 float DeverbDiffusionChain::ProcessSample(float inputSample)
 {
     float sample = inputSample;
@@ -104,10 +142,7 @@ float DeverbDiffusionChain::ProcessSample(float inputSample)
 
     for (size_t stageIndex = 0; stageIndex < activeStages; ++stageIndex)
     {
-        currentStageGains[stageIndex] += gainSlewCoefficient *
-            (distributedGainMultipliers[stageIndex] - currentStageGains[stageIndex]);
-
-        allpasses[stageIndex].SetGain(currentStageGains[stageIndex]);
+        allpasses[stageIndex].SetGain(stageGainSmoothers[stageIndex].GetNextValue());
 
         lfoPhases[stageIndex] += lfoRates[stageIndex];
 
@@ -138,28 +173,75 @@ float DeverbDiffusionChain::GetTotalTuningMs() const
     return totalTuningMs;
 }
 
+// Background worker (and Prepare).
 void DeverbDiffusionChain::rebuildStageDelays()
 {
-    const float sizeScale = 0.25f + (0.75f * size01);
+    auto& layout = layoutMailbox.GetWriteSlot();
+
+    layout.ActiveStages = static_cast<size_t>(requestedStages.load());
+    layout.Size01 = requestedSize01;
+    layout.DistributedTuningsMs = buildDistributedTunings(layout.ActiveStages);
+
+    const float sizeScale = 0.25f + (0.75f * layout.Size01);
 
     float distributedTotal = 0.0f;
 
-    for (size_t i = 0; i < activeStages; ++i)
-        distributedTotal += distributedTuningsMs[i];
+    for (size_t i = 0; i < layout.ActiveStages; ++i)
+        distributedTotal += layout.DistributedTuningsMs[i];
 
     const float preserveScale = (distributedTotal > 0.0f) ? (totalTuningMs / distributedTotal) : 1.0f;
 
-    totalChainDelayMs = 0.0f;
+    layout.TotalChainDelayMs = 0.0f;
 
-    for (size_t stageIndex = 0; stageIndex < activeStages; ++stageIndex)
+    for (size_t stageIndex = 0; stageIndex < MaxStages; ++stageIndex)
     {
-        const float delayMs = distributedTuningsMs[stageIndex] * preserveScale * sizeScale;
+        // Frees the buffer the audio thread sent back in this slot, if any.
+        std::vector<float>().swap(layout.GrownBuffers[stageIndex]);
+
+        if (stageIndex >= layout.ActiveStages)
+            continue;
+
+        const float delayMs = layout.DistributedTuningsMs[stageIndex] * preserveScale * sizeScale;
 
-        allpasses[stageIndex].SetDelayMilliseconds(delayMs);
-        allpasses[stageIndex].SetTargetDelayMilliseconds(delayMs);
+        layout.StageDelaysMs[stageIndex] = delayMs;
+        layout.TotalChainDelayMs += delayMs;
 
-        totalChainDelayMs += delayMs;
+        const int requiredBufferSize = allpasses[stageIndex].GetRequiredBufferSize(delayMs);
+
+        if (requiredBufferSize > stageBufferSizes[stageIndex].load(std::memory_order_acquire))
+            layout.GrownBuffers[stageIndex].assign(static_cast<size_t>(requiredBufferSize), 0.0f);
+    }
+
+    layoutMailbox.Publish();
+}
+
+void DeverbDiffusionChain::applyStageLayout()
+{
+    if (!layoutMailbox.Pull())
+        return;
+
+    auto& layout = layoutMailbox.GetReadSlot();
+
+    for (size_t stageIndex = 0; stageIndex < layout.ActiveStages; ++stageIndex)
+    {
+        auto& allpass = allpasses[stageIndex];
+        auto& grownBuffer = layout.GrownBuffers[stageIndex];
+
+        if (!grownBuffer.empty())
+        {
+            allpass.AdoptBuffer(grownBuffer);
+            stageBufferSizes[stageIndex].store(allpass.GetBufferSize(), std::memory_order_release);
+        }
+
+        // Fits the buffer now, so this never allocates.
+        allpass.SetDelayMilliseconds(layout.StageDelaysMs[stageIndex]);
+        allpass.SetTargetDelayMilliseconds(layout.StageDelaysMs[stageIndex]);
     }
+
+    activeStages = layout.ActiveStages;
+    size01 = layout.Size01;
+    totalChainDelayMs = layout.TotalChainDelayMs;
+    distributedTuningsMs = layout.DistributedTuningsMs;
 }
 
 std::array<float, DeverbDiffusionChain::MaxStages>
@@ -2,9 +2,14 @@
 
 #include <array>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <vector>
 
 #include "DeverbDiffusionAllpass.h"
+#include "SmoothingBank.h"
+#include "Stages/Utils/LatestValueMailbox.h"
+#include "../BackgroundWorker.h"
 
 // A dedicated diffusion chain for the Deverb experiment.
 // This version keeps the experiment intact while ensuring that
@@ -18,23 +23,51 @@ public:
     static constexpr int MaxStages = 8;
 
     void Prepare(double newSampleRate, std::array<float, MaxStages> stageTunings,
-        float jitterRate, float jitterDepth);
+        float jitterRate, float jitterDepth, SmoothingBank& smoothingBank);
 
     void Reset();
 
+    // Not realtime. Applies the requested size and quality right away instead of
+    // waiting for the background worker. The owner calls this after Prepare, once
+    // the size is known; background rebuilds only start from then on.
+    void RebuildLayoutNow();
+
     void SetDiffusionAmount(float newAmount01);
     void SetDiffusionSize(float newSize01);
     void SetDiffusionQuality(int newStageCount);
 
     void SetStageGains(float baseGain, std::array<float, MaxStages> stageGains);
 
+    // Holds background layout rebuilds back until the matching end, see Deverb.
+    void BeginParameterBatch();
+    void EndParameterBatch();
+
+    // Once per block, before the smoothing bank advances: picks up a new stage
+    // layout from the background worker and sets the gain targets.
+    void ProcessBlock();
+
     float ProcessSample(float inputSample);
 
     [[nodiscard]] float GetTotalChainDelayMs() const { return totalChainDelayMs; }
     [[nodiscard]] float GetTotalTuningMs() const;
 
 private:
+    // Stage delays for the requested size and quality, worked out on the background
+    // worker. Stages whose allpass buffer is too small get a larger one allocated there
+    // as well; the buffers they replace come back in the slot and are freed there too.
+    struct StageLayout
+    {
+        size_t ActiveStages = MaxStages;
+        float Size01 = 1.0f;
+        float TotalChainDelayMs = 0.0f;
+
+        std::array<float, MaxStages> DistributedTuningsMs {};
+        std::array<float, MaxStages> StageDelaysMs {};
+        std::array<std::vector<float>, MaxStages> GrownBuffers;
+    };
+
     void rebuildStageDelays();
+    void applyStageLayout();
     [[nodiscard]] std::array<float, MaxStages> buildDistributedTunings(size_t outputStages) const;
 
     static std::array<float, MaxStages> buildDistributedGains(
@@ -53,7 +86,7 @@ private:
     float jitterLfoDepth = 0.0f;
 
     // Gain smoothing
-    std::array<float, MaxStages> currentStageGains {};
+    std::array<SmoothingBank::Smoother, MaxStages> stageGainSmoothers {};
     std::array<float, MaxStages> targetStageGains {};
 
     float currentBaseGain = 0.0f;
@@ -77,4 +110,14 @@ private:
 
     std::array<float, MaxStages> distributedTuningsMs{};
     std::array<float, MaxStages> distributedGainMultipliers {};
+
+    // Requested by the setters, read by the worker
+    std::atomic<float> requestedSize01 { 1.0f };
+    std::atomic<int> requestedStages { MaxStages };
+
+    // Published by the audio thread whenever it adopts a grown buffer
+    std::array<std::atomic<int>, MaxStages> stageBufferSizes {};
+
+    LatestValueMailbox<StageLayout> layoutMailbox;
+    BackgroundJob layoutJob { [this] { rebuildStageDelays(); } };
 };
\ No newline at end of file
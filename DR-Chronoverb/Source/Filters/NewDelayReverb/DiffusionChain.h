@@ -9,6 +9,7 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 
 #include "DiffusionAllpass.h"
+#include "../RandomStream.h"
 
 class DiffusionChain
 {
@@ -21,6 +22,13 @@ public:
         sampleRate = newSampleRate;
     }
 
+    // Seeds the jitter drawn by Configure, so a rebuilt chain repeats exactly. Give each
+    // chain its own (RandomStream::DeriveSeed) to keep left and right decorrelated.
+    void SetRandomSeed(uint64_t newSeed)
+    {
+        randomSeed = newSeed;
+    }
+
     void Configure(int numberOfStages, float size, float jitterPercent,
         float jitterRate, const std::vector<float>& tunings)
     {
@@ -52,9 +60,11 @@ public:
 
         const int effectiveStages = static_cast<int>(perStageDelayMs.size());
 
+        RandomStream random(randomSeed);
+
         jitterLPState.assign(effectiveStages, 0.0f);
         jitterDepthPercent.assign(effectiveStages, jitterPercent);
-        jitterRateHz.assign(effectiveStages, jitterRate * random01());
+        jitterRateHz.assign(effectiveStages, jitterRate * random.NextFloat01());
 
         // Cache jitter alpha
         jitterAlpha.resize(effectiveStages);
@@ -62,8 +72,9 @@ public:
         for (int i = 0; i < effectiveStages; ++i)
             jitterAlpha[i] = computeNoiseAlpha(jitterRateHz[i]);
 
-        tpdfNoiseSeedA.assign(effectiveStages, static_cast<unsigned int>(rand()));
-        tpdfNoiseSeedB.assign(effectiveStages, static_cast<unsigned int>(rand()));
+        // Never 0, the xorshift in uniform01 would stick there.
+        tpdfNoiseSeedA.assign(effectiveStages, random.NextUInt32() | 1u);
+        tpdfNoiseSeedB.assign(effectiveStages, random.NextUInt32() | 1u);
     }
 
     float ProcessSample(float inputSample)
@@ -156,6 +167,8 @@ private:
     std::vector<unsigned int> tpdfNoiseSeedA;
     std::vector<unsigned int> tpdfNoiseSeedB;
 
+    uint64_t randomSeed = RandomStream::DefaultSeed;
+
     int cachedStageCount = 6;
     float cachedSize = 0.0f;
 
@@ -243,9 +256,4 @@ private:
         const float x     = std::exp(-omega / static_cast<float>(sampleRate));
         return juce::jlimit(0.0001f, 0.2f, 1.0f - x);
     }
-
-    float random01() const
-    {
-        return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-    }
 };
\ No newline at end of file
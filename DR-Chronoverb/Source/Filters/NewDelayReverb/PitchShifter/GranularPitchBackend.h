@@ -1,20 +1,48 @@
 #pragma once
 
+#include <array>
+#include <utility>
+
+#include "../../SharedTables.h"
+
 // ============================ Granular pitch backend (echo-quantized) ============================
 // Ratio changes are driven externally by OnEchoBoundary(newRatio).
 // ProcessSample's pitchRatio parameter is ignored — the granular backend uses
 // only the ratio set at the last boundary call.
+//
+// Grain count (2, 4 or 8 overlapping heads) and window shape are runtime settings.
+// Heads are stored as SoA arrays and only the first grainCount entries are processed,
+// so every tier runs through the same code path. Windows are read from precomputed
+// tables shared by all instances (one per shape and grain count) and the source buffer
+// is a power of two, so cubic taps wrap with a mask.
+//
+// Unity fast path: once every head has committed to ratio 1.0 the output is just a
+// delayed copy of the input, so the heads go dormant and a single integer tap at the
+// same lookback is read instead. Leaving unity re-anchors the heads on that tap and
+// crossfades back. Anchors are whole samples, so pure-octave-up ratios read plain taps.
 class GranularPitchBackend : public IPitchShifterBackend
 {
-    struct ReadHead { float readIndex = 0.0f; };
+public:
+    static constexpr int MaxGrains = 8;
+    static constexpr int WindowTableSize = 2048;
+    static constexpr int NumGrainCountTiers = 3; // 2, 4 and 8 grains
 
+    enum class WindowShape
+    {
+        Hann,
+        SqrtHann,
+        Tukey,
+        Blackman
+    };
+
+private:
     struct GrainState
     {
-        ReadHead headA, headB, headC, headD;
-        float phaseA = 0.0f, phaseB = 0.25f, phaseC = 0.5f, phaseD = 0.75f;
+        std::array<float, MaxGrains> readIndices {};
+        std::array<float, MaxGrains> phases {};
 
         // Per-head target ratios — committed on next grain reset for each head
-        float ratioA = 1.0f, ratioB = 1.0f, ratioC = 1.0f, ratioD = 1.0f;
+        std::array<float, MaxGrains> ratios {};
 
         // The pending ratio waiting to be picked up at each head's next reset
         float pendingRatio = 1.0f;
@@ -22,18 +50,26 @@ class GranularPitchBackend : public IPitchShifterBackend
     };
 
 public:
-    GranularPitchBackend() = default;
+    GranularPitchBackend()
+    {
+        acquireWindowTables();
+        selectWindowTable();
+    }
 
     void Prepare(double newSampleRate) override
     {
         sampleRate = newSampleRate;
 
         const int bufferMs = 300;
-        const int bufferSize = std::max(
+        const int bufferSize = juce::nextPowerOfTwo(std::max(
             2048,
-            static_cast<int>(std::ceil((bufferMs * sampleRate) / 1000.0)));
+            static_cast<int>(std::ceil((bufferMs * sampleRate) / 1000.0))));
 
         buffer.assign(static_cast<size_t>(bufferSize), 0.0f);
+        bufferMask = bufferSize - 1;
+
+        const int unityFadeSamples = std::max(1, static_cast<int>(std::round(0.005 * sampleRate)));
+        unityMixStep = 1.0f / static_cast<float>(unityFadeSamples);
 
         SetGrainLengthMilliseconds(50.0f);
         SetJitterPercent(0.12f);
@@ -51,18 +87,13 @@ public:
         writeIndex = 0;
 
         grainState = {};
-        grainState.phaseA = 0.0f;
-        grainState.phaseB = 0.25f;
-        grainState.phaseC = 0.5f;
-        grainState.phaseD = 0.75f;
-        grainState.ratioA = 1.0f;
-        grainState.ratioB = 1.0f;
-        grainState.ratioC = 1.0f;
-        grainState.ratioD = 1.0f;
+        grainState.ratios.fill(1.0f);
         grainState.pendingRatio = 1.0f;
         grainState.hasPending = false;
 
-        anchorStateToWrite(grainState);
+        spreadPhases();
+        anchorStateToWrite();
+        snapUnityState(true);
     }
 
     // ------------------------------------------------------------------
@@ -71,8 +102,31 @@ public:
     // ------------------------------------------------------------------
     void OnEchoBoundary(float newRatio) override
     {
-        if (std::abs(newRatio - grainState.ratioA) < 1.0e-6f)
+        const bool newRatioIsUnity = std::abs(newRatio - 1.0f) < 1.0e-6f;
+
+        if (std::abs(newRatio - grainState.ratios[0]) < 1.0e-6f)
+        {
+            // Already settled at unity — fade the heads out at this boundary.
+            if (newRatioIsUnity && !grainState.hasPending)
+                unityTarget = true;
+
             return;
+        }
+
+        if (!newRatioIsUnity)
+        {
+            unityTarget = false;
+
+            // Dormant heads restart on the unity tap, so granular output picks up
+            // exactly where the single read left off.
+            if (headsDormant)
+            {
+                headsDormant = false;
+                grainState.ratios.fill(1.0f);
+                spreadPhases();
+                anchorStateToWrite();
+            }
+        }
 
         grainState.pendingRatio = newRatio;
         grainState.hasPending = true;
@@ -84,19 +138,13 @@ public:
     // ------------------------------------------------------------------
     void SetInitialRatio(float ratio) override
     {
-        grainState.ratioA = ratio;
-        grainState.ratioB = ratio;
-        grainState.ratioC = ratio;
-        grainState.ratioD = ratio;
+        grainState.ratios.fill(ratio);
         grainState.pendingRatio = ratio;
         grainState.hasPending = false;
 
-        grainState.phaseA = 0.0f;
-        grainState.phaseB = 0.25f;
-        grainState.phaseC = 0.5f;
-        grainState.phaseD = 0.75f;
-
-        anchorStateToWrite(grainState);
+        spreadPhases();
+        anchorStateToWrite();
+        snapUnityState(std::abs(ratio - 1.0f) < 1.0e-6f);
     }
 
     // pitchRatio is intentionally unused — ratio is now managed via OnEchoBoundary.
@@ -105,17 +153,73 @@ public:
         if (buffer.empty())
             return inputSample;
 
-        buffer[static_cast<int>(writeIndex)] = inputSample;
-        writeIndex = (writeIndex + 1) % static_cast<int>(buffer.size());
+        buffer[static_cast<size_t>(writeIndex)] = inputSample;
+        writeIndex = (writeIndex + 1) & bufferMask;
+
+        if (headsDormant)
+            return readUnityTap();
+
+        const float granularSample = processStateOneSample();
 
-        return processStateOneSample(grainState);
+        if (!unityTarget && unityMix <= 0.0f)
+            return granularSample;
+
+        const float unitySample = readUnityTap();
+
+        if (unityTarget)
+            unityMix = std::min(1.0f, unityMix + unityMixStep);
+        else
+            unityMix = std::max(0.0f, unityMix - unityMixStep);
+
+        // Heads only go dormant once the fade has fully handed over to the tap.
+        if (unityTarget && unityMix >= 1.0f)
+            headsDormant = true;
+
+        return granularSample + (unitySample - granularSample) * unityMix;
+    }
+
+    // True while the heads are dormant and only the unity tap is read.
+    bool IsAtUnity() const { return headsDormant; }
+
+    // Number of overlapping grains. Snaps to 2, 4 or 8. Call after Prepare and before
+    // playback: the heads are re-spread and re-anchored. PitchShifter builds a fresh
+    // backend on its background worker for every change.
+    void SetGrainCount(int newGrainCount)
+    {
+        if (newGrainCount <= 2)
+            grainCount = 2;
+        else if (newGrainCount <= 4)
+            grainCount = 4;
+        else
+            grainCount = MaxGrains;
+
+        for (int grainIndex = 1; grainIndex < grainCount; ++grainIndex)
+            grainState.ratios[static_cast<size_t>(grainIndex)] = grainState.ratios[0];
+
+        selectWindowTable();
+        spreadPhases();
+        anchorStateToWrite();
+
+        if (headsDormant)
+            snapUnityState(true);
+    }
+
+    int GetGrainCount() const { return grainCount; }
+
+    void SetWindowShape(WindowShape newWindowShape)
+    {
+        if (newWindowShape == windowShape)
+            return;
+
+        windowShape = newWindowShape;
+        selectWindowTable();
     }
 
     void SetGrainLengthMilliseconds(float ms)
     {
         const float clamped = juce::jlimit(5.0f, 120.0f, ms);
 
-        grainLengthSamples  = std::max(16, static_cast<int>(
+        grainLengthSamples = std::max(16, static_cast<int>(
             std::round((clamped * sampleRate) / 1000.0)));
     }
 
@@ -124,8 +228,12 @@ public:
 
     float GetLatencyMilliseconds() const override
     {
-        const float averageRatio = (grainState.ratioA + grainState.ratioB
-                                  + grainState.ratioC + grainState.ratioD) * 0.25f;
+        float ratioSum = 0.0f;
+
+        for (int grainIndex = 0; grainIndex < grainCount; ++grainIndex)
+            ratioSum += grainState.ratios[static_cast<size_t>(grainIndex)];
+
+        const float averageRatio = ratioSum / static_cast<float>(grainCount);
 
         const float grainMs = static_cast<float>(grainLengthSamples) * 1000.0f
                               / static_cast<float>(sampleRate);
@@ -137,96 +245,97 @@ public:
     }
 
 private:
-    float processStateOneSample(GrainState& newGrainState)
+    float processStateOneSample()
     {
-        const float sampleA = readCubic(newGrainState.headA.readIndex);
-        const float sampleB = readCubic(newGrainState.headB.readIndex);
-        const float sampleC = readCubic(newGrainState.headC.readIndex);
-        const float sampleD = readCubic(newGrainState.headD.readIndex);
+        const float phaseIncrement = 1.0f / static_cast<float>(grainLengthSamples);
 
-        grainState.headA.readIndex = wrapReadIndex(grainState.headA.readIndex + grainState.ratioA);
-        grainState.headB.readIndex = wrapReadIndex(grainState.headB.readIndex + grainState.ratioB);
-        grainState.headC.readIndex = wrapReadIndex(grainState.headC.readIndex + grainState.ratioC);
-        grainState.headD.readIndex = wrapReadIndex(grainState.headD.readIndex + grainState.ratioD);
+        float output = 0.0f;
+        bool allHeadsCommitted = grainState.hasPending;
 
-        const float phaseInc = 1.0f / static_cast<float>(grainLengthSamples);
-
-        newGrainState.phaseA += phaseInc;
-        if (newGrainState.phaseA >= 1.0f)
+        for (int grainIndex = 0; grainIndex < grainCount; ++grainIndex)
         {
-            grainState.phaseA -= 1.0f;
+            const auto index = static_cast<size_t>(grainIndex);
 
-            if (grainState.hasPending)
-                grainState.ratioA = grainState.pendingRatio;
+            // Whole-sample anchors + integer ratio keep the read index integral.
+            const float ratio = grainState.ratios[index];
+            const float sample = (ratio == std::floor(ratio))
+                ? readTap(grainState.readIndices[index])
+                : readCubic(grainState.readIndices[index]);
 
-            anchorHeadToWrite(grainState.headA, generateJitterSamples());
-        }
+            grainState.readIndices[index] =
+                wrapReadIndex(grainState.readIndices[index] + grainState.ratios[index]);
 
-        newGrainState.phaseB += phaseInc;
-        if (newGrainState.phaseB >= 1.0f)
-        {
-            grainState.phaseB -= 1.0f;
+            grainState.phases[index] += phaseIncrement;
 
-            if (grainState.hasPending)
-                grainState.ratioB = grainState.pendingRatio;
+            if (grainState.phases[index] >= 1.0f)
+            {
+                grainState.phases[index] -= 1.0f;
 
-            anchorHeadToWrite(grainState.headB, generateJitterSamples());
-        }
+                if (grainState.hasPending)
+                    grainState.ratios[index] = grainState.pendingRatio;
 
-        newGrainState.phaseC += phaseInc;
-        if (newGrainState.phaseC >= 1.0f)
-        {
-            grainState.phaseC -= 1.0f;
+                grainState.readIndices[index] = anchoredReadIndex(generateJitterSamples());
+            }
 
-            if (grainState.hasPending)
-                grainState.ratioC = grainState.pendingRatio;
+            if (grainState.ratios[index] != grainState.pendingRatio)
+                allHeadsCommitted = false;
 
-            anchorHeadToWrite(grainState.headC, generateJitterSamples());
+            output += sample * lookupWindow(grainState.phases[index]);
         }
 
-        newGrainState.phaseD += phaseInc;
-        if (newGrainState.phaseD >= 1.0f)
+        // Clear hasPending once every active head has committed.
+        if (allHeadsCommitted)
         {
-            grainState.phaseD -= 1.0f;
-
-            if (grainState.hasPending)
-                grainState.ratioD = grainState.pendingRatio;
+            grainState.hasPending = false;
 
-            anchorHeadToWrite(grainState.headD, generateJitterSamples());
+            if (std::abs(grainState.pendingRatio - 1.0f) < 1.0e-6f)
+                unityTarget = true;
         }
 
-        // Clear hasPending once all four heads have committed:
-        if (grainState.hasPending
-            && grainState.ratioA == grainState.pendingRatio
-            && grainState.ratioB == grainState.pendingRatio
-            && grainState.ratioC == grainState.pendingRatio
-            && grainState.ratioD == grainState.pendingRatio)
+        // The tables are normalised so the overlapping windows sum to 1.0 at any point.
+        return output;
+    }
+
+    void spreadPhases()
+    {
+        const float phaseSpacing = 1.0f / static_cast<float>(grainCount);
+
+        for (int grainIndex = 0; grainIndex < MaxGrains; ++grainIndex)
         {
-            grainState.hasPending = false;
+            grainState.phases[static_cast<size_t>(grainIndex)] =
+                static_cast<float>(grainIndex % grainCount) * phaseSpacing;
         }
+    }
+
+    void anchorStateToWrite()
+    {
+        const float anchor = anchoredReadIndex(0.0f);
+        grainState.readIndices.fill(anchor);
+    }
 
-        const float wA = hannWindow(newGrainState.phaseA);
-        const float wB = hannWindow(newGrainState.phaseB);
-        const float wC = hannWindow(newGrainState.phaseC);
-        const float wD = hannWindow(newGrainState.phaseD);
+    // Anchors are whole samples so integer ratios never need interpolation.
+    float anchoredReadIndex(float jitterOffsetSamples) const
+    {
+        const float index = static_cast<float>(writeIndex - getLookbackSamples());
+        return wrapReadIndex(index + std::round(jitterOffsetSamples));
+    }
 
-        // Divide by 2 to compensate: 4 sqrt-Hann heads summing to ~2.0 at any point.
-        return (sampleA * wA + sampleB * wB + sampleC * wC + sampleD * wD) * 0.5f;
+    int getLookbackSamples() const
+    {
+        return static_cast<int>(std::round(static_cast<float>(grainLengthSamples) * lookbackMultiplier));
     }
 
-    void anchorStateToWrite(GrainState& s)
+    // Same position a freshly anchored, un-jittered head reads at ratio 1.0.
+    float readUnityTap() const
     {
-        anchorHeadToWrite(s.headA, 0.0f);
-        anchorHeadToWrite(s.headB, 0.0f);
-        anchorHeadToWrite(s.headC, 0.0f);
-        anchorHeadToWrite(s.headD, 0.0f);
+        return buffer[static_cast<size_t>((writeIndex - 1 - getLookbackSamples()) & bufferMask)];
     }
 
-    void anchorHeadToWrite(ReadHead& readHead, float jitterOffsetSamples)
+    void snapUnityState(bool atUnity)
     {
-        const float lookback = static_cast<float>(grainLengthSamples) * lookbackMultiplier;
-        const float index = static_cast<float>(writeIndex);
-        readHead.readIndex = wrapReadIndex(index - lookback + jitterOffsetSamples);
+        unityTarget = atUnity;
+        headsDormant = atUnity;
+        unityMix = atUnity ? 1.0f : 0.0f;
     }
 
     float generateJitterSamples() const
@@ -236,9 +345,121 @@ private:
         return u * jitterPercent * static_cast<float>(grainLengthSamples);
     }
 
-    static float hannWindow(float phase01)
+    // Table holds WindowTableSize + 1 points so the guard point removes the
+    // wrap check from the linear interpolation.
+    float lookupWindow(float phase01) const
+    {
+        const float position = phase01 * static_cast<float>(WindowTableSize);
+        const int index = std::clamp(static_cast<int>(position), 0, WindowTableSize - 1);
+        const float frac = position - static_cast<float>(index);
+
+        const float a = windowTable[static_cast<size_t>(index)];
+        const float b = windowTable[static_cast<size_t>(index + 1)];
+
+        return a + (b - a) * frac;
+    }
+
+    static float evaluateWindow(WindowShape shape, float phase01)
+    {
+        constexpr float twoPi = juce::MathConstants<float>::twoPi;
+
+        const float hann = 0.5f - 0.5f * std::cos(twoPi * phase01);
+
+        switch (shape)
+        {
+            case WindowShape::SqrtHann:
+                return std::sqrt(std::max(0.0f, hann));
+
+            case WindowShape::Tukey:
+            {
+                // Half the grain flat at unity, quarter-cosine tapers on either side.
+                constexpr float taper = 0.5f;
+                constexpr float halfTaper = taper * 0.5f;
+
+                if (phase01 < halfTaper)
+                    return 0.5f - 0.5f * std::cos(juce::MathConstants<float>::pi * phase01 / halfTaper);
+
+                if (phase01 > 1.0f - halfTaper)
+                    return 0.5f - 0.5f * std::cos(juce::MathConstants<float>::pi * (1.0f - phase01) / halfTaper);
+
+                return 1.0f;
+            }
+
+            case WindowShape::Blackman:
+                return std::max(0.0f, 0.42f - 0.5f * std::cos(twoPi * phase01)
+                                       + 0.08f * std::cos(2.0f * twoPi * phase01));
+
+            case WindowShape::Hann:
+            default:
+                return hann;
+        }
+    }
+
+    // Every shape is fetched up front, so switching shape later is just a pointer swap.
+    // Each shape's table holds one window per grain count tier, each divided by the
+    // overlap-add sum of grainCount evenly spaced copies of itself. The heads then always
+    // sum to exactly 1.0, whatever the shape (only Hann overlaps to a constant on its own).
+    void acquireWindowTables()
     {
-        return 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi * phase01);
+        constexpr std::array<std::pair<WindowShape, SharedTables::TableType>, NumWindowShapes> shapeTables =
+        {{
+            { WindowShape::Hann,     SharedTables::TableType::GrainWindowHann },
+            { WindowShape::SqrtHann, SharedTables::TableType::GrainWindowSqrtHann },
+            { WindowShape::Tukey,    SharedTables::TableType::GrainWindowTukey },
+            { WindowShape::Blackman, SharedTables::TableType::GrainWindowBlackman }
+        }};
+
+        for (const auto& [shape, tableType] : shapeTables)
+        {
+            windowTables[static_cast<size_t>(shape)] = SharedTables::Get(tableType, 0.0,
+                NumGrainCountTiers * WindowTablePoints,
+                [shape](SharedTables::Table& table)
+                {
+                    for (int tier = 0; tier < NumGrainCountTiers; ++tier)
+                        fillNormalisedWindow(shape, getGrainCountForTier(tier),
+                            table.data() + tier * WindowTablePoints);
+                });
+        }
+    }
+
+    static void fillNormalisedWindow(WindowShape shape, int numGrains, float* destination)
+    {
+        const int grainSpacing = WindowTableSize / numGrains;
+
+        auto window = [shape](int index)
+        {
+            return evaluateWindow(shape, static_cast<float>(index % WindowTableSize)
+                                         / static_cast<float>(WindowTableSize));
+        };
+
+        for (int i = 0; i < WindowTableSize; ++i)
+        {
+            float overlapSum = 0.0f;
+
+            for (int grainIndex = 0; grainIndex < numGrains; ++grainIndex)
+                overlapSum += window(i + grainIndex * grainSpacing);
+
+            destination[i] = (overlapSum > 1.0e-6f) ? (window(i) / overlapSum) : 0.0f;
+        }
+
+        // Guard point: the window is periodic, so phase 1.0 reads phase 0.0.
+        destination[WindowTableSize] = destination[0];
+    }
+
+    static int getGrainCountForTier(int tier)
+    {
+        return 2 << tier;
+    }
+
+    static int getTierForGrainCount(int numGrains)
+    {
+        return (numGrains <= 2) ? 0 : (numGrains <= 4) ? 1 : 2;
+    }
+
+    void selectWindowTable()
+    {
+        windowTable = windowTables[static_cast<size_t>(windowShape)]->data()
+                      + getTierForGrainCount(grainCount) * WindowTablePoints;
     }
 
     float wrapReadIndex(float idx) const
@@ -250,19 +471,23 @@ private:
         return out;
     }
 
+    float readTap(float readIndexFloat) const
+    {
+        return buffer[static_cast<size_t>(static_cast<int>(readIndexFloat) & bufferMask)];
+    }
+
+    // readIndexFloat is always kept in [0, buffer.size()) by wrapReadIndex.
     float readCubic(float readIndexFloat) const
     {
-        const int size = static_cast<int>(buffer.size());
-        const float wrapped = wrapReadIndex(readIndexFloat);
-        const int i1 = static_cast<int>(std::floor(wrapped));
-        const float frac = wrapped - static_cast<float>(i1);
+        const int i1 = static_cast<int>(readIndexFloat);
+        const float frac = readIndexFloat - static_cast<float>(i1);
 
-        const int i0 = (i1 - 1 + size) % size;
-        const int i2 = (i1 + 1) % size;
-        const int i3 = (i1 + 2) % size;
+        const int i0 = (i1 - 1) & bufferMask;
+        const int i2 = (i1 + 1) & bufferMask;
+        const int i3 = (i1 + 2) & bufferMask;
 
         const float y0 = buffer[static_cast<size_t>(i0)];
-        const float y1 = buffer[static_cast<size_t>(i1)];
+        const float y1 = buffer[static_cast<size_t>(i1 & bufferMask)];
         const float y2 = buffer[static_cast<size_t>(i2)];
         const float y3 = buffer[static_cast<size_t>(i3)];
 
@@ -300,20 +525,27 @@ private:
 
     double sampleRate = 48000.0;
     std::vector<float> buffer;
+    int bufferMask = 0;
     int writeIndex = 0;
 
     int grainLengthSamples = 1680;
     float jitterPercent = 0.12f;
     float lookbackMultiplier = 3.0f;
 
-    //GrainState stateA;
-    //GrainState stateB;
-    //bool activeIsA = true;
+    int grainCount = 4;
+    WindowShape windowShape = WindowShape::Hann;
 
-    GrainState grainState;
+    static constexpr int NumWindowShapes = 4;
+    static constexpr int WindowTablePoints = WindowTableSize + 1;
 
-    //int boundaryCrossfadeSamples = 0;
-    //int crossfadeTotalSamples = 0;
-    //int crossfadeRemainingSamples = 0;
-    //bool pendingFlipAfterFade = false;
-};
\ No newline at end of file
+    std::array<SharedTables::TablePtr, NumWindowShapes> windowTables {};
+    const float* windowTable = nullptr; // WindowTablePoints points, for the current grain count
+
+    // Unity fast path
+    bool unityTarget = true;
+    bool headsDormant = true;
+    float unityMix = 1.0f;
+    float unityMixStep = 1.0f / 240.0f;
+
+    GrainState grainState;
+};
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+#include <juce_dsp/juce_dsp.h>
+
+#include "PitchShiftingUtils.h"
+#include "../../SharedTables.h"
+
+// ============================ Phase vocoder pitch backend (echo-quantized) ============================
+// Block-based alternative to GranularPitchBackend for large shifts (±3–4 octaves).
+//
+// Input is collected per sample into a frame-sized ring; every hop (frameSize / 4) one
+// frame is analysed with a real FFT and resynthesised by overlap-add. Pitch shifting
+// uses rigid peak-region shifting with identity phase locking (Laroche & Dolson):
+// each spectral peak and its region of influence is moved to peakBin * ratio and
+// rotated by one phase accumulator, so only peaks pay for atan2 / sincos. A peak's
+// accumulator follows it from frame to frame (nearest previous peak within
+// PeakMatchBins), so vibrato and glides that move a peak across bins stay coherent.
+//
+// Every buffer is allocated in Prepare — ProcessSample and the per-hop frame are
+// allocation free. Cost is one forward + one inverse FFT per hop, amortized.
+// Latency is exactly one frame.
+class PhaseVocoderPitchBackend : public IPitchShifterBackend
+{
+public:
+    static constexpr int DefaultFftOrder = 11; // 2048 samples
+    static constexpr int OverlapFactor = 4;
+
+    // How far (analysis bins) a peak may move between frames and keep its phase accumulator.
+    static constexpr int PeakMatchBins = 2;
+
+    PhaseVocoderPitchBackend() = default;
+
+    void Prepare(double newSampleRate) override
+    {
+        sampleRate = newSampleRate;
+
+        frameSize = 1 << fftOrder;
+
+        if (fft == nullptr || fft->getSize() != frameSize)
+            fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+
+        frameMask = frameSize - 1;
+        hopSize = frameSize / OverlapFactor;
+        numBins = (frameSize / 2) + 1;
+
+        const auto frame = static_cast<size_t>(frameSize);
+        const auto bins = static_cast<size_t>(numBins);
+
+        inputRing.assign(frame, 0.0f);
+        outputRing.assign(frame, 0.0f);
+        fftData.assign(frame * 2, 0.0f);
+
+        previousReal.assign(bins, 0.0f);
+        previousImag.assign(bins, 0.0f);
+        magnitudeSquared.assign(bins, 0.0f);
+        synthesisReal.assign(bins, 0.0f);
+        synthesisImag.assign(bins, 0.0f);
+        peakBins.assign(bins, 0);
+        peakPhases.assign(bins, 0.0f);
+        previousPeakBins.assign(bins, 0);
+        previousPeakPhases.assign(bins, 0.0f);
+
+        // Periodic Hann for both analysis and synthesis. Hann² at 4x overlap sums to 1.5.
+        windowTable = SharedTables::Get(SharedTables::TableType::PhaseVocoderWindow, 0.0, frameSize,
+            [](SharedTables::Table& table)
+            {
+                const auto size = static_cast<float>(table.size());
+
+                for (size_t i = 0; i < table.size(); ++i)
+                {
+                    const float phase01 = static_cast<float>(i) / size;
+                    table[i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * phase01);
+                }
+            });
+
+        window = windowTable->data();
+
+        overlapAddGain = 1.0f / 1.5f;
+        expectedPhaseAdvance = juce::MathConstants<float>::twoPi
+                               * static_cast<float>(hopSize) / static_cast<float>(frameSize);
+
+        Reset();
+    }
+
+    void Reset() override
+    {
+        std::fill(inputRing.begin(), inputRing.end(), 0.0f);
+        std::fill(outputRing.begin(), outputRing.end(), 0.0f);
+        std::fill(previousReal.begin(), previousReal.end(), 0.0f);
+        std::fill(previousImag.begin(), previousImag.end(), 0.0f);
+
+        numPreviousPeaks = 0;
+
+        ringIndex = 0;
+        hopCounter = 0;
+    }
+
+    // The ratio is read at the start of each frame, so a boundary change is
+    // crossfaded by the overlap-add over the next OverlapFactor hops.
+    void OnEchoBoundary(float newRatio) override
+    {
+        currentRatio = newRatio;
+    }
+
+    void SetInitialRatio(float ratio) override
+    {
+        currentRatio = ratio;
+    }
+
+    // pitchRatio is intentionally unused — ratio is managed via OnEchoBoundary.
+    float ProcessSample(float inputSample, float /*pitchRatio*/) override
+    {
+        if (fft == nullptr)
+            return inputSample;
+
+        const auto index = static_cast<size_t>(ringIndex);
+
+        inputRing[index] = inputSample;
+
+        const float outputSample = outputRing[index];
+        outputRing[index] = 0.0f;
+
+        ringIndex = (ringIndex + 1) & frameMask;
+
+        if (++hopCounter >= hopSize)
+        {
+            hopCounter = 0;
+            processFrame();
+        }
+
+        return outputSample;
+    }
+
+    // Not realtime safe — reallocates every frame buffer.
+    void SetFftOrder(int newFftOrder)
+    {
+        fftOrder = juce::jlimit(9, 13, newFftOrder);
+        Prepare(sampleRate);
+    }
+
+    float GetLatencyMilliseconds() const override
+    {
+        return static_cast<float>(frameSize) * 1000.0f / static_cast<float>(sampleRate);
+    }
+
+private:
+    void processFrame()
+    {
+        // 1) Window the last frameSize input samples (ringIndex now points at the oldest).
+        for (int i = 0; i < frameSize; ++i)
+        {
+            const auto ringPosition = static_cast<size_t>((ringIndex + i) & frameMask);
+            fftData[static_cast<size_t>(i)] = inputRing[ringPosition] * window[static_cast<size_t>(i)];
+        }
+
+        std::fill(fftData.begin() + frameSize, fftData.end(), 0.0f);
+
+        fft->performRealOnlyForwardTransform(fftData.data(), true);
+
+        // 2) Peak picking on squared magnitude (local maximum over ±2 bins).
+        float maxMagnitudeSquared = 0.0f;
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const float real = fftData[static_cast<size_t>(bin * 2)];
+            const float imag = fftData[static_cast<size_t>(bin * 2 + 1)];
+            const float magnitude = real * real + imag * imag;
+
+            magnitudeSquared[static_cast<size_t>(bin)] = magnitude;
+            maxMagnitudeSquared = std::max(maxMagnitudeSquared, magnitude);
+        }
+
+        const float peakThreshold = maxMagnitudeSquared * 1.0e-10f;
+        int numPeaks = 0;
+
+        for (int bin = 2; bin < numBins - 2; ++bin)
+        {
+            const float magnitude = magnitudeSquared[static_cast<size_t>(bin)];
+
+            if (magnitude > peakThreshold
+                && magnitude > magnitudeSquared[static_cast<size_t>(bin - 1)]
+                && magnitude >= magnitudeSquared[static_cast<size_t>(bin + 1)]
+                && magnitude > magnitudeSquared[static_cast<size_t>(bin - 2)]
+                && magnitude >= magnitudeSquared[static_cast<size_t>(bin + 2)])
+            {
+                peakBins[static_cast<size_t>(numPeaks++)] = bin;
+            }
+        }
+
+        // 3) Shift each peak region rigidly and phase-lock it to its peak.
+        std::fill(synthesisReal.begin(), synthesisReal.end(), 0.0f);
+        std::fill(synthesisImag.begin(), synthesisImag.end(), 0.0f);
+
+        const float ratio = currentRatio;
+
+        // Both peak lists are ascending, so the nearest previous peak only ever moves forward.
+        int previousPeakIndex = 0;
+        int numShiftedPeaks = 0;
+
+        for (int peakIndex = 0; peakIndex < numPeaks; ++peakIndex)
+        {
+            const int peakBin = peakBins[static_cast<size_t>(peakIndex)];
+            const int targetPeakBin = static_cast<int>(std::round(static_cast<float>(peakBin) * ratio));
+
+            // Peaks are ascending, so everything after this lands above Nyquist.
+            if (targetPeakBin >= numBins)
+                break;
+
+            numShiftedPeaks = peakIndex + 1;
+
+            // Region of influence: halfway to each neighbouring peak.
+            const int regionStart = (peakIndex == 0)
+                ? 0
+                : (peakBins[static_cast<size_t>(peakIndex - 1)] + peakBin + 1) / 2;
+
+            const int regionEnd = (peakIndex == numPeaks - 1)
+                ? numBins - 1
+                : (peakBin + peakBins[static_cast<size_t>(peakIndex + 1)]) / 2;
+
+            const float peakReal = fftData[static_cast<size_t>(peakBin * 2)];
+            const float peakImag = fftData[static_cast<size_t>(peakBin * 2 + 1)];
+
+            // True frequency of the peak (radians per hop) from the phase advance since the last frame.
+            const float previousPeakReal = previousReal[static_cast<size_t>(peakBin)];
+            const float previousPeakImag = previousImag[static_cast<size_t>(peakBin)];
+
+            const float phaseAdvance = std::atan2(
+                peakImag * previousPeakReal - peakReal * previousPeakImag,
+                peakReal * previousPeakReal + peakImag * previousPeakImag);
+
+            const float binCenterAdvance = static_cast<float>(peakBin) * expectedPhaseAdvance;
+            const float trueAdvance = binCenterAdvance + wrapPhase(phaseAdvance - binCenterAdvance);
+
+            const float analysisPeakPhase = std::atan2(peakImag, peakReal);
+
+            while (previousPeakIndex + 1 < numPreviousPeaks
+                   && std::abs(previousPeakBins[static_cast<size_t>(previousPeakIndex + 1)] - peakBin)
+                      <= std::abs(previousPeakBins[static_cast<size_t>(previousPeakIndex)] - peakBin))
+            {
+                ++previousPeakIndex;
+            }
+
+            const bool continuesPreviousPeak = previousPeakIndex < numPreviousPeaks
+                && std::abs(previousPeakBins[static_cast<size_t>(previousPeakIndex)] - peakBin) <= PeakMatchBins;
+
+            // Accumulators are kept relative to the frame centre. The window isn't centred,
+            // so a sinusoid's phase flips by pi from one bin to the next; without this a
+            // peak that moves one bin would continue half a cycle off.
+            // A peak with no match last frame starts from its analysis phase rather than
+            // a stale accumulator, so unity ratio reconstructs the input waveform.
+            const float accumulatedPhase = continuesPreviousPeak
+                ? wrapPhase(previousPeakPhases[static_cast<size_t>(previousPeakIndex)] + trueAdvance * ratio)
+                : wrapPhase(analysisPeakPhase + getCentreOffset(peakBin));
+
+            peakPhases[static_cast<size_t>(peakIndex)] = accumulatedPhase;
+
+            // Identity phase locking: rotate the whole region by (synthesis - analysis) peak phase.
+            const float rotation = accumulatedPhase - getCentreOffset(targetPeakBin) - analysisPeakPhase;
+            const float rotationCos = std::cos(rotation);
+            const float rotationSin = std::sin(rotation);
+
+            const int binOffset = targetPeakBin - peakBin;
+
+            for (int bin = regionStart; bin <= regionEnd; ++bin)
+            {
+                const int targetBin = bin + binOffset;
+
+                if (targetBin < 0 || targetBin >= numBins)
+                    continue;
+
+                const float real = fftData[static_cast<size_t>(bin * 2)];
+                const float imag = fftData[static_cast<size_t>(bin * 2 + 1)];
+
+                synthesisReal[static_cast<size_t>(targetBin)] += real * rotationCos - imag * rotationSin;
+                synthesisImag[static_cast<size_t>(targetBin)] += real * rotationSin + imag * rotationCos;
+            }
+        }
+
+        // Keep this frame's analysis spectrum for the next phase-advance estimate, and its
+        // peaks for the next frame's matching.
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            previousReal[static_cast<size_t>(bin)] = fftData[static_cast<size_t>(bin * 2)];
+            previousImag[static_cast<size_t>(bin)] = fftData[static_cast<size_t>(bin * 2 + 1)];
+        }
+
+        std::swap(peakBins, previousPeakBins);
+        std::swap(peakPhases, previousPeakPhases);
+        numPreviousPeaks = numShiftedPeaks;
+
+        // 4) Resynthesise and overlap-add one frame into the output ring.
+        std::fill(fftData.begin(), fftData.end(), 0.0f);
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            fftData[static_cast<size_t>(bin * 2)] = synthesisReal[static_cast<size_t>(bin)];
+            fftData[static_cast<size_t>(bin * 2 + 1)] = synthesisImag[static_cast<size_t>(bin)];
+        }
+
+        // DC and Nyquist are real-only.
+        fftData[1] = 0.0f;
+        fftData[static_cast<size_t>((numBins - 1) * 2 + 1)] = 0.0f;
+
+        fft->performRealOnlyInverseTransform(fftData.data());
+
+        for (int i = 0; i < frameSize; ++i)
+        {
+            const auto ringPosition = static_cast<size_t>((ringIndex + i) & frameMask);
+            outputRing[ringPosition] += fftData[static_cast<size_t>(i)]
+                                        * window[static_cast<size_t>(i)] * overlapAddGain;
+        }
+    }
+
+    // Phase of frame-centre time minus phase of frame-start time at a bin: pi on odd bins.
+    static float getCentreOffset(int bin)
+    {
+        return (bin & 1) != 0 ? juce::MathConstants<float>::pi : 0.0f;
+    }
+
+    static float wrapPhase(float phase)
+    {
+        constexpr float pi = juce::MathConstants<float>::pi;
+        constexpr float twoPi = juce::MathConstants<float>::twoPi;
+
+        return phase - twoPi * std::floor((phase + pi) / twoPi);
+    }
+
+    double sampleRate = 48000.0;
+
+    int fftOrder = DefaultFftOrder;
+    int frameSize = 1 << DefaultFftOrder;
+    int frameMask = (1 << DefaultFftOrder) - 1;
+    int hopSize = (1 << DefaultFftOrder) / OverlapFactor;
+    int numBins = (1 << DefaultFftOrder) / 2 + 1;
+
+    float overlapAddGain = 1.0f / 1.5f;
+    float expectedPhaseAdvance = 0.0f;
+    float currentRatio = 1.0f;
+
+    int ringIndex = 0;
+    int hopCounter = 0;
+    int numPreviousPeaks = 0;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+
+    std::vector<float> inputRing;
+    std::vector<float> outputRing;
+    std::vector<float> fftData;
+    SharedTables::TablePtr windowTable;
+    const float* window = nullptr;
+
+    std::vector<float> previousReal;
+    std::vector<float> previousImag;
+    std::vector<float> magnitudeSquared;
+    std::vector<float> synthesisReal;
+    std::vector<float> synthesisImag;
+    std::vector<int> peakBins;
+    std::vector<float> peakPhases;
+    std::vector<int> previousPeakBins;
+    std::vector<float> previousPeakPhases;
+};
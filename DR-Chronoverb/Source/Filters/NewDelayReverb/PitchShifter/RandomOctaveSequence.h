@@ -3,13 +3,19 @@
 #include <cmath>
 
 #include "PitchShiftingUtils.h"
+#include "../../RandomStream.h"
 
 // Random octave sequence: picks a random octave within [lowerBound, upperBound]
 // each echo, avoiding an immediate back-to-back repeat when more than one choice exists.
+// Reset() restarts the seeded stream, so every run from a reset picks the same octaves.
 class RandomOctaveSequence : public IPitchSequence
 {
 public:
-    RandomOctaveSequence() { BuildOctaveList(); }
+    explicit RandomOctaveSequence(uint64_t newSeed = RandomStream::DefaultSeed)
+        : seed(newSeed)
+    {
+        BuildOctaveList();
+    }
 
     void SetRange(int newLowerBound, int newUpperBound)
     {
@@ -20,6 +26,8 @@ public:
 
     void Reset() override
     {
+        random.SetSeed(seed);
+
         lastOctave = INT_MIN;
         currentOctave = PickRandom(lastOctave);
     }
@@ -46,7 +54,7 @@ private:
             octaves.push_back(o);
     }
 
-    int PickRandom(int excludeOctave) const
+    int PickRandom(int excludeOctave)
     {
         if (octaves.empty())
             return 0;
@@ -66,7 +74,7 @@ private:
         if (candidates.empty())
             return octaves[0];
 
-        return candidates[static_cast<size_t>(rand()) % candidates.size()];
+        return candidates[static_cast<size_t>(random.NextInt(static_cast<int>(candidates.size())))];
     }
 
     int lowerBound = -2;
@@ -74,4 +82,7 @@ private:
     int currentOctave =  0;
     int lastOctave = INT_MIN;
     std::vector<int> octaves;
+
+    uint64_t seed = RandomStream::DefaultSeed;
+    RandomStream random { seed };
 };
\ No newline at end of file
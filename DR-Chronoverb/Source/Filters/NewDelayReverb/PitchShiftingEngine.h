@@ -2,6 +2,8 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <memory>
 #include <functional>
@@ -13,13 +15,24 @@
 #include "PitchShifter/PingPongOctaveSequence.h"
 #include "PitchShifter/RandomOctaveSequence.h"
 #include "PitchShifter/GranularPitchBackend.h"
+#include "PitchShifter/PhaseVocoderPitchBackend.h"
 
 class OctaveEchoPitchShifter
 {
 public:
     enum class BackendType
     {
-        Granular
+        Granular,
+        PhaseVocoder
+    };
+
+    struct BackendSettings
+    {
+        BackendType Type = BackendType::Granular;
+
+        // Granular only
+        int GrainCount = 4;
+        GranularPitchBackend::WindowShape WindowShape = GranularPitchBackend::WindowShape::Hann;
     };
 
     OctaveEchoPitchShifter()
@@ -31,13 +44,13 @@ public:
 
         SetSequence(std::move(seq));
 
-        auto granular = std::make_unique<GranularPitchBackend>();
-        granular->SetGrainLengthMilliseconds(35.0f);
-        granular->SetJitterPercent(0.15f);
-        granular->SetLookbackMultiplier(3.0f);
-        SetBackend(std::move(granular));
+        SetBackend(createGranularBackend());
     }
 
+    // How long a backend exchanged mid-stream takes to replace the old one, once it has
+    // filled up (see ExchangeBackend).
+    static constexpr float BackendCrossfadeMilliseconds = 10.0f;
+
     void Prepare(double newSampleRate)
     {
         sampleRate = newSampleRate;
@@ -58,6 +71,8 @@ public:
 
         if (backend != nullptr)
             backend->Reset();
+
+        cancelBackendFade();
     }
 
     void SetEnabled(bool shouldBeEnabled)
@@ -79,11 +94,8 @@ public:
         // Commit a staged sequence change cleanly at the echo boundary.
         if (hasPendingSequence && pendingSequence != nullptr)
         {
-            sequence = std::move(pendingSequence);
-            hasPendingSequence = false;
-
-            if (backend != nullptr)
-                backend->OnEchoBoundary(sequence->GetCurrentPitchRatio());
+            commitPendingSequence();
+            sendEchoBoundaryToBackends(sequence->GetCurrentPitchRatio());
 
             return; // Don't advance yet — let the new sequence start from step 0.
         }
@@ -92,51 +104,136 @@ public:
         if (sequence != nullptr)
             sequence->AdvanceToNextEcho();
 
-        if (backend != nullptr)
-            backend->OnEchoBoundary(sequence != nullptr ? sequence->GetCurrentPitchRatio() : 1.0f);
+        sendEchoBoundaryToBackends(sequence != nullptr ? sequence->GetCurrentPitchRatio() : 1.0f);
     }
 
     // Mono-linked mode: right channel mirrors the left channel's ratio.
     void OnNewEchoBoundaryMirrored(float mirroredRatio)
     {
         CommitPendingSequenceIfAny();
-
-        if (backend != nullptr)
-            backend->OnEchoBoundary(mirroredRatio);
+        sendEchoBoundaryToBackends(mirroredRatio);
     }
 
     float ProcessSample(float inputSample)
     {
-        if (!GetEnabled())
-            return inputSample;
+        return ProcessSample(inputSample, inputSample);
+    }
 
-        if (sequence == nullptr || backend == nullptr)
+    // While IsBackendFading, the outgoing backend is fed outgoingInputSample: the caller
+    // reads it for GetOutgoingLatencyMilliseconds, so both backends' outputs line up.
+    float ProcessSample(float inputSample, float outgoingInputSample)
+    {
+        // Neither backend is heard here, so a fade just completes (and can't stall exchanges).
+        if (!GetEnabled() || sequence == nullptr || backend == nullptr)
+        {
+            cancelBackendFade();
             return inputSample;
+        }
+
+        const float ratio = sequence->GetCurrentPitchRatio();
+        const float output = backend->ProcessSample(inputSample, ratio);
+
+        if (!fadingOut)
+            return output;
+
+        const float outgoingOutput = outgoingBackend->ProcessSample(outgoingInputSample, ratio);
+
+        // The incoming backend warms up (fills its buffers) at zero gain, then fades in.
+        float incomingGain = 0.0f;
 
-        return backend->ProcessSample(inputSample, sequence->GetCurrentPitchRatio());
+        if (fadeWarmupSamplesLeft > 0)
+            --fadeWarmupSamplesLeft;
+        else
+            incomingGain = 1.0f - static_cast<float>(fadeSamplesLeft--) / static_cast<float>(fadeSamples);
+
+        if (fadeSamplesLeft <= 0)
+            cancelBackendFade();
+
+        return outgoingOutput + (output - outgoingOutput) * incomingGain;
     }
 
     // Stages a new sequence; it will be committed at the next echo boundary.
     void SetSequence(std::unique_ptr<IPitchSequence> newSequence)
     {
-        pendingSequence = std::move(newSequence);
+        ExchangePendingSequence(std::move(newSequence));
+    }
+
+    // Same as SetSequence, but hands back the object it displaced (an uncommitted
+    // pending sequence or the last retired one) so the caller can free it elsewhere.
+    std::unique_ptr<IPitchSequence> ExchangePendingSequence(std::unique_ptr<IPitchSequence> newSequence)
+    {
+        std::swap(pendingSequence, newSequence);
 
         if (pendingSequence != nullptr)
             pendingSequence->Reset();
 
         hasPendingSequence = true;
+
+        return newSequence;
+    }
+
+    // Not realtime: allocates and prepares the backend. PitchShifter builds them on the
+    // background worker and swaps them in with ExchangeBackend.
+    static std::unique_ptr<IPitchShifterBackend> CreateBackend(const BackendSettings& settings, double newSampleRate)
+    {
+        if (settings.Type == BackendType::PhaseVocoder)
+        {
+            auto phaseVocoder = std::make_unique<PhaseVocoderPitchBackend>();
+            phaseVocoder->Prepare(newSampleRate);
+            return phaseVocoder;
+        }
+
+        auto granular = createGranularBackend();
+        granular->Prepare(newSampleRate);
+
+        // After Prepare: re-spreading the heads needs the source buffer.
+        granular->SetGrainCount(settings.GrainCount);
+        granular->SetWindowShape(settings.WindowShape);
+
+        return granular;
     }
 
-    void SetBackendType(BackendType newBackendType)
+    // Realtime safe. Swaps in a backend already prepared at this sample rate, starting at the
+    // current ratio, and hands back the one retired by the previous exchange so the caller
+    // can free it elsewhere.
+    //
+    // With crossfade, the replaced backend keeps running: the new one first runs silently
+    // for its latency (so a phase vocoder has a full frame, and granular heads have their
+    // lookback) and then fades in over BackendCrossfadeMilliseconds. Don't exchange again
+    // while IsBackendFading. Without crossfade (PrepareToPlay, or nothing audible) the swap
+    // is immediate.
+    std::unique_ptr<IPitchShifterBackend> ExchangeBackend(std::unique_ptr<IPitchShifterBackend> newBackend,
+                                                          bool crossfade)
     {
-        if (newBackendType == BackendType::Granular)
+        jassert(!fadingOut);
+
+        // Park the current backend where the retired one was, and hand the retired one back.
+        std::swap(outgoingBackend, backend);
+        std::swap(backend, newBackend);
+
+        if (backend != nullptr)
+            backend->SetInitialRatio(GetCurrentPitchRatio());
+
+        if (crossfade && backend != nullptr && outgoingBackend != nullptr)
         {
-            auto granular = std::make_unique<GranularPitchBackend>();
-            granular->SetGrainLengthMilliseconds(35.0f);
-            granular->SetJitterPercent(0.15f);
-            granular->SetLookbackMultiplier(3.0f);
-            SetBackend(std::move(granular));
+            fadeWarmupSamplesLeft = static_cast<int>(std::ceil(backend->GetLatencyMilliseconds() * 0.001 * sampleRate));
+            fadeSamples = std::max(1, static_cast<int>(BackendCrossfadeMilliseconds * 0.001 * sampleRate));
+            fadeSamplesLeft = fadeSamples;
+            fadingOut = true;
         }
+
+        return newBackend;
+    }
+
+    bool IsBackendFading() const
+    {
+        return fadingOut;
+    }
+
+    // Latency of the backend being faded out; only meaningful while IsBackendFading.
+    float GetOutgoingLatencyMilliseconds() const
+    {
+        return fadingOut ? outgoingBackend->GetLatencyMilliseconds() : GetLatencyMilliseconds();
     }
 
     // Commits a pending sequence immediately — only safe outside the audio thread.
@@ -144,8 +241,7 @@ public:
     {
         if (hasPendingSequence && pendingSequence != nullptr)
         {
-            sequence = std::move(pendingSequence);
-            hasPendingSequence = false;
+            commitPendingSequence();
 
             if (backend != nullptr)
                 backend->SetInitialRatio(sequence->GetCurrentPitchRatio());
@@ -156,8 +252,7 @@ public:
     {
         if (hasPendingSequence && pendingSequence != nullptr)
         {
-            sequence = std::move(pendingSequence);
-            hasPendingSequence = false;
+            commitPendingSequence();
 
             if (backend != nullptr)
                 backend->Reset();
@@ -167,6 +262,8 @@ public:
 
             if (backend != nullptr)
                 backend->SetInitialRatio(sequence != nullptr ? sequence->GetCurrentPitchRatio() : 1.0f);
+
+            cancelBackendFade();
         }
     }
 
@@ -180,10 +277,25 @@ public:
 
         if (backend != nullptr)
             backend->SetInitialRatio(sequence != nullptr ? sequence->GetCurrentPitchRatio() : 1.0f);
+
+        cancelBackendFade();
+    }
+
+    // Clears the backend buffers but keeps the sequence position.
+    void ResetBackendToCurrentRatio()
+    {
+        cancelBackendFade();
+
+        if (backend == nullptr)
+            return;
+
+        backend->Reset();
+        backend->SetInitialRatio(GetCurrentPitchRatio());
     }
 
     void SetBackend(std::unique_ptr<IPitchShifterBackend>&& newBackend)
     {
+        cancelBackendFade();
         backend = std::move(newBackend);
 
         if (backend != nullptr)
@@ -209,6 +321,40 @@ public:
     }
 
 private:
+    static std::unique_ptr<GranularPitchBackend> createGranularBackend()
+    {
+        auto granular = std::make_unique<GranularPitchBackend>();
+        granular->SetGrainLengthMilliseconds(35.0f);
+        granular->SetJitterPercent(0.15f);
+        granular->SetLookbackMultiplier(3.0f);
+        return granular;
+    }
+
+    void sendEchoBoundaryToBackends(float newRatio)
+    {
+        if (backend != nullptr)
+            backend->OnEchoBoundary(newRatio);
+
+        if (fadingOut)
+            outgoingBackend->OnEchoBoundary(newRatio);
+    }
+
+    // The outgoing backend stays parked until the next exchange hands it back.
+    void cancelBackendFade()
+    {
+        fadingOut = false;
+        fadeWarmupSamplesLeft = 0;
+        fadeSamplesLeft = 0;
+    }
+
+    // The outgoing sequence is parked in pendingSequence rather than destroyed here,
+    // so committing never frees memory on the audio thread.
+    void commitPendingSequence()
+    {
+        std::swap(sequence, pendingSequence);
+        hasPendingSequence = false;
+    }
+
     double sampleRate = 48000.0;
     bool hasPendingSequence = false;
 
@@ -216,5 +362,12 @@ private:
     std::unique_ptr<IPitchSequence>      pendingSequence;
     std::unique_ptr<IPitchShifterBackend> backend;
 
+    // The backend being faded out while fadingOut, else the last one retired.
+    std::unique_ptr<IPitchShifterBackend> outgoingBackend;
+    bool fadingOut = false;
+    int fadeWarmupSamplesLeft = 0;
+    int fadeSamples = 1;
+    int fadeSamplesLeft = 0;
+
     std::atomic<bool> enabled { false };
 };
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+// Central parameter smoothing for one engine instance.
+//
+// Consumers register a smoother in PrepareToPlay and get a small handle back. Once per
+// block, Advance() renders every moving smoother into its own ramp array (exponential
+// one-pole or linear), so the per-sample code only reads the next ramp value. Smoothers
+// that have converged are marked idle and cost nothing until their target moves again.
+//
+// The bank is sized at compile time: MaxSmoothers states, and one ramp arena holding a ramp
+// for each of them, allocated whole in Prepare. Ramp pointers never move, and re-preparing
+// at the same block size reuses the arena instead of allocating a ramp per smoother.
+class SmoothingBank
+{
+public:
+    enum class RampType
+    {
+        Exponential, // v += coefficient * (target - v), per sample
+        Linear       // straight ramp over a fixed time, restarted on each new target
+    };
+
+    static constexpr int MaxSmoothers = 64;
+
+private:
+    static constexpr int ChunkSize = 8;
+
+    struct State
+    {
+        RampType Type = RampType::Exponential;
+
+        float Current = 0.0f;
+        float Target = 0.0f;
+
+        // Exponential
+        float Coefficient = 1.0f;
+        std::array<float, ChunkSize> Powers {};   // (1 - c)^1 .. (1 - c)^ChunkSize
+
+        // Linear
+        int LinearRampSamples = 1;
+        int LinearSamplesRemaining = 0;
+        float LinearRampTarget = 0.0f;
+        float LinearStep = 0.0f;
+
+        bool Idle = true;
+        bool RampIsConstant = true;
+
+        float* Ramp = nullptr;       // maxBlockSize floats in rampArena
+        int Cursor = 0;
+        int LastIndex = 0;
+    };
+
+public:
+    class Smoother
+    {
+    public:
+        // Cheap, safe to call per sample; the new target applies from the next block.
+        void SetTarget(float newTarget)
+        {
+            auto& state = getState();
+
+            if (newTarget == state.Target)
+                return;
+
+            state.Target = newTarget;
+            state.Idle = false;
+        }
+
+        // Jumps with no ramp, including what is left of the current block.
+        void SetCurrentAndTarget(float newValue)
+        {
+            auto& state = getState();
+
+            state.Current = newValue;
+            state.Target = newValue;
+            state.LinearSamplesRemaining = 0;
+            state.Idle = true;
+            state.RampIsConstant = false;
+
+            std::fill(state.Ramp + std::min(state.Cursor, state.LastIndex), state.Ramp + bank->maxBlockSize, newValue);
+        }
+
+        // Exponential only, per-sample one-pole coefficient.
+        void SetCoefficient(float newCoefficient)
+        {
+            auto& state = getState();
+
+            if (newCoefficient == state.Coefficient)
+                return;
+
+            state.Coefficient = std::clamp(newCoefficient, 0.0f, 1.0f);
+            buildPowers(state);
+        }
+
+        // Linear only.
+        void SetRampSeconds(double rampSeconds)
+        {
+            auto& state = getState();
+            state.LinearRampSamples = std::max(1, static_cast<int>(std::floor(rampSeconds * bank->sampleRate)));
+        }
+
+        float GetNextValue()
+        {
+            auto& state = getState();
+            const int index = state.Cursor < state.LastIndex ? state.Cursor++ : state.LastIndex;
+
+            return state.Ramp[static_cast<size_t>(index)];
+        }
+
+        const float* GetRamp() const { return getState().Ramp; }
+
+        float GetCurrentValue() const { return getState().Current; }
+        float GetTargetValue() const { return getState().Target; }
+        bool IsIdle() const { return getState().Idle; }
+
+    private:
+        friend class SmoothingBank;
+
+        State& getState() { return bank->states[static_cast<size_t>(index)]; }
+        const State& getState() const { return bank->states[static_cast<size_t>(index)]; }
+
+        SmoothingBank* bank = nullptr;
+        int index = 0;
+    };
+
+    // Drops every registration; consumers register again in their own PrepareToPlay.
+    void Prepare(double newSampleRate, int newMaxBlockSize)
+    {
+        sampleRate = newSampleRate;
+        maxBlockSize = std::max(1, newMaxBlockSize);
+
+        // One ramp per state, including the overflow slot.
+        rampArena.assign(static_cast<size_t>(NumStateSlots) * static_cast<size_t>(maxBlockSize), 0.0f);
+
+        numStates = 0;
+    }
+
+    // Prepare time only. Registering more than MaxSmoothers is a bug (raise MaxSmoothers):
+    // it asserts, and in release builds every extra smoother shares one spare slot, so the
+    // values are wrong but nothing reads outside the bank.
+    Smoother Register(RampType type, float initialValue)
+    {
+        jassert(numStates < MaxSmoothers);
+
+        const int stateIndex = std::min(numStates, MaxSmoothers);
+        numStates = std::min(numStates + 1, NumStateSlots);
+
+        const size_t rampOffset = static_cast<size_t>(stateIndex) * static_cast<size_t>(maxBlockSize);
+        std::fill(rampArena.begin() + static_cast<std::ptrdiff_t>(rampOffset),
+                  rampArena.begin() + static_cast<std::ptrdiff_t>(rampOffset + static_cast<size_t>(maxBlockSize)),
+                  initialValue);
+
+        State state;
+        state.Type = type;
+        state.Current = initialValue;
+        state.Target = initialValue;
+        state.Ramp = rampArena.data() + rampOffset;
+        state.LastIndex = maxBlockSize - 1;
+        state.RampIsConstant = true;
+
+        buildPowers(state);
+        states[static_cast<size_t>(stateIndex)] = state;
+
+        Smoother smoother;
+        smoother.bank = this;
+        smoother.index = stateIndex;
+
+        return smoother;
+    }
+
+    // Audio thread, once per block before any consumer reads.
+    void Advance(int numSamples)
+    {
+        const int blockSize = std::clamp(numSamples, 1, maxBlockSize);
+
+        for (int stateIndex = 0; stateIndex < numStates; ++stateIndex)
+        {
+            auto& state = states[static_cast<size_t>(stateIndex)];
+
+            state.Cursor = 0;
+            state.LastIndex = blockSize - 1;
+
+            if (state.Idle)
+            {
+                if (!state.RampIsConstant)
+                {
+                    std::fill(state.Ramp, state.Ramp + maxBlockSize, state.Current);
+                    state.RampIsConstant = true;
+                }
+
+                continue;
+            }
+
+            state.RampIsConstant = false;
+
+            if (state.Type == RampType::Exponential)
+                renderExponential(state, blockSize);
+            else
+                renderLinear(state, blockSize);
+        }
+    }
+
+private:
+    static void buildPowers(State& state)
+    {
+        const float decay = 1.0f - state.Coefficient;
+        float power = 1.0f;
+
+        for (auto& chunkPower : state.Powers)
+        {
+            power *= decay;
+            chunkPower = power;
+        }
+    }
+
+    // v[n] = target + (v0 - target) * (1 - c)^(n + 1), eight samples per step.
+    //
+    // A chunked scalar loop relying on auto-vectorisation, not explicit SIMD: full chunks
+    // have a fixed trip count and no dependency between samples, so the compiler can turn
+    // each one into vector multiply-adds. Only the distance carries from chunk to chunk.
+    static void renderExponential(State& state, int blockSize)
+    {
+        const float target = state.Target;
+        const float chunkDecay = state.Powers[ChunkSize - 1];
+        const float* powers = state.Powers.data();
+        const int fullChunksEnd = blockSize - (blockSize % ChunkSize);
+
+        float distance = state.Current - target;
+        float* ramp = state.Ramp;
+
+        for (int chunkStart = 0; chunkStart < fullChunksEnd; chunkStart += ChunkSize)
+        {
+            for (int i = 0; i < ChunkSize; ++i)
+                ramp[chunkStart + i] = target + (distance * powers[i]);
+
+            distance *= chunkDecay;
+        }
+
+        for (int i = 0; i < blockSize - fullChunksEnd; ++i)
+            ramp[fullChunksEnd + i] = target + (distance * powers[i]);
+
+        state.Current = ramp[blockSize - 1];
+        settleIfConverged(state);
+    }
+
+    static void renderLinear(State& state, int blockSize)
+    {
+        if (state.LinearSamplesRemaining <= 0 || state.LinearRampTarget != state.Target)
+        {
+            state.LinearRampTarget = state.Target;
+            state.LinearSamplesRemaining = state.LinearRampSamples;
+            state.LinearStep = (state.Target - state.Current) / static_cast<float>(state.LinearRampSamples);
+        }
+
+        const int rampLength = std::min(blockSize, state.LinearSamplesRemaining);
+        const float start = state.Current;
+        const float step = state.LinearStep;
+
+        float* ramp = state.Ramp;
+
+        for (int i = 0; i < rampLength; ++i)
+            ramp[i] = start + (step * static_cast<float>(i + 1));
+
+        state.LinearSamplesRemaining -= rampLength;
+
+        if (state.LinearSamplesRemaining == 0)
+        {
+            ramp[rampLength - 1] = state.Target;
+            std::fill(ramp + rampLength, ramp + blockSize, state.Target);
+        }
+
+        state.Current = ramp[blockSize - 1];
+
+        if (state.LinearSamplesRemaining == 0)
+            state.Idle = true;
+    }
+
+    static void settleIfConverged(State& state)
+    {
+        const float tolerance = 1.0e-5f * std::max(1.0f, std::abs(state.Target));
+
+        if (std::abs(state.Target - state.Current) > tolerance)
+            return;
+
+        state.Current = state.Target;
+        state.Idle = true;
+    }
+
+    // MaxSmoothers, plus the spare slot that absorbs registrations past the limit.
+    static constexpr int NumStateSlots = MaxSmoothers + 1;
+
+    double sampleRate = 48000.0;
+    int maxBlockSize = 4096;
+
+    std::array<State, NumStateSlots> states {};
+    int numStates = 0;
+
+    std::vector<float> rampArena;
+};
@@ -2,7 +2,7 @@
 
 #include "../../Chronoverb.h"
 
-void Deverb::PrepareToPlay(double newSampleRate, Filters& filters)
+void Deverb::PrepareToPlay(double newSampleRate, Filters& filters, SmoothingBank& smoothingBank)
 {
     sampleRate = newSampleRate;
     filtersInput = &filters;
@@ -10,24 +10,26 @@ void Deverb::PrepareToPlay(double newSampleRate, Filters& filters)
     delayTimeSegment.PrepareToPlay(sampleRate);
     delayTimeSegment.UpdateDelayMilliseconds();
 
-    delayLineLeft = DelayLine(delayTimeSegment.MaxDelaySamples);
-    delayLineRight = DelayLine(delayTimeSegment.MaxDelaySamples);
+    delayLineLeft.Resize(delayTimeSegment.MaxDelaySamples);
+    delayLineRight.Resize(delayTimeSegment.MaxDelaySamples);
 
     delayLineLeft.SetSampleRate(sampleRate);
     delayLineRight.SetSampleRate(sampleRate);
 
-    delayLineLeft.Clear();
-    delayLineRight.Clear();
-
     // Diffusion
     diffusionLeft.Prepare(sampleRate, AllpassTunings,
-        JitterLfoRateHz, JitterLfoDepthMs);
+        JitterLfoRateHz, JitterLfoDepthMs, smoothingBank);
 
     diffusionRight.Prepare(sampleRate, AllpassTunings,
-        JitterLfoRateHz, JitterLfoDepthMs * jitterStereoDecoration);
+        JitterLfoRateHz, JitterLfoDepthMs * jitterStereoDecoration, smoothingBank);
 
     setBlendedStageGains();
 
+    // The chains know their tuning total now, so the delay-derived size can be applied.
+    updateDynamicDiffusionSizeFromDelayTime();
+    diffusionLeft.RebuildLayoutNow();
+    diffusionRight.RebuildLayoutNow();
+
     dampingLeft = DampingFilter();
     dampingRight = DampingFilter();
 
@@ -39,10 +41,10 @@ void Deverb::PrepareToPlay(double newSampleRate, Filters& filters)
 
     updateFeedbackGainFromFeedbackTime();
 
-    smoothedBlend = getAmountLower();
-    smoothedReadDelayMs = delayTimeSegment.DelayTimeMilliseconds;
-
     blendSlewCoefficient = 1.0f / (0.01f * static_cast<float>(sampleRate)); // ~10 ms
+
+    blendSmoother = smoothingBank.Register(SmoothingBank::RampType::Exponential, getAmountLower());
+    blendSmoother.SetCoefficient(blendSlewCoefficient);
     readDelaySlewCoefficient = delayTimeSegment.ReadDelaySlewCoefficient;
 
     staticCompensationMs = diffusionLeft.GetTotalChainDelayMs() * diffusionCompensationBias;
@@ -56,12 +58,16 @@ void Deverb::ProcessBlock(juce::AudioBuffer<float>& audioBuffer)
 
     readDelaySlewCoefficient = delayTimeSegment.ReadDelaySlewCoefficient;
     updateDynamicDiffusionSizeFromDelayTime();
+
+    blendSmoother.SetTarget(getAmountLower());
+    diffusionLeft.ProcessBlock();
+    diffusionRight.ProcessBlock();
 }
 
 std::pair<float, float> Deverb::ProcessSample(float inputSampleL, float inputSampleR)
 {
     // 0) Variables
-    const float diffusionAmountLower = getAmountLower(); // 0.0 - 0.5
+    const float blend = blendSmoother.GetNextValue(); // Smoothed 0.0 - 0.5 amount
     //const float diffusionAmountUpper = getAmountUpper(); // 0.5 - 1.0
 
     // 1) Input + feedback
@@ -101,23 +107,36 @@ std::pair<float, float> Deverb::ProcessSample(float inputSampleL, float inputSam
 
     float diffusionStereoDecorrelation = jitterStereoDecoration * diffusionAmount;
 
-    if (diffusionAmount > 0.0001f)
+    // Keep running until the blend has faded the chain out, then bypass it.
+    if (diffusionAmount > 0.0001f || blend > 0.0001f)
     {
+        // Drop the stale tail left from the last time it ran.
+        if (diffusionIdle)
+        {
+            diffusionLeft.Reset();
+            diffusionRight.Reset();
+            diffusionIdle = false;
+        }
+
         diffusedTapL = diffusionLeft.ProcessSample(filteredL);
         diffusedTapR = diffusionRight.ProcessSample(filteredR);
     }
+    else
+    {
+        diffusionIdle = true;
+    }
 
     // 4) Blend between clean path and diffused path
-    smoothedBlend += blendSlewCoefficient * (diffusionAmountLower - smoothedBlend);
-    smoothedBlend = std::clamp(smoothedBlend, 0.0f, 1.0f);
-
     const float writeSignalL =
-        (cleanTapL * (1.0f - smoothedBlend)) + (diffusedTapL * smoothedBlend);
+        (cleanTapL * (1.0f - blend)) + (diffusedTapL * blend);
 
     const float writeSignalR =
-        (cleanTapR * (1.0f - smoothedBlend)) + (diffusedTapR * smoothedBlend);
+        (cleanTapR * (1.0f - blend)) + (diffusedTapR * blend);
 
     // 5) Damping
+    lastPreDampingL = writeSignalL;
+    lastPreDampingR = writeSignalR;
+
     const float dampedL = dampingLeft.ProcessSample(writeSignalL);
     const float dampedR = dampingRight.ProcessSample(writeSignalR);
 
@@ -133,7 +152,8 @@ void Deverb::Reset()
     lastFeedbackL = 0.0f;
     lastFeedbackR = 0.0f;
 
-    smoothedReadDelayMs = std::max(1.0f, delayTimeSegment.DelayTimeMilliseconds);
+    lastPreDampingL = 0.0f;
+    lastPreDampingR = 0.0f;
 
     delayLineLeft.Clear();
     delayLineRight.Clear();
@@ -184,25 +204,33 @@ void Deverb::SetHostTempo(float bpm)
     hostBPM = bpm;
 
     delayTimeSegment.SetHostTempo(hostBPM);
-    updateDynamicDiffusionSizeFromDelayTime();
+
+    if (!isInParameterBatch())
+        updateDynamicDiffusionSizeFromDelayTime();
 }
 
 void Deverb::SetDelayTime(float newDelayTime)
 {
     delayTimeSegment.SetDelayTime(newDelayTime);
-    updateDynamicDiffusionSizeFromDelayTime();
+
+    if (!isInParameterBatch())
+        updateDynamicDiffusionSizeFromDelayTime();
 }
 
 void Deverb::SetDelayMode(int newDelayMode)
 {
     delayTimeSegment.SetDelayMode(newDelayMode);
-    updateDynamicDiffusionSizeFromDelayTime();
+
+    if (!isInParameterBatch())
+        updateDynamicDiffusionSizeFromDelayTime();
 }
 
 void Deverb::SetFeedbackTime(float newFeedbackTimeSeconds)
 {
     feedbackTimeSeconds = std::max(0.0f, newFeedbackTimeSeconds);
-    updateFeedbackGainFromFeedbackTime();
+
+    if (!isInParameterBatch())
+        updateFeedbackGainFromFeedbackTime();
 }
 
 void Deverb::SetDiffusionAmount(float newAmount01)
@@ -212,13 +240,16 @@ void Deverb::SetDiffusionAmount(float newAmount01)
     diffusionLeft.SetDiffusionAmount(diffusionAmount);
     diffusionRight.SetDiffusionAmount(diffusionAmount);
 
-    setBlendedStageGains();
+    if (!isInParameterBatch())
+        setBlendedStageGains();
 }
 
 void Deverb::SetDiffusionSize(float newSize01)
 {
     diffusionSize = std::clamp(newSize01, 0.0f, 1.0f);
-    updateDynamicDiffusionSizeFromDelayTime();
+
+    if (!isInParameterBatch())
+        updateDynamicDiffusionSizeFromDelayTime();
 }
 
 void Deverb::SetDiffusionQuality(int newQualityStages)
@@ -234,6 +265,23 @@ void Deverb::SetFiltersOrder(int newOrder)
     filtersOrder = newOrder;
 }
 
+void Deverb::BeginParameterBatch()
+{
+    parameterBatchDepth.fetch_add(1, std::memory_order_acq_rel);
+
+    diffusionLeft.BeginParameterBatch();
+    diffusionRight.BeginParameterBatch();
+}
+
+void Deverb::EndParameterBatch()
+{
+    if (parameterBatchDepth.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        updateDerivedState();
+
+    diffusionLeft.EndParameterBatch();
+    diffusionRight.EndParameterBatch();
+}
+
 //endregion
 
 //region Update functions
@@ -266,6 +314,14 @@ void Deverb::updateDynamicDiffusionSizeFromDelayTime()
     diffusionRight.SetDiffusionSize(effectiveSize);
 }
 
+// Everything the setters would have recomputed one by one during a batch.
+void Deverb::updateDerivedState()
+{
+    updateFeedbackGainFromFeedbackTime();
+    setBlendedStageGains();
+    updateDynamicDiffusionSizeFromDelayTime();
+}
+
 void Deverb::setBlendedStageGains()
 {
     // Blend region: 0.5 -> 1.0 diffusion amount
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <algorithm>
@@ -21,29 +22,33 @@ public:
     static constexpr float BaseDelayAllpassGain = 0.58f;
     static constexpr float BasedReverbAllpassGain = 1.0f;
 
-    const std::array<float, DeverbDiffusionChain::MaxStages> AllpassTunings =
+    // Constant tables, shared by every instance.
+    static constexpr std::array<float, DeverbDiffusionChain::MaxStages> AllpassTunings =
     {
         3.0, 5.0, 19.0, 31.0, 43.0, 53.0, 73.0, 83.0
         //11.0f, 13.0f, 23.0f, 31.0f, 43.0f, 53.0f, 73.0f, 83.0f
     };
 
     // Delay
-    const std::array<float, DeverbDiffusionChain::MaxStages> DelayAllpassGainMultipliers =
+    static constexpr std::array<float, DeverbDiffusionChain::MaxStages> DelayAllpassGainMultipliers =
     {
         1.0, 1.0, 1.0, 1.0, 0.5, 0.0, 0.0, 0.0
     };
 
     // Reverb
-    const std::array<float, DeverbDiffusionChain::MaxStages> ReverbAllpassGainMultipliers =
+    static constexpr std::array<float, DeverbDiffusionChain::MaxStages> ReverbAllpassGainMultipliers =
     {
         0.92f, 0.88f, 0.84f, 0.78f, 0.72f, 0.66f, 0.60f, 0.55f
     };
 
-    void PrepareToPlay(double newSampleRate, Filters& filters);
+    void PrepareToPlay(double newSampleRate, Filters& filters, SmoothingBank& smoothingBank);
     void ProcessBlock(juce::AudioBuffer<float>& audioBuffer);
 
     std::pair<float, float> ProcessSample(float inputSampleL, float inputSampleR);
 
+    // The last ProcessSample's signal just before damping, for the spectrum analyzer.
+    std::pair<float, float> GetLastPreDampingSample() const { return { lastPreDampingL, lastPreDampingR }; }
+
     void Reset();
 
     std::pair<DelayLine&, DelayLine&> GetDelayLines();
@@ -60,6 +65,11 @@ public:
 
     void SetFiltersOrder(int newOrder);
 
+    // Defer the rebuilds that setters trigger until the end of a batch (state restore),
+    // so each one runs once. Batches may nest.
+    void BeginParameterBatch();
+    void EndParameterBatch();
+
 private:
     float getAmountLower() const;
     float getAmountUpper() const;
@@ -67,6 +77,9 @@ private:
     void updateFeedbackGainFromFeedbackTime();
     void updateDynamicDiffusionSizeFromDelayTime();
     void setBlendedStageGains();
+    void updateDerivedState();
+
+    bool isInParameterBatch() const { return parameterBatchDepth.load(std::memory_order_acquire) > 0; }
 
     // Parameters
     double sampleRate = 48000.0;
@@ -93,14 +106,19 @@ private:
     float lastFeedbackL = 0.0f;
     float lastFeedbackR = 0.0f;
 
-    float smoothedBlend = 0.0f;
-    float smoothedReadDelayMs = 1.0f;
+    float lastPreDampingL = 0.0f;
+    float lastPreDampingR = 0.0f;
+
+    SmoothingBank::Smoother blendSmoother;
+    bool diffusionIdle = true;
 
     float blendSlewCoefficient = 0.0f;
     float readDelaySlewCoefficient = 0.0f;
 
     float staticCompensationMs = 0.0f;
 
+    std::atomic<int> parameterBatchDepth { 0 };
+
     DelayTimeSegment delayTimeSegment;
 
     DelayLine delayLineLeft = DelayLine(0);
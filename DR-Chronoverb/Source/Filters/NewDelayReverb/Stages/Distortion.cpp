@@ -2,11 +2,11 @@
 
 #include <tuple>
 
-void Distortion::PrepareToPlay(float newSampleRate)
+void Distortion::PrepareToPlay(float newSampleRate, SmoothingBank& smoothingBank)
 {
-    distortionModule1.PrepareToPlay(newSampleRate);
-    distortionModule2.PrepareToPlay(newSampleRate);
-    distortionModule3.PrepareToPlay(newSampleRate);
+    distortionModule1.PrepareToPlay(newSampleRate, smoothingBank);
+    distortionModule2.PrepareToPlay(newSampleRate, smoothingBank);
+    distortionModule3.PrepareToPlay(newSampleRate, smoothingBank);
 }
 
 // The master class the holds all of the different types of distortion.
@@ -113,4 +113,16 @@ void Distortion::SetTarget(int index, int newDistortionTarget)
         distortionModule3.SetTarget(newDistortionTarget);
     else
         DBG("Invalid distortion index: " << index);
+}
+
+const ScopeFeed& Distortion::GetScopeFeed(int index) const
+{
+    if (index == 1)
+        return distortionModule2.GetScopeFeed();
+
+    if (index == 2)
+        return distortionModule3.GetScopeFeed();
+
+    jassert(index == 0);
+    return distortionModule1.GetScopeFeed();
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ class DistortionModuleDSP;
 class Distortion
 {
 public:
-    void PrepareToPlay(float newSampleRate);
+    void PrepareToPlay(float newSampleRate, SmoothingBank& smoothingBank);
 
     std::tuple<float, float, float, float> ProcessSample(float inputDryL, float inputDryR, float inputWetL, float inputWetR);
 
@@ -26,6 +26,9 @@ public:
     void SetType(int index, int newType);
     void SetTarget(int index, int newTarget);
 
+    // For the editor's module scopes.
+    const ScopeFeed& GetScopeFeed(int index) const;
+
 private:
     DistortionModuleDSP distortionModule1;
     DistortionModuleDSP distortionModule2;
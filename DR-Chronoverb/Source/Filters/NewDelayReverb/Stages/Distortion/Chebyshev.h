@@ -5,19 +5,20 @@
 #include <utility>
 
 #include "../Utils/DCBlocker.h"
+#include "../../SmoothingBank.h"
 
 // TODO: Sounds nothing like bitwigs chebyshev :(
 class Chebyshev
 {
 public:
-    void PrepareToPlay(double newSampleRate)
+    void PrepareToPlay(double newSampleRate, SmoothingBank& smoothingBank)
     {
         sampleRate = std::max(1.0, newSampleRate);
         dcBlocker.Prepare(sampleRate);
         dcBlocker.SetCutoffHz(10.0f);
 
-        smoothedHarmonics.reset(sampleRate, 0.02); // 20 ms
-        smoothedHarmonics.setCurrentAndTargetValue(harmonics);
+        harmonicsSmoother = smoothingBank.Register(SmoothingBank::RampType::Linear, harmonics);
+        harmonicsSmoother.SetRampSeconds(0.02); // 20 ms
 
         Reset();
     }
@@ -30,7 +31,6 @@ public:
     void SetHarmonics(float newHarmonics)
     {
         harmonics = std::clamp(newHarmonics, 0.0f, 32.0f);
-        smoothedHarmonics.setTargetValue(harmonics);
     }
 
     void SetOrder(int newOrder)
@@ -65,13 +65,22 @@ public:
         dcBlockEnabled = shouldEnable;
     }
 
-    std::pair<float, float> ProcessSample(float inputL, float inputR)
+    // Advances the harmonics smoother by one sample frame (the target lands next block).
+    // Read it once per frame and pass it to every ProcessSample call of that frame, even
+    // when the frame shapes both the dry and the wet path.
+    float GetNextHarmonics()
+    {
+        harmonicsSmoother.SetTarget(harmonics);
+        return harmonicsSmoother.GetNextValue();
+    }
+
+    std::pair<float, float> ProcessSample(float inputL, float inputR, float currentHarmonics)
     {
         const float dryL = inputL;
         const float dryR = inputR;
 
-        float wetL = ProcessMono(inputL);
-        float wetR = ProcessMono(inputR);
+        float wetL = ProcessMono(inputL, currentHarmonics);
+        float wetR = ProcessMono(inputR, currentHarmonics);
 
         if (dcBlockEnabled)
         {
@@ -94,12 +103,11 @@ public:
     // This is the isolated nonlinear function you'd later run inside an
     // upsample/process/downsample wrapper.
     // ------------------------------------------------------------------
-    float ProcessShaperOnly(float inputSample)
+    float ProcessShaperOnly(float inputSample, float currentHarmonics)
     {
         float x = inputSample * inputTrim * drive;
         x = std::clamp(x, -1.0f, 1.0f);
 
-        const float currentHarmonics = smoothedHarmonics.getNextValue();
         const float mappedOrder = MapHarmonicsToOrder(currentHarmonics, maxPolynomialOrder);
 
         const int lowerOrder =
@@ -124,9 +132,9 @@ public:
     }
 
 private:
-    float ProcessMono(float inputSample)
+    float ProcessMono(float inputSample, float currentHarmonics)
     {
-        return ProcessShaperOnly(inputSample);
+        return ProcessShaperOnly(inputSample, currentHarmonics);
     }
 
     static float EvaluateChebyshevPolynomial(float x, int polynomialOrder)
@@ -181,7 +189,7 @@ private:
     float inputTrim = 0.8f;
     bool dcBlockEnabled = true;
 
-    juce::SmoothedValue<float> smoothedHarmonics;
+    SmoothingBank::Smoother harmonicsSmoother;
 
     DCBlocker dcBlocker;
 };
\ No newline at end of file
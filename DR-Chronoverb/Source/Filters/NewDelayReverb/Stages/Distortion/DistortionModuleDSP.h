@@ -4,13 +4,15 @@
 
 #include "Chebyshev.h"
 #include "HardClipper.h"
+#include "../Utils/ScopeFeed.h"
 
 class DistortionModuleDSP
 {
 public:
-    void PrepareToPlay(float newSampleRate)
+    void PrepareToPlay(float newSampleRate, SmoothingBank& smoothingBank)
     {
-        chebyshev.PrepareToPlay(newSampleRate);
+        chebyshev.PrepareToPlay(newSampleRate, smoothingBank);
+        scopeFeed.Prepare(newSampleRate);
     }
 
     std::tuple<float, float, float, float> ProcessSample(float dryL, float dryR, float wetL, float wetR)
@@ -36,7 +38,10 @@ public:
                 in.second + (processed.second - in.second) * moduleMix);
         };
 
-        auto processByType = [this](float left, float right) -> std::pair<float, float>
+        // Once per sample frame, shared by the dry and wet calls below.
+        const float chebyshevHarmonics = (distortionType == 1) ? chebyshev.GetNextHarmonics() : 0.0f;
+
+        auto processByType = [this, chebyshevHarmonics](float left, float right) -> std::pair<float, float>
         {
             switch (distortionType)
             {
@@ -45,7 +50,7 @@ public:
                     return hardClipper.ProcessSample(left, right);
 
                 case 1: // Chebyshev
-                    return chebyshev.ProcessSample(left, right);
+                    return chebyshev.ProcessSample(left, right, chebyshevHarmonics);
 
                 case 3: // Tube - temporary alias
                     return hardClipper.ProcessSample(left, right);
@@ -67,6 +72,10 @@ public:
             outWet = blendPair({ wetL, wetR }, processedWet);
         }
 
+        // The scope follows the signal this module acts on (wet when it does both).
+        const auto& scopedPair = (distortionTarget == 0) ? outDry : outWet;
+        scopeFeed.PushSample(0.5f * (scopedPair.first + scopedPair.second));
+
         return std::make_tuple(outDry.first, outDry.second, outWet.first, outWet.second);
     }
 
@@ -90,9 +99,12 @@ public:
 
     void SetMix(float newMix) { mix = newMix; }
 
+    const ScopeFeed& GetScopeFeed() const { return scopeFeed; }
+
 private:
     HardClipper hardClipper;
     Chebyshev chebyshev;
+    ScopeFeed scopeFeed;
 
     const float maxDrive = 32.0f;
     const float maxChebyshev = 32.0f;
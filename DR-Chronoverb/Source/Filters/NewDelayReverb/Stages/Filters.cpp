@@ -2,9 +2,24 @@
 
 void Filters::PrepareToPlay(double newSampleRate)
 {
+    filterJob.Suspend();
+
     sampleRate = newSampleRate;
 
-    // Prepare IIR filters
+    filterJob.RunNow();
+    coefficientMailbox.Pull();
+
+    const auto& designed = coefficientMailbox.GetReadSlot();
+
+    // Not realtime here, so the coefficient arrays can take on their final size.
+    lowpassL.coefficients->coefficients.resize(designed.NumLowPass);
+    lowpassR.coefficients->coefficients.resize(designed.NumLowPass);
+    highpassL.coefficients->coefficients.resize(designed.NumHighPass);
+    highpassR.coefficients->coefficients.resize(designed.NumHighPass);
+
+    applyCoefficients(designed);
+
+    // Prepare IIR filters (after the coefficients, so their state is sized for the final order)
     juce::dsp::ProcessSpec filterSpec {};
     filterSpec.sampleRate = sampleRate;
     filterSpec.maximumBlockSize = 4096;
@@ -14,15 +29,14 @@ void Filters::PrepareToPlay(double newSampleRate)
     lowpassR.prepare(filterSpec);
     highpassL.prepare(filterSpec);
     highpassR.prepare(filterSpec);
-
-    updateFilters();
-    filterRebuildPending.store(false, std::memory_order_release);
 }
 
 void Filters::ProcessBlock(juce::AudioBuffer<float>& audioBuffer)
 {
-    if (filterRebuildPending.exchange(false, std::memory_order_acq_rel))
-        updateFilters();
+    juce::ignoreUnused(audioBuffer);
+
+    if (coefficientMailbox.Pull())
+        applyCoefficients(coefficientMailbox.GetReadSlot());
 }
 
 std::pair<float, float> Filters::ProcessSample(float inputL, float inputR)
@@ -39,28 +53,61 @@ std::pair<float, float> Filters::ProcessSample(float inputL, float inputR)
     return std::make_pair(outputLeft, outputRight);
 }
 
+// Background worker: the JUCE designers allocate, so they never run on the audio thread.
 void Filters::updateFilters()
 {
+    const double designSampleRate = sampleRate;
+
     auto lpCoeffs =
-        juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate,  lowPassCutoff);
+        juce::dsp::IIR::Coefficients<float>::makeLowPass(designSampleRate, lowPassCutoff);
 
     auto hpCoeffs =
-        juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, highPassCutoff);
+        juce::dsp::IIR::Coefficients<float>::makeHighPass(designSampleRate, highPassCutoff);
+
+    auto& designed = coefficientMailbox.GetWriteSlot();
+
+    designed.NumLowPass = std::min(FilterCoefficients::MaxCoefficients, static_cast<int>(lpCoeffs->coefficients.size()));
+    designed.NumHighPass = std::min(FilterCoefficients::MaxCoefficients, static_cast<int>(hpCoeffs->coefficients.size()));
+
+    std::copy_n(lpCoeffs->getRawCoefficients(), designed.NumLowPass, designed.LowPass.begin());
+    std::copy_n(hpCoeffs->getRawCoefficients(), designed.NumHighPass, designed.HighPass.begin());
 
-    *lowpassL.coefficients = *lpCoeffs;
-    *lowpassR.coefficients = *lpCoeffs;
-    *highpassL.coefficients = *hpCoeffs;
-    *highpassR.coefficients = *hpCoeffs;
+    coefficientMailbox.Publish();
+}
+
+// Copies in place; the filter order never changes, so the coefficient arrays keep their size.
+void Filters::applyCoefficients(const FilterCoefficients& newCoefficients)
+{
+    auto copyInto = [](juce::dsp::IIR::Filter<float>& filter, const float* source, int numCoefficients)
+    {
+        if (static_cast<int>(filter.coefficients->coefficients.size()) == numCoefficients)
+            std::copy_n(source, numCoefficients, filter.coefficients->getRawCoefficients());
+    };
+
+    copyInto(lowpassL, newCoefficients.LowPass.data(), newCoefficients.NumLowPass);
+    copyInto(lowpassR, newCoefficients.LowPass.data(), newCoefficients.NumLowPass);
+    copyInto(highpassL, newCoefficients.HighPass.data(), newCoefficients.NumHighPass);
+    copyInto(highpassR, newCoefficients.HighPass.data(), newCoefficients.NumHighPass);
 }
 
 void Filters::SetLowPassCutoff(float cutoff)
 {
     lowPassCutoff = cutoff;
-    filterRebuildPending.store(true, std::memory_order_release);
+    filterJob.Request();
 }
 
 void Filters::SetHighPassCutoff(float cutoff)
 {
     highPassCutoff = cutoff;
-    filterRebuildPending.store(true, std::memory_order_release);
-}
\ No newline at end of file
+    filterJob.Request();
+}
+
+void Filters::BeginParameterBatch()
+{
+    filterJob.Hold();
+}
+
+void Filters::EndParameterBatch()
+{
+    filterJob.Release();
+}
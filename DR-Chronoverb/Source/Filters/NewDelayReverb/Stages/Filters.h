@@ -1,8 +1,13 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <utility>
 #include <juce_dsp/juce_dsp.h>
 
+#include "Utils/LatestValueMailbox.h"
+#include "../../BackgroundWorker.h"
+
 class Filters
 {
 public:
@@ -14,20 +19,39 @@ public:
     void SetLowPassCutoff(float cutoff);
     void SetHighPassCutoff(float cutoff);
 
+    // Defer the rebuilds that setters trigger until the end of a batch (state restore),
+    // so each one runs once. Batches may nest.
+    void BeginParameterBatch();
+    void EndParameterBatch();
 
 private:
-    void updateFilters();
+    // Designed on the background worker, copied into the filters on the audio thread.
+    struct FilterCoefficients
+    {
+        static constexpr int MaxCoefficients = 8;
+
+        std::array<float, MaxCoefficients> LowPass {};
+        std::array<float, MaxCoefficients> HighPass {};
 
-    double sampleRate = 48000.0f;
+        int NumLowPass = 0;
+        int NumHighPass = 0;
+    };
 
-    float lowPassCutoff = 9000.0f;
-    float highPassCutoff = 10.0f;
+    void updateFilters();
+    void applyCoefficients(const FilterCoefficients& newCoefficients);
+
+    // Read by the background coefficient design
+    std::atomic<double> sampleRate { 48000.0 };
 
-    std::atomic<bool> filterRebuildPending { false };
+    std::atomic<float> lowPassCutoff { 9000.0f };
+    std::atomic<float> highPassCutoff { 10.0f };
 
     juce::dsp::IIR::Filter<float> lowpassL;
     juce::dsp::IIR::Filter<float> lowpassR;
 
     juce::dsp::IIR::Filter<float> highpassL;
     juce::dsp::IIR::Filter<float> highpassR;
+
+    LatestValueMailbox<FilterCoefficients> coefficientMailbox;
+    BackgroundJob filterJob { [this] { updateFilters(); } };
 };
@@ -25,6 +25,10 @@ void Delay::PrepareToPlay(double newSampleRate, Filters& filters)
     diffusionReadLeft->Prepare(sampleRate);
     diffusionReadRight->Prepare(sampleRate);
 
+    // A jitter stream per chain, so left and right stay decorrelated
+    diffusionReadLeft->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 0));
+    diffusionReadRight->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 1));
+
     if (diffusionReadLeft) diffusionReadLeft->ClearState();
     if (diffusionReadRight) diffusionReadRight->ClearState();
 
@@ -34,6 +38,8 @@ void Delay::PrepareToPlay(double newSampleRate, Filters& filters)
 
     diffusionWriteLeft->Prepare(sampleRate);
     diffusionWriteRight->Prepare(sampleRate);
+    diffusionWriteLeft->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 2));
+    diffusionWriteRight->SetRandomSeed(RandomStream::DeriveSeed(RandomStream::DefaultSeed, 3));
 
     if (diffusionWriteLeft) diffusionWriteLeft->ClearState();
     if (diffusionWriteRight) diffusionWriteRight->ClearState();
@@ -2,6 +2,11 @@
 
 void Reverb::PrepareToPlay(double newSampleRate, Filters& filters)
 {
+    diffusionJob.Suspend();
+
+    // At an unchanged sample rate the current chains are still valid and are only cleared.
+    const bool sampleRateChanged = newSampleRate != sampleRate || diffusionLeft == nullptr;
+
     sampleRate = newSampleRate;
     filtersInput = &filters;
 
@@ -9,19 +14,12 @@ void Reverb::PrepareToPlay(double newSampleRate, Filters& filters)
     delayTimeSegment.PrepareToPlay(sampleRate);
     delayTimeSegment.UpdateDelayMilliseconds();
 
-    // Diffusion
-    diffusionLeft = std::make_unique<DiffusionChain>();
-    diffusionRight = std::make_unique<DiffusionChain>();
-
-    diffusionLeft->Prepare(sampleRate);
-    diffusionRight->Prepare(sampleRate);
-
-    if (diffusionLeft) diffusionLeft->ClearState();
-    if (diffusionRight) diffusionRight->ClearState();
-
     // Damping
-    dampingLeft = std::make_unique<DampingFilter>();
-    dampingRight = std::make_unique<DampingFilter>();
+    if (dampingLeft == nullptr)
+    {
+        dampingLeft = std::make_unique<DampingFilter>();
+        dampingRight = std::make_unique<DampingFilter>();
+    }
 
     dampingLeft->Prepare(sampleRate);
     dampingRight->Prepare(sampleRate);
@@ -29,11 +27,21 @@ void Reverb::PrepareToPlay(double newSampleRate, Filters& filters)
     dampingLeft->SetCutoffHz(7000.0f);
     dampingRight->SetCutoffHz(7000.0f);
 
-    // Various
-    lastBuiltQualityStages = -1;
-    lastBuiltSize = -1.0f;
+    // Diffusion
+    if (sampleRateChanged)
+    {
+        lastBuiltQualityStages = -1;
+        lastBuiltSize = -1.0f;
+    }
+
+    acquireTunings();
+
+    diffusionJob.RunNow();
+    swapInDiffusionChains();
+
+    diffusionLeft->ClearState();
+    diffusionRight->ClearState();
 
-    rebuildDiffusionIfNeeded();
     updateFeedbackGainFromFeedbackTime();
 
     smoothedCenteredReadDelayMilliseconds = delayTimeSegment.DelayTimeMilliseconds;
@@ -48,8 +56,7 @@ void Reverb::ProcessBlock(juce::AudioBuffer<float>& audioBuffer)
     diffusionLeft->UpdateSize(diffusionSize * timeScale);
     diffusionRight->UpdateSize(diffusionSize * timeScale);
 
-    if (diffusionRebuildPending.exchange(false, std::memory_order_acq_rel))
-        rebuildDiffusionIfNeeded();
+    swapInDiffusionChains();
 }
 
 std::pair<float, float> Reverb::ProcessSample(float inputSampleL, float inputSampleR)
@@ -83,6 +90,18 @@ std::pair<float, float> Reverb::ProcessSample(float inputSampleL, float inputSam
     return std::make_pair(dampedLeft, dampedRight);
 }
 
+void Reverb::Reset()
+{
+    lastFeedbackL = 0.0f;
+    lastFeedbackR = 0.0f;
+
+    diffusionLeft->ClearState();
+    diffusionRight->ClearState();
+
+    dampingLeft->Reset();
+    dampingRight->Reset();
+}
+
 //region Parameters
 
 void Reverb::SetHostTempo(float bpm)
@@ -121,7 +140,7 @@ void Reverb::SetDiffusionSize(float newDiffusionSize)
 void Reverb::SetDiffusionQuality(int newDiffusionQuality)
 {
     diffusionQualityStages = newDiffusionQuality;
-    diffusionRebuildPending.store(true, std::memory_order_release);
+    diffusionJob.Request();
 }
 
 void Reverb::SetFiltersOrder(int newOrder)
@@ -129,35 +148,92 @@ void Reverb::SetFiltersOrder(int newOrder)
     filtersOrder = newOrder;
 }
 
+void Reverb::SetRandomSeed(uint64_t newSeed)
+{
+    randomSeed = newSeed;
+    diffusionJob.Request();
+}
+
+void Reverb::BeginParameterBatch()
+{
+    diffusionJob.Hold();
+}
+
+void Reverb::EndParameterBatch()
+{
+    diffusionJob.Release();
+}
+
 //endregion
 
 //region Update Functions
 
+void Reverb::acquireTunings()
+{
+    constexpr int tuningCount = static_cast<int>(BaseTunings.size());
+
+    tunings = SharedTables::Get(SharedTables::TableType::PitchReverbTunings, 0.0, tuningCount,
+        [](SharedTables::Table& table)
+        {
+            table.assign(BaseTunings.begin(), BaseTunings.end());
+        });
+
+    decorrelatedTunings = SharedTables::Get(SharedTables::TableType::PitchReverbTuningsDecorrelated, 0.0, tuningCount,
+        [](SharedTables::Table& table)
+        {
+            table = DecorrelateTunings(SharedTables::Table(BaseTunings.begin(), BaseTunings.end()));
+        });
+}
+
+// Background worker (and PrepareToPlay).
 void Reverb::rebuildDiffusionIfNeeded()
 {
-    if (diffusionQualityStages == lastBuiltQualityStages
-        && diffusionSize == lastBuiltSize)
+    const int qualityStages = diffusionQualityStages;
+    const float size = diffusionSize;
+    const uint64_t seed = randomSeed;
+    const double chainSampleRate = sampleRate;
+
+    if (qualityStages == lastBuiltQualityStages
+        && size == lastBuiltSize
+        && seed == lastBuiltRandomSeed)
     {
         return;
     }
 
-    lastBuiltQualityStages = diffusionQualityStages;
-    lastBuiltSize = diffusionSize;
+    lastBuiltQualityStages = qualityStages;
+    lastBuiltSize = size;
+    lastBuiltRandomSeed = seed;
 
-    // Diffusion
-    if (diffusionLeft != nullptr)
-    {
-        diffusionLeft->Configure(diffusionQualityStages,
-            diffusionSize, 0.005f, 0.5f, Tunings);
-    }
+    // Replacing the slot contents frees whatever chains were retired into it.
+    auto& chains = diffusionMailbox.GetWriteSlot();
 
-    if (diffusionRight != nullptr)
-    {
-        auto decorrelatedTunings = DecorrelateTunings(Tunings);
+    chains.Left = std::make_unique<DiffusionChain>();
+    chains.Right = std::make_unique<DiffusionChain>();
 
-        diffusionRight->Configure(diffusionQualityStages,
-            diffusionSize, 0.005f, 0.5f, decorrelatedTunings);
-    }
+    chains.Left->Prepare(chainSampleRate);
+    chains.Right->Prepare(chainSampleRate);
+
+    chains.Left->SetRandomSeed(RandomStream::DeriveSeed(seed, 0));
+    chains.Right->SetRandomSeed(RandomStream::DeriveSeed(seed, 1));
+
+    chains.Left->Configure(qualityStages,
+        size, 0.005f, 0.5f, *tunings);
+
+    chains.Right->Configure(qualityStages,
+        size, 0.005f, 0.5f, *decorrelatedTunings);
+
+    diffusionMailbox.Publish();
+}
+
+void Reverb::swapInDiffusionChains()
+{
+    if (!diffusionMailbox.Pull())
+        return;
+
+    auto& chains = diffusionMailbox.GetReadSlot();
+
+    std::swap(diffusionLeft, chains.Left);
+    std::swap(diffusionRight, chains.Right);
 }
 
 void Reverb::updateFeedbackGainFromFeedbackTime()
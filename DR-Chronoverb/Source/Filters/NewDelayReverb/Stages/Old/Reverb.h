@@ -1,26 +1,28 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <vector>
 
 #include "../Filters.h"
+#include "../Utils/LatestValueMailbox.h"
 #include "../../DelayTimeSegment.h"
 #include "../../DiffusionChain.h"
 #include "../../DampingFilter.h"
 #include "../../../ChronoverbUtils.h"
+#include "../../../BackgroundWorker.h"
+#include "../../../RandomStream.h"
+#include "../../../SharedTables.h"
 
 // Multi-channel, handles all reverb feedback, diffusion, damping, etc.
 class Reverb
 {
 public:
-    std::vector<float> Tunings =
-    {
-        29.0, 37.0, 43.0, 53.0, 71.0, 89.0, 113.0, 149.0
-    };
-
     void PrepareToPlay(double newSampleRate, Filters& filters);
     void ProcessBlock(juce::AudioBuffer<float>& audioBuffer);
 
     std::pair<float, float> ProcessSample(float inputSampleL, float inputSampleR);
+    void Reset();
 
     void SetHostTempo(float bpm);
 
@@ -34,16 +36,39 @@ public:
 
     void SetFiltersOrder(int newOrder);
 
+    // Seeds the diffusion jitter; the chains are rebuilt with it in the background.
+    void SetRandomSeed(uint64_t newSeed);
+
+    // Defer the rebuilds that setters trigger until the end of a batch (state restore),
+    // so each one runs once. Batches may nest.
+    void BeginParameterBatch();
+    void EndParameterBatch();
+
 private:
+    // Built on the background worker and swapped in by ProcessBlock. The chains that
+    // were swapped out go back through the mailbox and are freed on the worker.
+    struct DiffusionChains
+    {
+        std::unique_ptr<DiffusionChain> Left;
+        std::unique_ptr<DiffusionChain> Right;
+    };
+
+    void acquireTunings();
     void rebuildDiffusionIfNeeded();
+    void swapInDiffusionChains();
     void updateFeedbackGainFromFeedbackTime();
 
     // Settings
+    static constexpr std::array<float, 8> BaseTunings =
+    {
+        29.0f, 37.0f, 43.0f, 53.0f, 71.0f, 89.0f, 113.0f, 149.0f
+    };
+
     const float tuningLengthMultiplier = 2.0f;
     const float irLengthMs = 1600.0f;
 
-    // Runtime
-    double sampleRate = 48000.0;
+    // Runtime (the sample rate is read by the background rebuild)
+    std::atomic<double> sampleRate { 48000.0 };
     float hostBPM = 120.0f;
 
     float lastFeedbackL = 0.0f;
@@ -53,6 +78,7 @@ private:
 
     int lastBuiltQualityStages = -1;
     float lastBuiltSize = -1.0f;
+    uint64_t lastBuiltRandomSeed = 0;
 
     float smoothedCenteredReadDelayMilliseconds = 1.0f;
     float readDelaySlewCoefficient = 0.0f;
@@ -61,8 +87,9 @@ private:
     float feedbackTimeSeconds = 3.0f;
 
     float diffusionAmount = 0.0f;
-    float diffusionSize = 0.0f;
-    int diffusionQualityStages = 8;
+    std::atomic<float> diffusionSize { 0.0f };
+    std::atomic<int> diffusionQualityStages { 8 };
+    std::atomic<uint64_t> randomSeed { RandomStream::DefaultSeed };
 
     int filtersOrder = 0;
 
@@ -77,5 +104,10 @@ private:
 
     Filters* filtersInput = nullptr;
 
-    std::atomic<bool> diffusionRebuildPending { false };
+    // Shared with every other Reverb in the process
+    SharedTables::TablePtr tunings;
+    SharedTables::TablePtr decorrelatedTunings;
+
+    LatestValueMailbox<DiffusionChains> diffusionMailbox;
+    BackgroundJob diffusionJob { [this] { rebuildDiffusionIfNeeded(); } };
 };
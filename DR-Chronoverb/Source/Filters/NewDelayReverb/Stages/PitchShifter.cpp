@@ -1,12 +1,17 @@
 #include "PitchShifter.h"
 
+#include <tuple>
+
 PitchShifter::PitchShifter()
 {
     reverb = std::make_unique<Reverb>();
 }
 
-void PitchShifter::PrepareToPlay(double newSampleRate, Filters& filters)
+void PitchShifter::PrepareToPlay(double newSampleRate, Filters& filters, SmoothingBank& smoothingBank)
 {
+    sequenceJob.Suspend();
+    backendJob.Suspend();
+
     sampleRate = newSampleRate;
     filtersInput = &filters;
 
@@ -15,8 +20,8 @@ void PitchShifter::PrepareToPlay(double newSampleRate, Filters& filters)
     delayTimeSegment.UpdateDelayMilliseconds();
 
     // Delay line
-    delayLineLeft = std::make_unique<DelayLine>(delayTimeSegment.MaxDelaySamples);
-    delayLineRight = std::make_unique<DelayLine>(delayTimeSegment.MaxDelaySamples);
+    delayLineLeft.Resize(delayTimeSegment.MaxDelaySamples);
+    delayLineRight.Resize(delayTimeSegment.MaxDelaySamples);
 
     // Pitch shifter
     echoWriteCounter = 0;
@@ -24,72 +29,108 @@ void PitchShifter::PrepareToPlay(double newSampleRate, Filters& filters)
     pitchShifterLeft.Prepare(sampleRate);
     pitchShifterRight.Prepare(sampleRate);
 
+    backendJob.RunNow();
+    stagePitchBackends(false);
+
     pitchShifterLeft.SetEnabled(true);
     pitchShifterRight.SetEnabled(true);
 
-    rebuildPitchSequences();
+    sequenceJob.RunNow();
+    stagePitchSequences();
     pitchShifterLeft.CommitPendingSequenceNow();
     pitchShifterRight.CommitPendingSequenceNow();
 
     // Reverb line
     reverb->PrepareToPlay(sampleRate, *filtersInput);
 
+    reverbBypass.Prepare(sampleRate);
+    reverbBypass.Reset(diffusionAmount > 0.0001f);
+    isDormant = false;
+
     // Various
-    smoothedCenteredReadDelayMilliseconds = delayTimeSegment.DelayTimeMilliseconds;
     readDelaySlewCoefficient = delayTimeSegment.ReadDelaySlewCoefficient;
+
+    readDelaySmoother = smoothingBank.Register(SmoothingBank::RampType::Exponential,
+        delayTimeSegment.DelayTimeMilliseconds);
+    readDelaySmoother.SetCoefficient(readDelaySlewCoefficient);
+
     writePeriodSamples = delayTimeSegment.WritePeriodSamples;
 }
 
 void PitchShifter::ProcessBlock(juce::AudioBuffer<float>& audioBuffer)
 {
-    if (pitchSequenceRebuildPending.exchange(false, std::memory_order_acq_rel))
-        rebuildPitchSequences();
+    stagePitchSequences();
+
+    // Nothing to fade while dormant: waking resets the backends anyway.
+    stagePitchBackends(!isDormant);
 
     reverb->ProcessBlock(audioBuffer);
 
+    // Clear the reverb tail that was left behind when it was bypassed.
+    const bool reverbAudible = diffusionAmount > 0.0001f;
+
+    if (reverbAudible && reverbBypass.IsBypassed())
+        reverb->Reset();
+
+    reverbBypass.SetAudible(reverbAudible);
+
     pitchShifterLatencyMs = pitchShifterLeft.GetLatencyMilliseconds();
+    outgoingPitchShifterLatencyMs = pitchShifterLeft.GetOutgoingLatencyMilliseconds();
 
     readDelaySlewCoefficient = delayTimeSegment.ReadDelaySlewCoefficient;
     writePeriodSamples = delayTimeSegment.WritePeriodSamples;
+
+    readDelaySmoother.SetCoefficient(readDelaySlewCoefficient);
+    readDelaySmoother.SetTarget(delayTimeSegment.DelayTimeMilliseconds);
 }
 
 std::pair<float, float> PitchShifter::ProcessSample(float inputSampleL, float inputSampleR)
 {
-    if (pitchWetMix <= 0.0001f)
-        return std::make_pair(inputSampleL, inputSampleR);
+    if (isDormant)
+        wakeFromBypass();
 
-    delayLineLeft->PushSample(inputSampleL);
-    delayLineRight->PushSample(inputSampleR);
+    delayLineLeft.PushSample(inputSampleL);
+    delayLineRight.PushSample(inputSampleR);
 
     // 1) Pre-read latency compensation.
-    smoothedCenteredReadDelayMilliseconds += readDelaySlewCoefficient *
-            (delayTimeSegment.DelayTimeMilliseconds - smoothedCenteredReadDelayMilliseconds);
-
-    const float nominalReadMilliseconds = smoothedCenteredReadDelayMilliseconds;
+    const float nominalReadMilliseconds = readDelaySmoother.GetNextValue();
     const float preReadMs = std::max(1.0f, nominalReadMilliseconds - pitchShifterLatencyMs);
 
-    const float preReadWetLeft = delayLineLeft->ReadFeedbackBuffer(preReadMs);
-    const float preReadWetRight = delayLineRight->ReadFeedbackBuffer(preReadMs);
+    const float preReadWetLeft = delayLineLeft.ReadFeedbackBuffer(preReadMs);
+    const float preReadWetRight = delayLineRight.ReadFeedbackBuffer(preReadMs);
 
-    float pitchedLeft = pitchShifterLeft.ProcessSample(preReadWetLeft);
-    float pitchedRight = pitchShifterRight.ProcessSample(preReadWetRight);
+    float pitchedLeft = 0.0f;
+    float pitchedRight = 0.0f;
 
-    // Advance echo boundary
-    ++echoWriteCounter;
-    if (echoWriteCounter >= writePeriodSamples)
+    if (pitchShifterLeft.IsBackendFading())
     {
-        echoWriteCounter = 0;
-        pitchShifterLeft.OnNewEchoBoundary();
-        pitchShifterRight.OnNewEchoBoundary();
+        // The outgoing backend is read for its own latency, so the two outputs line up.
+        const float outgoingPreReadMs = std::max(1.0f, nominalReadMilliseconds - outgoingPitchShifterLatencyMs);
+
+        pitchedLeft = pitchShifterLeft.ProcessSample(preReadWetLeft, delayLineLeft.ReadFeedbackBuffer(outgoingPreReadMs));
+        pitchedRight = pitchShifterRight.ProcessSample(preReadWetRight, delayLineRight.ReadFeedbackBuffer(outgoingPreReadMs));
     }
+    else
+    {
+        pitchedLeft = pitchShifterLeft.ProcessSample(preReadWetLeft);
+        pitchedRight = pitchShifterRight.ProcessSample(preReadWetRight);
+    }
+
+    advanceEchoBoundary();
 
-    // 2) Diffuse pitch tap through reverb
-    auto [diffPitchedLeft, diffPitchedRight] =
-        reverb->ProcessSample(pitchedLeft, pitchedRight);
+    // 2) Diffuse pitch tap through reverb (skipped once it has faded out)
+    const float reverbGain = reverbBypass.GetNextGain();
+
+    float diffPitchedLeft = 0.0f;
+    float diffPitchedRight = 0.0f;
+
+    if (reverbGain > 0.0f)
+        std::tie(diffPitchedLeft, diffPitchedRight) = reverb->ProcessSample(pitchedLeft, pitchedRight);
 
     const float lowerHalf01 = std::clamp(diffusionAmount * 2.0f, 0.0f, 1.0f);
     const float cleanGain = std::pow(1.0f - lowerHalf01, 3.0f);
-    const float diffusedGain = std::sin(lowerHalf01 * juce::MathConstants<float>::halfPi) * 0.75f;
+    const float diffusedGain =
+        std::sin(lowerHalf01 * juce::MathConstants<float>::halfPi) * 0.75f * reverbGain;
     const float makeupGain =
         1.0f + (0.12f * std::sin(lowerHalf01 * juce::MathConstants<float>::pi));
 
@@ -111,6 +152,22 @@ std::pair<float, float> PitchShifter::ProcessSample(float inputSampleL, float in
     return std::make_pair(outLeft, outRight);
 }
 
+bool PitchShifter::IsAudible() const
+{
+    return pitchWetMix > 0.0001f;
+}
+
+void PitchShifter::KeepWarm(float inputSampleL, float inputSampleR)
+{
+    isDormant = true;
+
+    delayLineLeft.PushSample(inputSampleL);
+    delayLineRight.PushSample(inputSampleR);
+
+    // Keeps the sequence in step with the echoes while bypassed.
+    advanceEchoBoundary();
+}
+
 //region Parameters
 
 void PitchShifter::SetHostTempo(float bpm)
@@ -172,19 +229,19 @@ void PitchShifter::SetFiltersOrder(int newFiltersOrder)
 void PitchShifter::SetPitchRangeLower(float pitchRangeLowerSemitones)
 {
     pitchRangeLower = pitchRangeLowerSemitones;
-    pitchSequenceRebuildPending.store(true, std::memory_order_release);
+    sequenceJob.Request();
 }
 
 void PitchShifter::SetPitchRangeUpper(float pitchRangeUpperSemitones)
 {
     pitchRangeUpper = pitchRangeUpperSemitones;
-    pitchSequenceRebuildPending.store(true, std::memory_order_release);
+    sequenceJob.Request();
 }
 
 void PitchShifter::SetPitchSequence(int sequenceIndex)
 {
     pitchSequence = sequenceIndex;
-    pitchSequenceRebuildPending.store(true, std::memory_order_release);
+    sequenceJob.Request();
 }
 
 void PitchShifter::SetPitchWetMix(float newPitchWetMix)
@@ -192,10 +249,50 @@ void PitchShifter::SetPitchWetMix(float newPitchWetMix)
     pitchWetMix = newPitchWetMix;
 }
 
+void PitchShifter::SetPitchAlgorithm(int newPitchAlgorithm)
+{
+    pitchAlgorithm = std::clamp(newPitchAlgorithm, 0, 1);
+    backendJob.Request();
+}
+
+void PitchShifter::SetPitchGrainCount(int newGrainCount)
+{
+    pitchGrainCount = newGrainCount;
+    backendJob.Request();
+}
+
+void PitchShifter::SetPitchGrainWindow(int newWindowShapeIndex)
+{
+    pitchGrainWindow = std::clamp(newWindowShapeIndex, 0, 3);
+    backendJob.Request();
+}
+
+void PitchShifter::SetRandomSeed(uint64_t newSeed)
+{
+    randomSeed = newSeed;
+    reverb->SetRandomSeed(RandomStream::DeriveSeed(newSeed, ReverbStream));
+    sequenceJob.Request();
+}
+
+void PitchShifter::BeginParameterBatch()
+{
+    sequenceJob.Hold();
+    backendJob.Hold();
+    reverb->BeginParameterBatch();
+}
+
+void PitchShifter::EndParameterBatch()
+{
+    reverb->EndParameterBatch();
+    backendJob.Release();
+    sequenceJob.Release();
+}
+
 //endregion
 
 //region Update Functions
 
+// Background worker (and PrepareToPlay).
 void PitchShifter::rebuildPitchSequences()
 {
     int lowerOctave = semitonesToOctaveIndex(pitchRangeLower);
@@ -204,45 +301,138 @@ void PitchShifter::rebuildPitchSequences()
     if (lowerOctave > upperOctave)
         std::swap(lowerOctave, upperOctave);
 
-    auto configureShifter = [&](OctaveEchoPitchShifter& shifter)
+    const int sequenceIndex = pitchSequence;
+    const uint64_t seed = randomSeed;
+
+    auto buildSequence = [&](uint32_t randomStreamId) -> std::unique_ptr<IPitchSequence>
     {
-        if (pitchSequence == 3) // Up-Down
+        if (sequenceIndex == 3) // Up-Down
         {
             auto pingPongSequence = std::make_unique<PingPongOctaveSequence>();
             pingPongSequence->SetRange(lowerOctave, upperOctave);
             pingPongSequence->SetStartOctave(lowerOctave);
             pingPongSequence->SetInitialDirection(1);
-            shifter.SetSequence(std::move(pingPongSequence));
+            return pingPongSequence;
         }
-        else if (pitchSequence == 2) // Random
+
+        if (sequenceIndex == 2) // Random
         {
             // TODO: Random isn't synced between L/R channels
-            auto randomSequence = std::make_unique<RandomOctaveSequence>();
+            auto randomSequence = std::make_unique<RandomOctaveSequence>(RandomStream::DeriveSeed(seed, randomStreamId));
             randomSequence->SetRange(lowerOctave, upperOctave);
-            shifter.SetSequence(std::move(randomSequence));
+            return randomSequence;
+        }
+
+        auto progressiveSequence = std::make_unique<ProgressiveOctaveSequence>();
+        progressiveSequence->SetRange(lowerOctave, upperOctave);
+
+        if (sequenceIndex == 0) // Up
+        {
+            progressiveSequence->SetStartOctave(lowerOctave);
+            progressiveSequence->SetStepOctaves(1);
         }
-        else
+        else // Down
         {
-            auto progressiveSequence = std::make_unique<ProgressiveOctaveSequence>();
-            progressiveSequence->SetRange(lowerOctave, upperOctave);
-
-            if (pitchSequence == 0) // Up
-            {
-                progressiveSequence->SetStartOctave(lowerOctave);
-                progressiveSequence->SetStepOctaves(1);
-            }
-            else // Down
-            {
-                progressiveSequence->SetStartOctave(upperOctave);
-                progressiveSequence->SetStepOctaves(-1);
-            }
-
-            shifter.SetSequence(std::move(progressiveSequence));
+            progressiveSequence->SetStartOctave(upperOctave);
+            progressiveSequence->SetStepOctaves(-1);
         }
+
+        return progressiveSequence;
     };
 
-    configureShifter(pitchShifterLeft);
-    configureShifter(pitchShifterRight);
+    // Replacing the slot contents frees whatever was sent back into it.
+    auto& sequences = sequenceMailbox.GetWriteSlot();
+
+    sequences.Left = buildSequence(SequenceLeftStream);
+    sequences.Right = buildSequence(SequenceRightStream);
+
+    sequenceMailbox.Publish();
+}
+
+void PitchShifter::stagePitchSequences()
+{
+    if (!sequenceMailbox.Pull())
+        return;
+
+    auto& sequences = sequenceMailbox.GetReadSlot();
+
+    sequences.Left = pitchShifterLeft.ExchangePendingSequence(std::move(sequences.Left));
+    sequences.Right = pitchShifterRight.ExchangePendingSequence(std::move(sequences.Right));
+}
+
+void PitchShifter::advanceEchoBoundary()
+{
+    ++echoWriteCounter;
+
+    if (echoWriteCounter >= writePeriodSamples)
+    {
+        echoWriteCounter = 0;
+        pitchShifterLeft.OnNewEchoBoundary();
+        pitchShifterRight.OnNewEchoBoundary();
+    }
+}
+
+// The grain buffers stopped being fed while bypassed, so drop what's left in them.
+void PitchShifter::wakeFromBypass()
+{
+    isDormant = false;
+
+    pitchShifterLeft.ResetBackendToCurrentRatio();
+    pitchShifterRight.ResetBackendToCurrentRatio();
+
+    readDelaySmoother.SetCurrentAndTarget(delayTimeSegment.DelayTimeMilliseconds);
+}
+
+// Background worker (and PrepareToPlay). Only rebuilds when a backend setting or the
+// sample rate changed; at the same rate PrepareToPlay re-prepares the current backends in place.
+void PitchShifter::rebuildPitchBackends()
+{
+    const int algorithm = pitchAlgorithm;
+    const int grainCount = pitchGrainCount;
+    const int grainWindow = pitchGrainWindow;
+    const double backendSampleRate = sampleRate;
+
+    if (algorithm == lastBuiltPitchAlgorithm
+        && grainCount == lastBuiltGrainCount
+        && grainWindow == lastBuiltGrainWindow
+        && backendSampleRate == lastBuiltBackendSampleRate)
+    {
+        return;
+    }
+
+    lastBuiltPitchAlgorithm = algorithm;
+    lastBuiltGrainCount = grainCount;
+    lastBuiltGrainWindow = grainWindow;
+    lastBuiltBackendSampleRate = backendSampleRate;
+
+    OctaveEchoPitchShifter::BackendSettings settings;
+    settings.Type = (algorithm == 1) ? OctaveEchoPitchShifter::BackendType::PhaseVocoder
+                                     : OctaveEchoPitchShifter::BackendType::Granular;
+    settings.GrainCount = grainCount;
+    settings.WindowShape = static_cast<GranularPitchBackend::WindowShape>(grainWindow);
+
+    // Replacing the slot contents frees the backends that were retired into it.
+    auto& backends = backendMailbox.GetWriteSlot();
+
+    backends.Left = OctaveEchoPitchShifter::CreateBackend(settings, backendSampleRate);
+    backends.Right = OctaveEchoPitchShifter::CreateBackend(settings, backendSampleRate);
+
+    backendMailbox.Publish();
+}
+
+// A backend that arrives during a crossfade waits in the mailbox until the fade is done.
+void PitchShifter::stagePitchBackends(bool crossfade)
+{
+    if (pitchShifterLeft.IsBackendFading() || pitchShifterRight.IsBackendFading())
+        return;
+
+    if (!backendMailbox.Pull())
+        return;
+
+    auto& backends = backendMailbox.GetReadSlot();
+
+    backends.Left = pitchShifterLeft.ExchangeBackend(std::move(backends.Left), crossfade);
+    backends.Right = pitchShifterRight.ExchangeBackend(std::move(backends.Right), crossfade);
 }
 
 //endregion
\ No newline at end of file
@@ -2,11 +2,16 @@
 
 #include "Old/Delay.h"
 #include "Old/Reverb.h"
+#include "Utils/StageBypass.h"
+#include "Utils/LatestValueMailbox.h"
 
 #include "../PitchShiftingEngine.h"
 #include "../DelayTimeSegment.h"
 #include "../DelayLine.h"
+#include "../SmoothingBank.h"
 #include "../../../Utils/PMath.h"
+#include "../../BackgroundWorker.h"
+#include "../../RandomStream.h"
 
 // TODO: Research potential envelope (AR) each echo window
 
@@ -18,11 +23,16 @@ class PitchShifter
 public:
     PitchShifter();
 
-    void PrepareToPlay(double newSampleRate, Filters& filters);
+    void PrepareToPlay(double newSampleRate, Filters& filters, SmoothingBank& smoothingBank);
     void ProcessBlock(juce::AudioBuffer<float>& audioBuffer);
 
     std::pair<float, float> ProcessSample(float inputSampleL, float inputSampleR);
 
+    // Silent while the pitch wet mix is off. The engine then calls KeepWarm instead of
+    // ProcessSample, which keeps the delay lines and echo boundaries running.
+    bool IsAudible() const;
+    void KeepWarm(float inputSampleL, float inputSampleR);
+
     void SetHostTempo(float bpm);
 
     void SetDelayTime(float newDelayTime);
@@ -38,12 +48,43 @@ public:
     void SetPitchRangeUpper(float pitchRangeUpperSemitones);
     void SetPitchSequence(int sequenceIndex);
     void SetPitchWetMix(float newPitchWetMix);
+    void SetPitchAlgorithm(int newPitchAlgorithm);
+    void SetPitchGrainCount(int newGrainCount);           // 2, 4 or 8
+    void SetPitchGrainWindow(int newWindowShapeIndex);    // GranularPitchBackend::WindowShape
+
+    // Seeds the random octave sequences and the pitch reverb's diffusion jitter.
+    void SetRandomSeed(uint64_t newSeed);
+
+    // Defer the rebuilds that setters trigger until the end of a batch (state restore),
+    // so each one runs once. Batches may nest.
+    void BeginParameterBatch();
+    void EndParameterBatch();
 
 private:
-    void rebuildPitchSequences();
+    // Built on the background worker. ProcessBlock stages them and sends back whatever
+    // they displaced, which the worker frees when it reuses the slot.
+    struct PitchSequences
+    {
+        std::unique_ptr<IPitchSequence> Left;
+        std::unique_ptr<IPitchSequence> Right;
+    };
+
+    // Same for the pitch backends, which allocate and plan FFTs when the algorithm changes.
+    struct PitchBackends
+    {
+        std::unique_ptr<IPitchShifterBackend> Left;
+        std::unique_ptr<IPitchShifterBackend> Right;
+    };
 
-    // Runtime
-    double sampleRate = 48000.0;
+    void rebuildPitchSequences();
+    void stagePitchSequences();
+    void rebuildPitchBackends();
+    void stagePitchBackends(bool crossfade);
+    void advanceEchoBoundary();
+    void wakeFromBypass();
+
+    // Runtime (the sample rate is read by the background backend rebuild)
+    std::atomic<double> sampleRate { 48000.0 };
     float hostBPM = 120.0f;
 
     float maxDelayMS = 0.0f;
@@ -55,18 +96,21 @@ private:
     int lastBuiltQualityStages = -1;
     float lastBuiltSize01 = -1.0f;
 
-    float smoothedCenteredReadDelayMilliseconds = 1.0f;
+    SmoothingBank::Smoother readDelaySmoother;
     float readDelaySlewCoefficient = 0.0f;
 
     int writePeriodSamples = 1;
     int echoWriteCounter = 0;
 
+    bool isDormant = false;
+
     // Settings
     const float MinimumBPM = 20.0f;
 
     // Latency
     float cachedPitchCompensationMs = 0.0f;
     float pitchShifterLatencyMs = 0.0f;
+    float outgoingPitchShifterLatencyMs = 0.0f;
 
     // Parameters
     float delayTimeMs = 0.3f;
@@ -80,11 +124,24 @@ private:
     int diffusionQualityStages = 8;
     int filtersOrder = 0;
 
-    float pitchRangeLower = -12.0f;
-    float pitchRangeUpper = 12.0f;
-    int pitchSequence = 0;
+    std::atomic<float> pitchRangeLower { -12.0f };
+    std::atomic<float> pitchRangeUpper { 12.0f };
+    std::atomic<int> pitchSequence { 0 };
     float pitchStereoEnabled = 0.0f;
     float pitchWetMix = 0.0f;
+    std::atomic<int> pitchAlgorithm { 0 }; // 0 = granular, 1 = phase vocoder
+    std::atomic<int> pitchGrainCount { 4 };
+    std::atomic<int> pitchGrainWindow { 0 };
+
+    // Streams derived from randomSeed
+    enum RandomStreamIds : uint32_t
+    {
+        SequenceLeftStream,
+        SequenceRightStream,
+        ReverbStream
+    };
+
+    std::atomic<uint64_t> randomSeed { RandomStream::DefaultSeed };
 
     // Data
     OctaveEchoPitchShifter pitchShifterLeft;
@@ -92,12 +149,23 @@ private:
 
     DelayTimeSegment delayTimeSegment;
 
-    std::unique_ptr<DelayLine> delayLineLeft;
-    std::unique_ptr<DelayLine> delayLineRight;
+    DelayLine delayLineLeft = DelayLine(0);
+    DelayLine delayLineRight = DelayLine(0);
 
     std::unique_ptr<Reverb> reverb;
+    StageBypass reverbBypass; // Reverb is muted at diffusion amount 0
 
     Filters* filtersInput = nullptr;
 
-    std::atomic<bool> pitchSequenceRebuildPending { false };
+    // Background worker only
+    int lastBuiltPitchAlgorithm = -1;
+    int lastBuiltGrainCount = -1;
+    int lastBuiltGrainWindow = -1;
+    double lastBuiltBackendSampleRate = 0.0;
+
+    LatestValueMailbox<PitchSequences> sequenceMailbox;
+    LatestValueMailbox<PitchBackends> backendMailbox;
+
+    BackgroundJob sequenceJob { [this] { rebuildPitchSequences(); } };
+    BackgroundJob backendJob { [this] { rebuildPitchBackends(); } };
 };
@@ -11,7 +11,7 @@ void Stereo::PrepareToPlay(double newSampleRate)
     delayTimeSegment.PrepareToPlay(sampleRate);
     delayTimeSegment.UpdateDelayMilliseconds();
 
-    delayLine = std::make_unique<DelayLine>(delayTimeSegment.MaxDelaySamples);
+    delayLine.Resize(delayTimeSegment.MaxDelaySamples);
 }
 
 std::pair<float, float> Stereo::ProcessSample(float inputL, float inputR)
@@ -36,18 +36,28 @@ std::pair<float, float> Stereo::ProcessSample(float inputL, float inputR)
             1.0f, 0.0f, 12.0f);
 
         // Only delay the right channel
-        const float mid = 0.5f * (inputL + inputR);
-        const float delayedMid = delayLine->ReadFeedbackBuffer(haasDelayMs);
-
-        delayLine->PushSample(mid);
+        const float delayedMid = delayLine.ReadFeedbackBuffer(haasDelayMs);
 
         spreadLeft = inputL;
         spreadRight = inputR * (1.0f - widen) + delayedMid * widen;
     }
 
+    // Always written, so widening never starts on stale audio.
+    delayLine.PushSample(0.5f * (inputL + inputR));
+
     return std::make_pair(spreadLeft, spreadRight);
 }
 
+bool Stereo::IsAudible() const
+{
+    return std::abs(stereoSpread) > 0.0001f;
+}
+
+void Stereo::KeepWarm(float inputL, float inputR)
+{
+    delayLine.PushSample(0.5f * (inputL + inputR));
+}
+
 void Stereo::SetHostTempo(float newHostTempo)
 {
     hostBpm = newHostTempo;
@@ -13,6 +13,10 @@ public:
 
     std::pair<float, float> ProcessSample(float inputL, float inputR);
 
+    // Silent at spread 0; KeepWarm only feeds the haas delay while bypassed.
+    bool IsAudible() const;
+    void KeepWarm(float inputL, float inputR);
+
     void SetHostTempo(float newHostTempo);
 
     void SetDelayTime(float newDelayTime);
@@ -28,5 +32,5 @@ private:
     float diffusionAmount = 0.0f;
 
     DelayTimeSegment delayTimeSegment; // Used for ping-pong
-    std::unique_ptr<DelayLine> delayLine;
+    DelayLine delayLine = DelayLine(0);
 };
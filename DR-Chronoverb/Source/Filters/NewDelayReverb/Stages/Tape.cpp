@@ -0,0 +1,152 @@
+#include "Tape.h"
+
+void Tape::PrepareToPlay(double newSampleRate, SmoothingBank& smoothingBank)
+{
+    sampleRate = std::max(1.0, newSampleRate);
+
+    const int delaySamples = static_cast<int>(std::ceil((BaseDelayMilliseconds + MaxWobbleMilliseconds)
+        * 0.001 * sampleRate)) + 4;
+
+    delayLineLeft.Resize(delaySamples);
+    delayLineRight.Resize(delaySamples);
+
+    delayLineLeft.SetSampleRate(sampleRate);
+    delayLineRight.SetSampleRate(sampleRate);
+
+    wobbleLfo.Prepare(sampleRate);
+    wobbleLfo.SetRateHz(wobbleRateHz);
+
+    depthSlewCoefficient = 1.0f / (0.02f * static_cast<float>(sampleRate)); // ~20 ms
+
+    depthSmoother = smoothingBank.Register(SmoothingBank::RampType::Exponential, wobbleDepth);
+    depthSmoother.SetCoefficient(depthSlewCoefficient);
+
+    noiseFilterCoefficient = 1.0f - std::exp(-juce::MathConstants<float>::twoPi * NoiseCutoffHz
+        / static_cast<float>(sampleRate));
+
+    Reset();
+}
+
+void Tape::ProcessBlock(juce::AudioBuffer<float>& audioBuffer)
+{
+    // Always rendered so the scope keeps moving, whether or not the tape is heard.
+    wobbleLfo.SetRateHz(wobbleRateHz);
+    wobbleLfo.GenerateBlock(audioBuffer.getNumSamples());
+
+    depthSmoother.SetTarget(wobbleDepth);
+
+    // A seed set since the last block (e.g. restored with a session) restarts the hiss here.
+    if (reseedPending.exchange(false, std::memory_order_acquire))
+        noiseRandom.SetSeed(randomSeed.load(std::memory_order_relaxed));
+
+    if (noiseEnabled)
+    {
+        const int numNoiseSamples = std::min(audioBuffer.getNumSamples(), NoiseBlockSize);
+
+        noiseRandom.FillBipolar(noiseBlockLeft.data(), numNoiseSamples);
+        noiseRandom.FillBipolar(noiseBlockRight.data(), numNoiseSamples);
+    }
+
+    noiseReadIndex = 0;
+}
+
+void Tape::Reset()
+{
+    delayLineLeft.Clear();
+    delayLineRight.Clear();
+
+    wobbleLfo.Reset();
+
+    depthSmoother.SetCurrentAndTarget(wobbleDepth);
+
+    noiseStateL = 0.0f;
+    noiseStateR = 0.0f;
+
+    reseedPending.store(false, std::memory_order_relaxed);
+    noiseRandom.SetSeed(randomSeed.load(std::memory_order_relaxed));
+    noiseReadIndex = 0;
+}
+
+std::pair<float, float> Tape::ProcessSample(float inputL, float inputR)
+{
+    // 1) Wow/flutter
+    const float wobble = wobbleLfo.GetNextValue();
+    const float readMilliseconds = BaseDelayMilliseconds + (wobble * depthSmoother.GetNextValue() * MaxWobbleMilliseconds);
+
+    delayLineLeft.PushSample(inputL);
+    delayLineRight.PushSample(inputR);
+
+    float tapeL = delayLineLeft.ReadFeedbackBuffer(readMilliseconds);
+    float tapeR = delayLineRight.ReadFeedbackBuffer(readMilliseconds);
+
+    // 2) Saturation, unity small-signal gain so it only rounds off peaks
+    if (saturation > 0.0001f)
+    {
+        const float drive = 1.0f + (saturation * 4.0f);
+
+        tapeL += saturation * ((std::tanh(tapeL * drive) / drive) - tapeL);
+        tapeR += saturation * ((std::tanh(tapeR * drive) / drive) - tapeR);
+    }
+
+    // 3) Hiss
+    if (noiseEnabled)
+    {
+        const size_t noiseIndex = static_cast<size_t>(noiseReadIndex++ & (NoiseBlockSize - 1));
+
+        noiseStateL += noiseFilterCoefficient * (noiseBlockLeft[noiseIndex] - noiseStateL);
+        noiseStateR += noiseFilterCoefficient * (noiseBlockRight[noiseIndex] - noiseStateR);
+
+        tapeL += noiseStateL * NoiseGain;
+        tapeR += noiseStateR * NoiseGain;
+    }
+
+    return { tapeL, tapeR };
+}
+
+bool Tape::IsAudible() const
+{
+    return enabled && (wobbleDepth > 0.0001f || saturation > 0.0001f || noiseEnabled);
+}
+
+void Tape::KeepWarm(float inputL, float inputR)
+{
+    wobbleLfo.GetNextValue();
+
+    delayLineLeft.PushSample(inputL);
+    delayLineRight.PushSample(inputR);
+}
+
+//region Parameters
+
+void Tape::SetEnabled(bool newEnabled)
+{
+    enabled = newEnabled;
+}
+
+void Tape::SetWobbleRate(float newRateHz)
+{
+    wobbleRateHz = std::clamp(newRateHz, 0.05f, 15.0f);
+}
+
+void Tape::SetWobbleDepth(float newDepth01)
+{
+    wobbleDepth = std::clamp(newDepth01, 0.0f, 1.0f);
+}
+
+void Tape::SetSaturation(float newSaturation01)
+{
+    saturation = std::clamp(newSaturation01, 0.0f, 1.0f);
+}
+
+void Tape::SetNoiseEnabled(bool newNoiseEnabled)
+{
+    noiseEnabled = newNoiseEnabled;
+}
+
+void Tape::SetRandomSeed(uint64_t newSeed)
+{
+    randomSeed.store(newSeed, std::memory_order_relaxed);
+    reseedPending.store(true, std::memory_order_release);
+}
+
+//endregion
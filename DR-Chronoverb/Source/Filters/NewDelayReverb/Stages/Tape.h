@@ -0,0 +1,83 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "../DelayLine.h"
+#include "../SmoothingBank.h"
+#include "Tape/TapeWobbleLfo.h"
+#include "../../RandomStream.h"
+
+// Tape simulation on the wet path: wow/flutter as a modulated delay (fractional
+// DelayLine reads driven by TapeWobbleLfo), soft saturation and optional hiss.
+class Tape
+{
+public:
+    void PrepareToPlay(double newSampleRate, SmoothingBank& smoothingBank);
+    void ProcessBlock(juce::AudioBuffer<float>& audioBuffer);
+    void Reset();
+
+    std::pair<float, float> ProcessSample(float inputL, float inputR);
+
+    // Silent when disabled or every section is at zero. KeepWarm keeps the tape
+    // delay written and the LFO cursor moving, so the scope stays in step.
+    bool IsAudible() const;
+    void KeepWarm(float inputL, float inputR);
+
+    void SetEnabled(bool newEnabled);
+    void SetWobbleRate(float newRateHz);
+    void SetWobbleDepth(float newDepth01);
+    void SetSaturation(float newSaturation01);
+    void SetNoiseEnabled(bool newNoiseEnabled);
+
+    // Seeds the hiss. Any thread; the audio thread picks it up at the start of its next block.
+    void SetRandomSeed(uint64_t newSeed);
+
+    // For the tape page's TapeWobbleScope, which reads the LFO ring from the message thread.
+    const TapeWobbleLfo& GetWobbleLfo() const { return wobbleLfo; }
+
+private:
+    // Peak delay swing at full depth, the tape delay sits just above it.
+    static constexpr float MaxWobbleMilliseconds = 4.0f;
+    static constexpr float BaseDelayMilliseconds = MaxWobbleMilliseconds + 0.5f;
+
+    static constexpr float NoiseGain = 0.0005f; // ~ -66 dBFS
+    static constexpr float NoiseCutoffHz = 6000.0f;
+
+    // Hiss is drawn a block at a time in ProcessBlock. Power of two, above any block size.
+    static constexpr int NoiseBlockSize = 8192;
+
+    double sampleRate = 48000.0;
+
+    bool enabled = false;
+    float wobbleRateHz = 1.0f;
+    float wobbleDepth = 0.3f;
+    float saturation = 0.0f;
+    bool noiseEnabled = false;
+
+    SmoothingBank::Smoother depthSmoother;
+    float depthSlewCoefficient = 0.0f;
+
+    float noiseFilterCoefficient = 0.0f;
+    float noiseStateL = 0.0f;
+    float noiseStateR = 0.0f;
+
+    std::atomic<uint64_t> randomSeed { RandomStream::DefaultSeed };
+    std::atomic<bool> reseedPending { false };
+    RandomStream noiseRandom;
+
+    std::array<float, NoiseBlockSize> noiseBlockLeft {};
+    std::array<float, NoiseBlockSize> noiseBlockRight {};
+    int noiseReadIndex = 0;
+
+    TapeWobbleLfo wobbleLfo;
+
+    DelayLine delayLineLeft = DelayLine(0);
+    DelayLine delayLineRight = DelayLine(0);
+};
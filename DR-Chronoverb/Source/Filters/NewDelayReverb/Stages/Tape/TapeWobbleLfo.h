@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// Wow + flutter LFO for the tape stage, rendered ahead of time into a ring buffer.
+// The generator runs LookaheadMilliseconds ahead of the audio read cursor, so the
+// same ring serves the audio path (at "now") and the scope (lookback + lookahead)
+// without the audio thread doing anything extra for the display.
+//
+// The ring is allocated once, at the size MaxSampleRate needs, so the scope can keep
+// reading it while the audio side re-prepares. Above MaxSampleRate the LFO still runs at
+// its set rate; only the lookback and lookahead windows get shorter.
+//
+// Values are unit depth (-1..1); depth is applied by the reader. A rate change
+// takes effect at the generator, i.e. it is heard LookaheadMilliseconds later.
+class TapeWobbleLfo
+{
+public:
+    static constexpr float LookaheadMilliseconds = 250.0f;
+    static constexpr float LookbackMilliseconds = 1000.0f;
+    static constexpr double MaxSampleRate = 384000.0;
+
+    TapeWobbleLfo()
+        : ring(std::make_unique<std::atomic<float>[]>(static_cast<size_t>(RingSize)))
+    {
+        for (int i = 0; i < RingSize; ++i)
+            ring[static_cast<size_t>(i)].store(0.0f, std::memory_order_relaxed);
+    }
+
+    void Prepare(double newSampleRate)
+    {
+        // The phase increments use the real rate; the windows are capped at what the ring holds.
+        sampleRate = newSampleRate;
+        const double windowSampleRate = std::min(newSampleRate, MaxSampleRate);
+
+        lookaheadSamples.store(static_cast<int>(std::ceil(LookaheadMilliseconds * 0.001 * windowSampleRate)), std::memory_order_relaxed);
+        lookbackSamples.store(static_cast<int>(std::ceil(LookbackMilliseconds * 0.001 * windowSampleRate)), std::memory_order_relaxed);
+        publishedSampleRate.store(sampleRate, std::memory_order_relaxed);
+
+        Reset();
+    }
+
+    void Reset()
+    {
+        for (int i = 0; i < RingSize; ++i)
+            ring[static_cast<size_t>(i)].store(0.0f, std::memory_order_relaxed);
+
+        wowPhase = 0.0f;
+        flutterPhase = 0.0f;
+
+        readPosition = 0;
+        generatedPosition = 0;
+
+        generateUpTo(static_cast<int64_t>(lookaheadSamples.load(std::memory_order_relaxed)));
+        publishedNowPosition.store(0, std::memory_order_release);
+    }
+
+    void SetRateHz(float newRateHz)
+    {
+        rateHz = std::clamp(newRateHz, 0.05f, 15.0f);
+    }
+
+    // Audio thread, once per block: keeps the lookahead full for the next block.
+    void GenerateBlock(int numSamples)
+    {
+        generateUpTo(readPosition + static_cast<int64_t>(numSamples) + lookaheadSamples.load(std::memory_order_relaxed));
+        publishedNowPosition.store(readPosition, std::memory_order_release);
+    }
+
+    // Audio thread, once per sample.
+    float GetNextValue()
+    {
+        const float value = ring[static_cast<size_t>(readPosition & RingMask)].load(std::memory_order_relaxed);
+        ++readPosition;
+
+        return value;
+    }
+
+    //region Scope access (any thread)
+    int64_t GetNowPosition() const
+    {
+        return publishedNowPosition.load(std::memory_order_acquire);
+    }
+
+    // Valid for positions in [now - lookback, now + lookahead].
+    float GetValueAt(int64_t position) const
+    {
+        return ring[static_cast<size_t>(position & RingMask)].load(std::memory_order_relaxed);
+    }
+
+    int GetLookaheadSamples() const { return lookaheadSamples.load(std::memory_order_relaxed); }
+    int GetLookbackSamples() const { return lookbackSamples.load(std::memory_order_relaxed); }
+    double GetSampleRate() const { return publishedSampleRate.load(std::memory_order_relaxed); }
+    //endregion
+
+private:
+    // Lookback + lookahead at MaxSampleRate, plus room for one large block being written.
+    static constexpr int RingSize = 524288;
+    static constexpr int64_t RingMask = RingSize - 1;
+
+    static_assert(RingSize >= (LookbackMilliseconds + LookaheadMilliseconds) * 0.001 * MaxSampleRate + 8192);
+
+    void generateUpTo(int64_t endPosition)
+    {
+        // Flutter sits at a non-integer multiple of wow, kept inside the 4-15 Hz band.
+        const float flutterRateHz = std::clamp(rateHz * 5.7f, 4.0f, 15.0f);
+
+        const float wowIncrement = juce::MathConstants<float>::twoPi * rateHz / static_cast<float>(sampleRate);
+        const float flutterIncrement = juce::MathConstants<float>::twoPi * flutterRateHz / static_cast<float>(sampleRate);
+
+        for (; generatedPosition < endPosition; ++generatedPosition)
+        {
+            const float value = (std::sin(wowPhase) * WowWeight) + (std::sin(flutterPhase) * FlutterWeight);
+            ring[static_cast<size_t>(generatedPosition & RingMask)].store(value, std::memory_order_relaxed);
+
+            wowPhase += wowIncrement;
+            if (wowPhase >= juce::MathConstants<float>::twoPi)
+                wowPhase -= juce::MathConstants<float>::twoPi;
+
+            flutterPhase += flutterIncrement;
+            if (flutterPhase >= juce::MathConstants<float>::twoPi)
+                flutterPhase -= juce::MathConstants<float>::twoPi;
+        }
+    }
+
+    static constexpr float WowWeight = 0.8f;
+    static constexpr float FlutterWeight = 0.2f;
+
+    double sampleRate = 48000.0;
+    float rateHz = 1.0f;
+
+    float wowPhase = 0.0f;
+    float flutterPhase = 0.0f;
+
+    // Atomic because the scope reads them too.
+    std::atomic<int> lookaheadSamples { 0 };
+    std::atomic<int> lookbackSamples { 0 };
+    std::atomic<double> publishedSampleRate { 48000.0 };
+
+    const std::unique_ptr<std::atomic<float>[]> ring;
+
+    int64_t readPosition = 0;
+    int64_t generatedPosition = 0;
+
+    std::atomic<int64_t> publishedNowPosition { 0 };
+};
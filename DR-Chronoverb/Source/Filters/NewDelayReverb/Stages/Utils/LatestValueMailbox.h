@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Single-writer / single-reader triple buffer that always hands the reader the most
+// recently published value. Neither side blocks or allocates; values the reader never
+// picked up are simply overwritten.
+//
+// The writer fills GetWriteSlot() and calls Publish(). The reader calls Pull() and, when it
+// returns true, owns GetReadSlot() until its next Pull(). Whatever the reader leaves in that
+// slot (e.g. a retired object) travels back to the writer, which frees it when the slot is
+// reused — a handy way to keep deallocation off the audio thread.
+template <typename ValueType>
+class LatestValueMailbox
+{
+public:
+    ValueType& GetWriteSlot()
+    {
+        return slots[static_cast<size_t>(writeSlot)];
+    }
+
+    void Publish()
+    {
+        writeSlot = sharedSlot.exchange(writeSlot | NewValueFlag, std::memory_order_acq_rel) & SlotMask;
+    }
+
+    // Returns true when a new value was published since the last pull.
+    bool Pull()
+    {
+        if ((sharedSlot.load(std::memory_order_acquire) & NewValueFlag) == 0)
+            return false;
+
+        readSlot = sharedSlot.exchange(readSlot, std::memory_order_acq_rel) & SlotMask;
+        return true;
+    }
+
+    ValueType& GetReadSlot()
+    {
+        return slots[static_cast<size_t>(readSlot)];
+    }
+
+private:
+    static constexpr int SlotMask = 3;
+    static constexpr int NewValueFlag = 4;
+
+    std::array<ValueType, 3> slots {};
+
+    int writeSlot = 0;
+    int readSlot = 1;
+    std::atomic<int> sharedSlot { 2 };
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Decimated waveform stream from the audio thread to a scope.
+//
+// The audio thread folds every ColumnMilliseconds of signal into one min/max column and
+// appends it to a fixed ring; the UI keeps its own read position and picks up whatever
+// columns are new since its last frame. Nothing blocks or allocates. A reader that falls
+// more than Capacity columns behind just skips ahead.
+class ScopeFeed
+{
+public:
+    static constexpr float ColumnMilliseconds = 4.0f;
+    static constexpr int Capacity = 1024;
+
+    struct Column
+    {
+        float Min = 0.0f;
+        float Max = 0.0f;
+    };
+
+    void Prepare(double sampleRate)
+    {
+        samplesPerColumn = std::max(1, static_cast<int>(std::lround(sampleRate * ColumnMilliseconds * 0.001)));
+        resetColumn();
+    }
+
+    // Audio thread.
+    void PushSample(float sample)
+    {
+        columnMin = std::min(columnMin, sample);
+        columnMax = std::max(columnMax, sample);
+
+        if (++columnSampleCount < samplesPerColumn)
+            return;
+
+        const int64_t position = writtenColumns.load(std::memory_order_relaxed);
+        const auto slot = static_cast<size_t>(position & (Capacity - 1));
+
+        minimums[slot].store(columnMin, std::memory_order_relaxed);
+        maximums[slot].store(columnMax, std::memory_order_relaxed);
+        writtenColumns.store(position + 1, std::memory_order_release);
+
+        resetColumn();
+    }
+
+    //region Scope access (any thread)
+    // Total columns written so far; never goes backwards.
+    int64_t GetWrittenColumns() const
+    {
+        return writtenColumns.load(std::memory_order_acquire);
+    }
+
+    // Valid for the last Capacity columns.
+    Column GetColumn(int64_t position) const
+    {
+        const auto slot = static_cast<size_t>(position & (Capacity - 1));
+
+        return { minimums[slot].load(std::memory_order_relaxed),
+                 maximums[slot].load(std::memory_order_relaxed) };
+    }
+    //endregion
+
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    void resetColumn()
+    {
+        columnMin = std::numeric_limits<float>::max();
+        columnMax = std::numeric_limits<float>::lowest();
+        columnSampleCount = 0;
+    }
+
+    int samplesPerColumn = 192;
+
+    float columnMin = 0.0f;
+    float columnMax = 0.0f;
+    int columnSampleCount = 0;
+
+    std::array<std::atomic<float>, Capacity> minimums {};
+    std::array<std::atomic<float>, Capacity> maximums {};
+    std::atomic<int64_t> writtenColumns { 0 };
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+
+// Linear on/off fade for a stage (or a sub-path inside a stage) whose parameters
+// can make it inaudible. The owner publishes an "audible" predicate once per block;
+// while fully faded out the owner skips the processing entirely and only keeps
+// whatever state has to stay warm (e.g. delay writes).
+class StageBypass
+{
+public:
+    void Prepare(double newSampleRate, float fadeMilliseconds = 5.0f)
+    {
+        const float fadeSamples = std::max(1.0f,
+            fadeMilliseconds * 0.001f * static_cast<float>(newSampleRate));
+
+        gainStep = 1.0f / fadeSamples;
+    }
+
+    // Jumps straight to the given state, no fade.
+    void Reset(bool audible)
+    {
+        targetGain = audible ? 1.0f : 0.0f;
+        gain = targetGain;
+    }
+
+    void SetAudible(bool audible)
+    {
+        targetGain = audible ? 1.0f : 0.0f;
+    }
+
+    // Fully faded out and staying there — the path can be skipped.
+    bool IsBypassed() const
+    {
+        return gain <= 0.0f && targetGain <= 0.0f;
+    }
+
+    float GetNextGain()
+    {
+        if (gain < targetGain)
+            gain = std::min(targetGain, gain + gainStep);
+        else if (gain > targetGain)
+            gain = std::max(targetGain, gain - gainStep);
+
+        return gain;
+    }
+
+private:
+    float gain = 1.0f;
+    float targetGain = 1.0f;
+    float gainStep = 1.0f / 240.0f;
+};
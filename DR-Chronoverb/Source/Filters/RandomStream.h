@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+// Per-instance random numbers (xoshiro128**), in place of rand().
+//
+// rand() shares one locked state across every instance in the process, and what each
+// instance draws depends on what all the others drew first. A RandomStream is owned by a
+// single consumer: no locks, no shared state, and the same seed always gives the same
+// sequence, so renders repeat exactly.
+//
+// Owners hand each consumer its own stream seed with DeriveSeed(ownerSeed, streamId). The
+// streams are independent of each other and of the order the consumers are built in.
+class RandomStream
+{
+public:
+    static constexpr uint64_t DefaultSeed = 0x5EEDC0DEu;
+
+    RandomStream() { SetSeed(DefaultSeed); }
+    explicit RandomStream(uint64_t seed) { SetSeed(seed); }
+
+    // Restarts the sequence.
+    void SetSeed(uint64_t seed)
+    {
+        // splitmix64 spreads any seed (including 0) over the whole state.
+        for (auto& word : state)
+        {
+            seed += 0x9E3779B97F4A7C15ull;
+            word = static_cast<uint32_t>(mix(seed) >> 32);
+        }
+
+        if ((state[0] | state[1] | state[2] | state[3]) == 0u)
+            state[0] = 1u;
+    }
+
+    static uint64_t DeriveSeed(uint64_t ownerSeed, uint32_t streamId)
+    {
+        return mix(ownerSeed + (static_cast<uint64_t>(streamId) + 1u) * 0x9E3779B97F4A7C15ull);
+    }
+
+    uint32_t NextUInt32()
+    {
+        const uint32_t result = rotateLeft(state[1] * 5u, 7) * 9u;
+        const uint32_t shifted = state[1] << 9;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotateLeft(state[3], 11);
+
+        return result;
+    }
+
+    // [0, 1)
+    float NextFloat01()
+    {
+        return static_cast<float>(NextUInt32() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // [-1, 1)
+    float NextBipolar()
+    {
+        return static_cast<float>(NextUInt32() >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    }
+
+    // [0, numValues), numValues > 0
+    int NextInt(int numValues)
+    {
+        return static_cast<int>((static_cast<uint64_t>(NextUInt32()) * static_cast<uint64_t>(numValues)) >> 32);
+    }
+
+    //region Block fills (white noise and the like, one call per block)
+    void FillFloat01(float* destination, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = NextFloat01();
+    }
+
+    void FillBipolar(float* destination, int numSamples, float gain = 1.0f)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = NextBipolar() * gain;
+    }
+    //endregion
+
+private:
+    static uint64_t mix(uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    static uint32_t rotateLeft(uint32_t value, int bits)
+    {
+        return (value << bits) | (value >> (32 - bits));
+    }
+
+    uint32_t state[4] {};
+};
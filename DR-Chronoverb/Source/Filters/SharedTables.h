@@ -0,0 +1,68 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+// Read-only tables shared by every instance in the process (windows, tuning sets, ...).
+// This is for tables computed at runtime; literal constants such as the diffusion tunings in
+// NewDelayReverb and Deverb are static members of their owners, shared without a lookup.
+//
+// A table is identified by its type, the sample rate it was built for (0 when it does not
+// depend on one) and its size. The first instance that asks builds it; everyone after that
+// gets the same immutable copy. The registry only keeps weak references, so a table is freed
+// once the last instance using it lets go.
+class SharedTables
+{
+public:
+    enum class TableType
+    {
+        GrainWindowHann,
+        GrainWindowSqrtHann,
+        GrainWindowTukey,
+        GrainWindowBlackman,
+        PhaseVocoderWindow,
+        PitchReverbTunings,
+        PitchReverbTuningsDecorrelated
+    };
+
+    using Table = std::vector<float>;
+    using TablePtr = std::shared_ptr<const Table>;
+
+    // Not realtime: takes the registry lock and may build the table. The build function
+    // fills a zeroed table of the requested size and must not call Get itself.
+    template <typename BuildFunction>
+    static TablePtr Get(TableType type, double sampleRate, int size, BuildFunction&& build)
+    {
+        auto& registry = getRegistry();
+        const std::scoped_lock lock(registry.Mutex);
+
+        auto& entry = registry.Tables[Key { type, sampleRate, size }];
+
+        if (auto existing = entry.lock())
+            return existing;
+
+        auto table = std::make_shared<Table>(static_cast<size_t>(size), 0.0f);
+        build(*table);
+
+        entry = table;
+        return table;
+    }
+
+private:
+    using Key = std::tuple<TableType, double, int>;
+
+    struct Registry
+    {
+        std::mutex Mutex;
+        std::map<Key, std::weak_ptr<const Table>> Tables;
+    };
+
+    static Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+};
@@ -0,0 +1,212 @@
+#include "SpectrumAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // How long a band takes to fall back by 1/e once its level drops.
+    constexpr float ReleaseSeconds = 0.25f;
+}
+
+void SpectrumAnalyzer::PrepareToPlay(double newSampleRate)
+{
+    analysisJob.Suspend();
+
+    sampleRate = newSampleRate;
+
+    const float binsPerHz = static_cast<float>(FftSize) / static_cast<float>(sampleRate);
+    const float frequencyRatio = MaxFrequencyHz / MinFrequencyHz;
+
+    for (int edgeIndex = 0; edgeIndex <= NumBands; ++edgeIndex)
+    {
+        const float edgeFrequency = MinFrequencyHz
+            * std::pow(frequencyRatio, static_cast<float>(edgeIndex) / static_cast<float>(NumBands));
+
+        bandEdgeBins[static_cast<size_t>(edgeIndex)] = edgeFrequency * binsPerHz;
+    }
+
+    const float hopSeconds = static_cast<float>(HopSize) / static_cast<float>(sampleRate);
+    releaseCoefficient = std::exp(-hopSeconds / ReleaseSeconds);
+
+    fifo.reset();
+    samplesSinceRequest = 0;
+    resetAnalysis();
+    resetRequested.store(false, std::memory_order_release);
+
+    analysisJob.RunNow();
+}
+
+void SpectrumAnalyzer::SetActive(bool shouldBeActive)
+{
+    if (shouldBeActive && !active.load(std::memory_order_acquire))
+        resetRequested.store(true, std::memory_order_release);
+
+    active.store(shouldBeActive, std::memory_order_release);
+}
+
+bool SpectrumAnalyzer::IsActive() const
+{
+    return active.load(std::memory_order_acquire);
+}
+
+void SpectrumAnalyzer::SetTapPoint(TapPoint newTapPoint)
+{
+    if (tapPoint.exchange(static_cast<int>(newTapPoint), std::memory_order_acq_rel) != static_cast<int>(newTapPoint))
+        resetRequested.store(true, std::memory_order_release);
+}
+
+SpectrumAnalyzer::TapPoint SpectrumAnalyzer::GetTapPoint() const
+{
+    return static_cast<TapPoint>(tapPoint.load(std::memory_order_acquire));
+}
+
+void SpectrumAnalyzer::PushSamples(const float* left, const float* right, int numSamples)
+{
+    if (!active.load(std::memory_order_relaxed) || numSamples <= 0)
+        return;
+
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    // Mono sum, so a hard-panned signal still shows at its level minus 6 dB.
+    if (size1 > 0)
+    {
+        juce::FloatVectorOperations::add(fifoBuffer.data() + start1, left, right, size1);
+        juce::FloatVectorOperations::multiply(fifoBuffer.data() + start1, 0.5f, size1);
+    }
+
+    if (size2 > 0)
+    {
+        juce::FloatVectorOperations::add(fifoBuffer.data() + start2, left + size1, right + size1, size2);
+        juce::FloatVectorOperations::multiply(fifoBuffer.data() + start2, 0.5f, size2);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+
+    samplesSinceRequest += size1 + size2;
+
+    if (samplesSinceRequest >= HopSize)
+    {
+        samplesSinceRequest = 0;
+        analysisJob.Request();
+    }
+}
+
+bool SpectrumAnalyzer::PullFrame()
+{
+    return frameMailbox.Pull();
+}
+
+const SpectrumAnalyzer::Frame& SpectrumAnalyzer::GetFrame()
+{
+    return frameMailbox.GetReadSlot();
+}
+
+float SpectrumAnalyzer::GetBandFrequency(int bandIndex)
+{
+    return MinFrequencyHz * std::pow(MaxFrequencyHz / MinFrequencyHz,
+        (static_cast<float>(bandIndex) + 0.5f) / static_cast<float>(NumBands));
+}
+
+// Worker: drains the FIFO into the history ring, analysing every HopSize samples.
+void SpectrumAnalyzer::analyzePendingSamples()
+{
+    if (resetRequested.exchange(false, std::memory_order_acq_rel))
+        resetAnalysis();
+
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    auto consume = [this](const float* samples, int numSamples)
+    {
+        for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+        {
+            history[static_cast<size_t>(historyWriteIndex)] = samples[sampleIndex];
+            historyWriteIndex = (historyWriteIndex + 1) & (FftSize - 1);
+
+            if (++samplesSinceLastFrame >= HopSize)
+            {
+                samplesSinceLastFrame = 0;
+                analyzeFrame();
+            }
+        }
+    };
+
+    consume(fifoBuffer.data() + start1, size1);
+    consume(fifoBuffer.data() + start2, size2);
+
+    fifo.finishedRead(size1 + size2);
+}
+
+void SpectrumAnalyzer::analyzeFrame()
+{
+    // Unroll the ring oldest sample first.
+    const auto splitPoint = history.begin() + historyWriteIndex;
+
+    std::copy(splitPoint, history.end(), fftData.begin());
+    std::copy(history.begin(), splitPoint, fftData.begin() + (FftSize - historyWriteIndex));
+    std::fill(fftData.begin() + FftSize, fftData.end(), 0.0f);
+
+    window.multiplyWithWindowingTable(fftData.data(), FftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // A full-scale sine peaks at FftSize / 2, halved again by the Hann window: read it as 0 dB.
+    constexpr float magnitudeScale = 4.0f / static_cast<float>(FftSize);
+    constexpr int nyquistBin = FftSize / 2;
+
+    Frame& frame = frameMailbox.GetWriteSlot();
+
+    for (int bandIndex = 0; bandIndex < NumBands; ++bandIndex)
+    {
+        const float lowBin = bandEdgeBins[static_cast<size_t>(bandIndex)];
+        const float highBin = std::min(bandEdgeBins[static_cast<size_t>(bandIndex) + 1], static_cast<float>(nyquistBin));
+
+        float magnitude = 0.0f;
+
+        if (lowBin < static_cast<float>(nyquistBin))
+        {
+            const int firstBin = static_cast<int>(std::ceil(lowBin));
+            const int lastBin = static_cast<int>(std::floor(highBin));
+
+            if (lastBin >= firstBin)
+            {
+                // Wide bands (high frequencies) show their loudest bin.
+                for (int bin = firstBin; bin <= lastBin; ++bin)
+                    magnitude = std::max(magnitude, fftData[static_cast<size_t>(bin)]);
+            }
+            else
+            {
+                // Narrow bands (low frequencies) fall between bins, interpolate at their centre.
+                const float centreBin = std::sqrt(std::max(lowBin, 0.5f) * highBin);
+                const int binBelow = static_cast<int>(centreBin);
+                const int binAbove = std::min(binBelow + 1, nyquistBin);
+                const float fraction = centreBin - static_cast<float>(binBelow);
+
+                magnitude = fftData[static_cast<size_t>(binBelow)]
+                    + fraction * (fftData[static_cast<size_t>(binAbove)] - fftData[static_cast<size_t>(binBelow)]);
+            }
+        }
+
+        const float decibels = juce::Decibels::gainToDecibels(magnitude * magnitudeScale, FloorDecibels);
+
+        // Instant attack, exponential release.
+        float& smoothed = smoothedDecibels[static_cast<size_t>(bandIndex)];
+        smoothed = decibels >= smoothed ? decibels : decibels + (smoothed - decibels) * releaseCoefficient;
+
+        frame.BandDecibels[static_cast<size_t>(bandIndex)] = smoothed;
+    }
+
+    frame.Tap = analyzedTap;
+    frameMailbox.Publish();
+}
+
+void SpectrumAnalyzer::resetAnalysis()
+{
+    std::fill(history.begin(), history.end(), 0.0f);
+    historyWriteIndex = 0;
+    samplesSinceLastFrame = 0;
+
+    smoothedDecibels.fill(FloorDecibels);
+    analyzedTap = GetTapPoint();
+}
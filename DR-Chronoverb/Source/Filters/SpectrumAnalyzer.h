@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include <juce_dsp/juce_dsp.h>
+
+#include "BackgroundWorker.h"
+#include "NewDelayReverb/Stages/Utils/LatestValueMailbox.h"
+
+// Spectrum of one tap point in the wet chain, for the editor's spectrum view.
+//
+// The audio thread only mixes the tapped block to mono and copies it into a
+// single-producer / single-consumer FIFO, and only while a view has switched the analyzer
+// on. It wakes the worker (lock-free) once per HopSize samples, not once per block, as
+// the worker can't analyse anything new before then. Windowing, the FFT, log-frequency banding and ballistics run on the shared
+// BackgroundWorker; finished frames reach the editor through a LatestValueMailbox.
+class SpectrumAnalyzer
+{
+public:
+    enum class TapPoint
+    {
+        PreDamping,
+        PostDamping,
+        PostDistortion
+    };
+
+    static constexpr int FftOrder = 11;
+    static constexpr int FftSize = 1 << FftOrder;
+    static constexpr int HopSize = FftSize / 4;
+
+    static constexpr int NumBands = 128;
+    static constexpr float MinFrequencyHz = 20.0f;
+    static constexpr float MaxFrequencyHz = 20000.0f;
+    static constexpr float FloorDecibels = -96.0f;
+
+    struct Frame
+    {
+        std::array<float, NumBands> BandDecibels {};
+        TapPoint Tap = TapPoint::PostDamping;
+    };
+
+    // Not realtime.
+    void PrepareToPlay(double newSampleRate);
+
+    //region Editor controls (any thread)
+    // Inactive analyzers cost the audio thread one atomic load per block. Switching on or
+    // changing the tap point starts the analysis afresh.
+    void SetActive(bool shouldBeActive);
+    bool IsActive() const;
+
+    void SetTapPoint(TapPoint newTapPoint);
+    TapPoint GetTapPoint() const;
+    //endregion
+
+    // Audio thread. Drops samples when the FIFO is full rather than waiting.
+    void PushSamples(const float* left, const float* right, int numSamples);
+
+    //region Frame access (message thread)
+    // Returns true when a new frame was finished since the last pull.
+    bool PullFrame();
+    const Frame& GetFrame();
+
+    // Centre frequency of a band; bands are spaced evenly in log frequency.
+    static float GetBandFrequency(int bandIndex);
+    //endregion
+
+private:
+    static constexpr int FifoSize = FftSize * 8;
+
+    void analyzePendingSamples();
+    void analyzeFrame();
+    void resetAnalysis();
+
+    double sampleRate = 48000.0;
+
+    std::atomic<bool> active { false };
+    std::atomic<int> tapPoint { static_cast<int>(TapPoint::PostDamping) };
+    std::atomic<bool> resetRequested { true };
+
+    // Audio thread -> worker
+    juce::AbstractFifo fifo { FifoSize };
+    std::vector<float> fifoBuffer = std::vector<float>(FifoSize, 0.0f);
+
+    // Audio thread only: samples written since the worker was last woken.
+    int samplesSinceRequest = 0;
+
+    //region Worker state
+    juce::dsp::FFT fft { FftOrder };
+    juce::dsp::WindowingFunction<float> window { FftSize, juce::dsp::WindowingFunction<float>::hann, false };
+
+    // Last FftSize samples, as a ring.
+    std::vector<float> history = std::vector<float>(FftSize, 0.0f);
+    int historyWriteIndex = 0;
+    int samplesSinceLastFrame = 0;
+
+    std::vector<float> fftData = std::vector<float>(FftSize * 2, 0.0f);
+
+    // Fractional FFT bin at each band's lower edge, plus the top edge of the last band.
+    std::array<float, NumBands + 1> bandEdgeBins {};
+    std::array<float, NumBands> smoothedDecibels {};
+
+    float releaseCoefficient = 0.0f;
+    TapPoint analyzedTap = TapPoint::PostDamping;
+    //endregion
+
+    // Worker -> editor
+    LatestValueMailbox<Frame> frameMailbox;
+
+    BackgroundJob analysisJob { [this] { analyzePendingSamples(); } };
+};
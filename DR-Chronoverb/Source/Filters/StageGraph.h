@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include <juce_core/juce_core.h>
+
+#include "BackgroundWorker.h"
+#include "NewDelayReverb/Stages/Utils/LatestValueMailbox.h"
+
+class Chronoverb;
+
+// User-arrangeable order of the wet chain. Deverb always feeds the chain and the
+// dry/wet mix + stereo always close it; the stages in between can be permuted.
+// Each order compiles into a flat plan of block-processing calls which the audio
+// thread picks up through a LatestValueMailbox.
+//
+// Setters only store the order index. Plans are compiled by compileJob alone (on the
+// background worker, or inline in Prepare), so the mailbox keeps its single writer however
+// many threads set the order.
+class StageGraph
+{
+public:
+    enum class StageId
+    {
+        Deverb,
+        PitchShifter,
+        Distortion,
+        PostFilters,
+        Ducking,
+        Tape,
+        Mix,
+        Stereo,
+        Count
+    };
+
+    static constexpr int NumReorderableStages = 5;
+    static constexpr int MaxSteps = static_cast<int>(StageId::Count);
+
+    using StepFunction = void (*)(Chronoverb&, int numSamples);
+
+    struct Plan
+    {
+        std::array<StepFunction, MaxSteps> Steps {};
+        int NumSteps = 0;
+    };
+
+    explicit StageGraph(const std::array<StepFunction, MaxSteps>& newStepFunctions)
+        : stepFunctions(newStepFunctions)
+    {
+        compile(0, planMailbox.GetWriteSlot());
+        planMailbox.Publish();
+        planMailbox.Pull();
+    }
+
+    // Not realtime. Publishes the plan for the current order before playback starts.
+    void Prepare()
+    {
+        compileJob.Suspend();
+        compileJob.RunNow();
+    }
+
+    // Any thread. The plan follows from the background worker.
+    void SetOrderIndex(int newOrderIndex)
+    {
+        orderIndex.store(newOrderIndex, std::memory_order_release);
+        compileJob.Request();
+    }
+
+    // See Chronoverb::BeginParameterBatch.
+    void BeginParameterBatch()
+    {
+        compileJob.Hold();
+    }
+
+    void EndParameterBatch()
+    {
+        compileJob.Release();
+    }
+
+    // Audio thread: returns the most recently published plan.
+    const Plan& AcquirePlan()
+    {
+        planMailbox.Pull();
+        return planMailbox.GetReadSlot();
+    }
+
+    static constexpr int GetNumOrders()
+    {
+        int numOrders = 1;
+
+        for (int i = 2; i <= NumReorderableStages; ++i)
+            numOrders *= i;
+
+        return numOrders;
+    }
+
+    // "Pitch > Dist > Filter > Duck > Tape", ... in permutation order, index 0 is the default.
+    static juce::StringArray GetOrderNames()
+    {
+        juce::StringArray names;
+
+        for (int orderIndex = 0; orderIndex < GetNumOrders(); ++orderIndex)
+        {
+            juce::StringArray stageNames;
+
+            for (const StageId stage : getOrder(orderIndex))
+                stageNames.add(getShortName(stage));
+
+            names.add(stageNames.joinIntoString(" > "));
+        }
+
+        return names;
+    }
+
+private:
+    static std::array<StageId, NumReorderableStages> getOrder(int orderIndex)
+    {
+        std::array<StageId, NumReorderableStages> order =
+        {
+            StageId::PitchShifter, StageId::Distortion, StageId::PostFilters, StageId::Ducking, StageId::Tape
+        };
+
+        const int clampedIndex = std::clamp(orderIndex, 0, GetNumOrders() - 1);
+
+        for (int i = 0; i < clampedIndex; ++i)
+            std::next_permutation(order.begin(), order.end());
+
+        return order;
+    }
+
+    static const char* getShortName(StageId stage)
+    {
+        switch (stage)
+        {
+            case StageId::PitchShifter: return "Pitch";
+            case StageId::Distortion:   return "Dist";
+            case StageId::PostFilters:  return "Filter";
+            case StageId::Ducking:      return "Duck";
+            case StageId::Tape:         return "Tape";
+            default:                    return "";
+        }
+    }
+
+    void compile(int orderIndex, Plan& plan) const
+    {
+        plan.NumSteps = 0;
+
+        auto addStep = [&](StageId stage)
+        {
+            plan.Steps[static_cast<size_t>(plan.NumSteps++)] = stepFunctions[static_cast<size_t>(stage)];
+        };
+
+        addStep(StageId::Deverb);
+
+        for (const StageId stage : getOrder(orderIndex))
+            addStep(stage);
+
+        addStep(StageId::Mix);
+        addStep(StageId::Stereo);
+    }
+
+    // compileJob only (worker or Prepare), so the mailbox has a single writer.
+    void compileRequestedOrder()
+    {
+        compile(orderIndex.load(std::memory_order_acquire), planMailbox.GetWriteSlot());
+        planMailbox.Publish();
+    }
+
+    std::array<StepFunction, MaxSteps> stepFunctions;
+    LatestValueMailbox<Plan> planMailbox;
+
+    std::atomic<int> orderIndex { 0 };
+
+    BackgroundJob compileJob { [this] { compileRequestedOrder(); } };
+};
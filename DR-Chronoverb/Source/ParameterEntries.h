@@ -11,6 +11,7 @@ namespace ParameterEntries
     {
         using namespace ParameterEntryTypes;
 
+        // Append new entries at the end: saved state stores values by position.
         static std::vector<PluginParameterRegistry::Entry> entries =
         {
             // ---- Delay ----
@@ -151,12 +152,84 @@ namespace ParameterEntries
                 "Pitch Shift Wet Mix",
                 juce::NormalisableRange<float>(0.0f, 1.0f),
                 0.0f,
-                [](Chronoverb& c, float v) { c.SetpitchWetMix(v); })
+                [](Chronoverb& c, float v) { c.SetpitchWetMix(v); }),
+
+            MakeChoice(
+                "pitchAlgorithm",
+                "Pitch Shift Algorithm",
+                juce::StringArray{ "Granular", "Phase Vocoder" },
+                0,
+                [](Chronoverb& c, int v) { c.SetPitchAlgorithm(v); }),
+
+            // ---- Tape ----
+            MakeBool(
+                "tapeEnabled",
+                "Tape Enabled",
+                false,
+                [](Chronoverb& c, bool v) { c.SetTapeEnabled(v); }),
+
+            MakeFloat(
+                "tapeWobbleRate",
+                "Tape Wobble Rate",
+                juce::NormalisableRange<float>(0.05f, 15.0f, 0.0f, 0.4f),
+                1.0f,
+                [](Chronoverb& c, float v) { c.SetTapeWobbleRate(v); }),
+
+            MakeFloat(
+                "tapeWobbleDepth",
+                "Tape Wobble Depth",
+                juce::NormalisableRange<float>(0.0f, 1.0f),
+                0.3f,
+                [](Chronoverb& c, float v) { c.SetTapeWobbleDepth(v); }),
+
+            MakeFloat(
+                "tapeSaturation",
+                "Tape Saturation",
+                juce::NormalisableRange<float>(0.0f, 1.0f),
+                0.0f,
+                [](Chronoverb& c, float v) { c.SetTapeSaturation(v); }),
+
+            MakeBool(
+                "tapeNoiseEnabled",
+                "Tape Noise Enabled",
+                false,
+                [](Chronoverb& c, bool v) { c.SetTapeNoiseEnabled(v); }),
+
+            // ---- Routing ----
+            MakeChoice(
+                "stageOrder",
+                "Stage Order",
+                StageGraph::GetOrderNames(),
+                0,
+                [](Chronoverb& c, int v) { c.SetStageOrder(v); })
         };
 
-        AddDistortionModuleEntries(entries, 1);
-        AddDistortionModuleEntries(entries, 2);
-        AddDistortionModuleEntries(entries, 3);
+        // Generated entries, appended once on first use.
+        static const bool entriesAppended = []
+        {
+            AddDistortionModuleEntries(entries, 1);
+            AddDistortionModuleEntries(entries, 2);
+            AddDistortionModuleEntries(entries, 3);
+
+            // ---- Granular pitch backend ----
+            entries.push_back(MakeChoice(
+                "pitchGrainCount",
+                "Pitch Shift Grain Count",
+                juce::StringArray{ "2", "4", "8" },
+                1,
+                [](Chronoverb& c, int v) { c.SetPitchGrainCount(v); }));
+
+            entries.push_back(MakeChoice(
+                "pitchGrainWindow",
+                "Pitch Shift Grain Window",
+                juce::StringArray{ "Hann", "Sqrt Hann", "Tukey", "Blackman" },
+                0,
+                [](Chronoverb& c, int v) { c.SetPitchGrainWindow(v); }));
+
+            return true;
+        }();
+
+        juce::ignoreUnused(entriesAppended);
 
         return entries;
     }
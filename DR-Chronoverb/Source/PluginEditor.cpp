@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "PaintProfiler.h"
 
 // TODO: Implement playback direction features.
 
@@ -37,8 +38,8 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
     // Background
     //background = juce::ImageFileFormat::loadFrom(BinaryData::bg_png, BinaryData::bg_pngSize);
 
-    // Logo
-    logo = juce::ImageFileFormat::loadFrom(BinaryData::logo_png, BinaryData::logo_pngSize);
+    // Logo (decoded once and shared by every open editor)
+    logo = juce::ImageCache::getFromMemory(BinaryData::logo_png, BinaryData::logo_pngSize);
 
     // ------ KNOBS ------
     uiHelpers.CreateKnob(*this, delayTimeKnob, delayTimeAttachment, "delayTime",
@@ -202,12 +203,14 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
         "filtersOrder", *filtersOrderButtons);
 
     // ------ TABBED PAGE BOX ------
-    PageBoxLayout.CreatePageBoxLayout(*this, uiHelpers, processorRef, 25, 450, 850, 180);
-
-    auto distRackTheme = RackTheme();
+    PageBoxLayout.CreatePageBoxLayout(*this, uiHelpers, processorRef, 25, 450, 850, 180,
+        [this](juce::Component& distortionPage)
+        {
+            auto distRackTheme = RackTheme();
 
-    distortionRackLayout.CreateDistortionRackLayout(*PageBoxLayout.DistortionPage, processorRef,
-        distRackTheme, 0, 0, 830, 140);
+            distortionRackLayout.CreateDistortionRackLayout(distortionPage, processorRef,
+                distRackTheme, 0, 0, 830, 140);
+        });
 
     /*rack.CreateRackLayout(*PageBoxLayout.DistortionPage, processorRef,
         distRackTheme, 0, 0, 830, 140);*/
@@ -220,6 +223,8 @@ AudioPluginAudioProcessorEditor::~AudioPluginAudioProcessorEditor()
 //==============================================================================
 void AudioPluginAudioProcessorEditor::paint (juce::Graphics& graphics)
 {
+    DR_PROFILE_PAINT("Editor");
+
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     graphics.fillAll(BGGray);
 
@@ -274,6 +279,28 @@ bool AudioPluginAudioProcessorEditor::keyPressed(const juce::KeyPress& key, juce
         return true;
     }
 
+    // Measurement stimuli, for capturing impulse responses
+    {
+        using Signal = MeasurementSignalGenerator::Signal;
+
+        const std::pair<int, Signal> measurementKeys[] =
+        {
+            { juce::KeyPress::F1Key, Signal::Impulse },
+            { juce::KeyPress::F2Key, Signal::LogSweep },
+            { juce::KeyPress::F3Key, Signal::Mls },
+            { juce::KeyPress::F4Key, Signal::NoiseBurst }
+        };
+
+        for (const auto& [keyCode, signal] : measurementKeys)
+        {
+            if (key.getKeyCode() == keyCode)
+            {
+                processorRef.MeasurementSignal.Trigger(signal);
+                return true;
+            }
+        }
+    }
+
     // Keyboard synth
     int KeyCode = 0;
 
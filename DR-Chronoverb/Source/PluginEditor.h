@@ -7,6 +7,7 @@
 #include "PluginProcessor.h"
 
 #include "Utils/UIHelpers.h"
+#include "AnimationScheduler.h"
 #include "Utils/SegmentedButton.h"
 #include "Utils/Theme.h"
 #include "Utils/TabbedPageBox.h"
@@ -20,7 +21,8 @@
 #include "UI/TabbedPageboxLayout.h"
 
 //==============================================================================
-class AudioPluginAudioProcessorEditor  : public juce::AudioProcessorEditor, public juce::KeyListener
+class AudioPluginAudioProcessorEditor  : public juce::AudioProcessorEditor, public juce::KeyListener,
+                                         public AnimationScheduler::Host
 {
 public:
     explicit AudioPluginAudioProcessorEditor (AudioPluginAudioProcessor&);
@@ -34,6 +36,8 @@ public:
     bool keyPressed(const juce::KeyPress& key, juce::Component* originatingComponent) override;
     bool keyStateChanged(bool isKeyDown, juce::Component* originatingComponent) override;
 
+    AnimationScheduler& GetAnimationScheduler() override { return animationScheduler; }
+
 private:
     void updateDelayKnobDisplay(int modeIndex);
 
@@ -44,6 +48,9 @@ private:
     // access the processor object that created it.
     AudioPluginAudioProcessor& processorRef;
 
+    // Declared before any animated component so it outlives them.
+    AnimationScheduler animationScheduler { *this };
+
     FlatRotaryLookAndFeel flatKnobLAF;
     UIHelpers uiHelpers;
 
@@ -127,8 +127,12 @@ void PluginParameterRegistry::RemoveListeners(juce::AudioProcessorValueTreeState
 void PluginParameterRegistry::ApplyAll(Chronoverb& chronoverb,
                                        juce::AudioProcessorValueTreeState& apvts)
 {
+    chronoverb.BeginParameterBatch();
+
     for (const auto& entry : GetEntries())
         entry.applyFromState(chronoverb, apvts, entry.parameterID);
+
+    chronoverb.EndParameterBatch();
 }
 
 bool PluginParameterRegistry::ApplyOneIfMatched(Chronoverb& chronoverb,
@@ -28,6 +28,7 @@ public:
     static void RemoveListeners(juce::AudioProcessorValueTreeState& apvts,
                                 juce::AudioProcessorValueTreeState::Listener* listener);
 
+    // Applies every parameter as one batch, so derived rebuilds run once.
     static void ApplyAll(Chronoverb& chronoverb,
                          juce::AudioProcessorValueTreeState& apvts);
 
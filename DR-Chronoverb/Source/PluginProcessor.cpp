@@ -2,6 +2,7 @@
 #include "PluginEditor.h"
 
 #include "PluginParameterRegistry.h"
+#include "BinaryPluginState.h"
 
 //==============================================================================
 AudioPluginAudioProcessor::AudioPluginAudioProcessor()
@@ -17,6 +18,9 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
 {
     PluginParameterRegistry::AddListeners(parameters, this);
     PluginParameterRegistry::ApplyAll(DelayReverb, parameters);
+
+    // New instances don't jitter and hiss in lockstep; saved sessions restore their seed.
+    DelayReverb.SetRandomSeed(static_cast<uint32_t>(juce::Random::getSystemRandom().nextInt()));
 }
 
 AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
@@ -101,6 +105,7 @@ void AudioPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
 
     KeyboardSynth.PrepareToPlay(sampleRate);
     ImpulseClick.PrepareToPlay(sampleRate);
+    MeasurementSignal.PrepareToPlay(sampleRate);
 
     DelayReverb.PrepareToPlay(sampleRate);
 }
@@ -168,6 +173,9 @@ void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // Impulse response click
     ImpulseClick.Process(buffer);
 
+    // Measurement stimuli (F1..F4 in the editor)
+    MeasurementSignal.Process(buffer);
+
     // Computer Keyboard Square Synth
     KeyboardSynth.Process(buffer);
 
@@ -249,20 +257,37 @@ juce::AudioProcessorEditor* AudioPluginAudioProcessor::createEditor()
 //==============================================================================
 void AudioPluginAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    // Save all parameters as XML
-    auto xmlState = parameters.copyState().createXml();
-    copyXmlToBinary(*xmlState, destData);
+    // Parameter table in registry order (ParameterEntries is append-only).
+    const uint32_t randomSeed = juce::ByteOrder::swapIfBigEndian(DelayReverb.GetRandomSeed());
+
+    BinaryPluginState::Write(*this, destData, { { RandomSeedBlobTag, &randomSeed, sizeof(randomSeed) } });
 }
 
 void AudioPluginAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    // Load parameters from XML
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+    // Read and replaceState notify parameterChanged once per parameter; keep those in the
+    // same batch as the final ApplyAll so every derived rebuild runs once.
+    DelayReverb.BeginParameterBatch();
 
-    if (xmlState != nullptr)
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    const bool isBinaryState = BinaryPluginState::Read(*this, data, sizeInBytes,
+        [this](const BinaryPluginState::Blob& blob)
+        {
+            if (blob.Tag == RandomSeedBlobTag && blob.Size == sizeof(uint32_t))
+                DelayReverb.SetRandomSeed(juce::ByteOrder::littleEndianInt(blob.Data));
+        });
+
+    // Sessions saved before the binary format are XML.
+    if (!isBinaryState)
+    {
+        std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+
+        if (xmlState != nullptr)
+            parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    }
 
     PluginParameterRegistry::ApplyAll(DelayReverb, parameters);
+
+    DelayReverb.EndParameterBatch();
 }
 
 //==============================================================================
@@ -6,6 +6,7 @@
 #include "Filters/Chronoverb.h"
 #include "Filters/ComputerKeyboardSquareSynth.h"
 #include "Filters/ImpulseClickSynth.h"
+#include "Filters/MeasurementSignalGenerator.h"
 
 //==============================================================================
 class AudioPluginAudioProcessor  : public juce::AudioProcessor, public juce::AudioProcessorValueTreeState::Listener
@@ -24,6 +25,7 @@ public:
 
     ComputerKeyboardSquareSynth KeyboardSynth;
     ImpulseClickSynth ImpulseClick;
+    MeasurementSignalGenerator MeasurementSignal;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
@@ -61,6 +63,9 @@ protected:
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
 
 private:
+    // BinaryPluginState blob with DelayReverb's random seed (uint32, little endian)
+    static constexpr uint32_t RandomSeedBlobTag = 0x44454553; // "SEED"
+
     //==============================================================================
     // --- Square wave tests ---
     double squareTestPhase = 0.0;
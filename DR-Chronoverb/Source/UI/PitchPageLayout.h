@@ -32,6 +32,12 @@ public:
         horizontalPitchRangeTooltipOverlay->setBounds(parentPage.getLocalBounds());
         horizontalPitchRangeTooltipOverlay->toFront(false);
 
+        horizontalPitchRangeSlider->OnTooltipStateChanged = [this]()
+        {
+            if (horizontalPitchRangeTooltipOverlay != nullptr)
+                horizontalPitchRangeTooltipOverlay->TooltipStateChanged();
+        };
+
         // Pitch mode (sequence)
         constexpr int sequenceWidth = 180;
         pitchSequenceDropdown = std::make_unique<ThemedDropdown>();
@@ -47,6 +53,21 @@ public:
         uiHelpers.CreateLabel(parentPage, pitchSequenceLabel,
             "Sequence", 14.0f, 30 + (sequenceWidth / 2), 22);
 
+        // Pitch algorithm (backend)
+        constexpr int algorithmX = 30 + sequenceWidth + 20;
+        pitchAlgorithmDropdown = std::make_unique<ThemedDropdown>();
+        parentPage.addAndMakeVisible(*pitchAlgorithmDropdown);
+        pitchAlgorithmDropdown->setBounds(algorithmX, 45, sequenceWidth, 32);
+
+        pitchAlgorithmAttachment = std::make_unique<ThemedDropdown::Attachment>(
+            processorRef.parameters,
+            "pitchAlgorithm",
+            *pitchAlgorithmDropdown
+        );
+
+        uiHelpers.CreateLabel(parentPage, pitchAlgorithmLabel,
+            "Algorithm", 14.0f, algorithmX + (sequenceWidth / 2), 22);
+
         constexpr int pWetWidth = 130;
 
         uiHelpers.CreateKnobExt(parentPage, pitchWetMixKnob, pitchWetMixAttachment, "pitchWetMix",
@@ -44,6 +44,12 @@ void DistortionRackLayout::CreateDistortionRackLayout(
     distortionModule2.CreateLayout(theme, apvts, module2IDs);
     distortionModule3.CreateLayout(theme, apvts, module3IDs);
 
+    const auto& distortion = *processorRef.DelayReverb.DistortionLeftRight;
+
+    distortionModule1.GetOscilloscope().SetFeed(&distortion.GetScopeFeed(0));
+    distortionModule2.GetOscilloscope().SetFeed(&distortion.GetScopeFeed(1));
+    distortionModule3.GetOscilloscope().SetFeed(&distortion.GetScopeFeed(2));
+
     rack.RegisterModule(distortionModule1);
     rack.RegisterModule(distortionModule2);
     rack.RegisterModule(distortionModule3);
@@ -1,58 +1,5 @@
 #include "Module.h"
-
-namespace
-{
-    class PlaceholderScopeComponent final : public juce::Component
-    {
-    public:
-        void SetColours(juce::Colour newBackground, juce::Colour newOutline, juce::Colour newWave)
-        {
-            background = newBackground;
-            outline = newOutline;
-            wave = newWave;
-            repaint();
-        }
-
-        void paint(juce::Graphics& graphics) override
-        {
-            const auto bounds = getLocalBounds().toFloat();
-
-            graphics.setColour(background.darker(0.5));
-            graphics.fillRoundedRectangle(bounds, 6.0f);
-
-            graphics.setColour(outline);
-            graphics.drawRoundedRectangle(bounds.reduced(0.5f), 6.0f, 1.0f);
-
-            const auto area = getLocalBounds().reduced(8);
-            const int midY = area.getCentreY();
-
-            juce::Path waveform;
-            waveform.startNewSubPath(static_cast<float>(area.getX()),
-                                     static_cast<float>(midY));
-
-            for (int x = 0; x < area.getWidth(); ++x)
-            {
-                const float t = static_cast<float>(x)
-                              / static_cast<float>(juce::jmax(1, area.getWidth() - 1));
-
-                const float y =
-                    std::sin(t * juce::MathConstants<float>::twoPi * 2.0f) * 0.35f
-                  + std::sin(t * juce::MathConstants<float>::twoPi * 5.0f) * 0.12f;
-
-                waveform.lineTo(static_cast<float>(area.getX() + x),
-                                static_cast<float>(midY) - y * static_cast<float>(area.getHeight()) * 0.5f);
-            }
-
-            graphics.setColour(wave);
-            graphics.strokePath(waveform, juce::PathStrokeType(1.5f));
-        }
-
-    private:
-        juce::Colour background = juce::Colours::black;
-        juce::Colour outline = juce::Colours::darkgrey;
-        juce::Colour wave = juce::Colours::white;
-    };
-}
+#include "PaintProfiler.h"
 
 Module::Module()
 {
@@ -67,23 +14,28 @@ Module::Module()
 
     addAndMakeVisible(enableButton);
 
-    oscilloscopePlaceholder = std::make_unique<PlaceholderScopeComponent>();
-    addAndMakeVisible(*oscilloscopePlaceholder);
+    oscilloscope = std::make_unique<Oscilloscope>();
+    addAndMakeVisible(*oscilloscope);
 
     SetModuleEnabled(true);
 }
 
 void Module::paint(juce::Graphics& graphics)
 {
-    const auto bounds = getLocalBounds().toFloat();
-    const float chromeAlpha = moduleEnabled ? 1.0f : theme.disabledAlpha;
+    DR_PROFILE_PAINT("Module");
+
+    chromeLayer.Draw(graphics, getLocalBounds(), [this](juce::Graphics& layerGraphics)
+    {
+        const auto bounds = getLocalBounds().toFloat();
+        const float chromeAlpha = moduleEnabled ? 1.0f : theme.disabledAlpha;
 
-    // Main module background color
-    graphics.setColour(GetModuleBackgroundColour().darker(theme.moduleBackgroundDarkenAmount));
-    graphics.fillRoundedRectangle(bounds, theme.moduleCornerRadius);
+        // Main module background color
+        layerGraphics.setColour(GetModuleBackgroundColour().darker(theme.moduleBackgroundDarkenAmount));
+        layerGraphics.fillRoundedRectangle(bounds, theme.moduleCornerRadius);
 
-    graphics.setColour(GetModuleOutlineColour().withAlpha(chromeAlpha));
-    graphics.drawRoundedRectangle(bounds.reduced(0.5f), theme.moduleCornerRadius, 1.0f);
+        layerGraphics.setColour(GetModuleOutlineColour().withAlpha(chromeAlpha));
+        layerGraphics.drawRoundedRectangle(bounds.reduced(0.5f), theme.moduleCornerRadius, 1.0f);
+    });
 }
 
 void Module::resized()
@@ -106,6 +58,11 @@ juce::Colour Module::GetThemeColour() const
 void Module::SetModuleEnabled(bool shouldBeEnabled)
 {
     moduleEnabled = shouldBeEnabled;
+    chromeLayer.Invalidate();
+
+    // A disabled module isn't feeding its scope, so stop reading it too.
+    if (oscilloscope != nullptr)
+        oscilloscope->SetFrozen(!moduleEnabled);
 
     const float alpha = moduleEnabled ? 1.0f : theme.disabledAlpha;
 
@@ -128,10 +85,10 @@ bool Module::IsModuleEnabled() const
     return moduleEnabled;
 }
 
-juce::Component& Module::GetOscilloscopePlaceholder()
+Oscilloscope& Module::GetOscilloscope()
 {
-    jassert(oscilloscopePlaceholder != nullptr);
-    return *oscilloscopePlaceholder;
+    jassert(oscilloscope != nullptr);
+    return *oscilloscope;
 }
 
 juce::ToggleButton& Module::GetEnableButton()
@@ -141,13 +98,15 @@ juce::ToggleButton& Module::GetEnableButton()
 
 void Module::ApplyThemeToBaseChrome()
 {
+    chromeLayer.Invalidate();
+
     enableButton.setColour(juce::ToggleButton::tickColourId, themeColour);
     enableButton.setColour(juce::ToggleButton::textColourId, juce::Colours::transparentBlack);
 
     // Oscilloscope
-    if (auto* scope = dynamic_cast<PlaceholderScopeComponent*>(oscilloscopePlaceholder.get()))
+    if (oscilloscope != nullptr)
     {
-        scope->SetColours(
+        oscilloscope->SetColours(
             juce::Colours::black, // TODO: Temporary
             GetModuleOutlineColour(),
             themeColour);
@@ -176,8 +135,8 @@ void Module::LayoutBaseChrome()
 
     const int scopeSide = juce::jmin(theme.scopeSize, maxScopeHeight);
 
-    if (oscilloscopePlaceholder != nullptr)
-        oscilloscopePlaceholder->setBounds(contentX,
+    if (oscilloscope != nullptr)
+        oscilloscope->setBounds(contentX,
                                            scopeY,
                                            juce::jmax(10, scopeSide),
                                            juce::jmax(10, scopeSide));
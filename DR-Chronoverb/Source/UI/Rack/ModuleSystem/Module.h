@@ -3,7 +3,9 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 
 #include "../RackTheme.h"
+#include "../../../Utils/CachedLayer.h"
 #include "ModuleThemeProvider.h"
+#include "Oscilloscope.h"
 
 using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
 
@@ -23,7 +25,7 @@ public:
     void SetModuleEnabled(bool shouldBeEnabled);
     bool IsModuleEnabled() const;
 
-    juce::Component& GetOscilloscopePlaceholder();
+    Oscilloscope& GetOscilloscope();
     juce::ToggleButton& GetEnableButton();
 
     void AttachEnableButton(juce::AudioProcessorValueTreeState& apvts,
@@ -43,10 +45,12 @@ protected:
     juce::Colour themeColour = juce::Colours::orange;
     bool moduleEnabled = true;
 
-    std::unique_ptr<juce::Component> oscilloscopePlaceholder;
+    std::unique_ptr<Oscilloscope> oscilloscope;
     juce::ToggleButton enableButton;
     std::unique_ptr<ButtonAttachment> enableAttachment;
 
 private:
+    CachedLayer chromeLayer;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Module)
 };
\ No newline at end of file
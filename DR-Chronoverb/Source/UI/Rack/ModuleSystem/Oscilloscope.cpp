@@ -0,0 +1,183 @@
+#include "Oscilloscope.h"
+#include "PaintProfiler.h"
+
+Oscilloscope::Oscilloscope()
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+void Oscilloscope::SetFeed(const ScopeFeed* newFeed)
+{
+    feed = newFeed;
+
+    redrawHistory();
+    updateScheduling();
+    repaint();
+}
+
+void Oscilloscope::SetColours(juce::Colour newBackground, juce::Colour newOutline, juce::Colour newWave)
+{
+    background = newBackground;
+    outline = newOutline;
+    wave = newWave;
+
+    backgroundLayer.Invalidate();
+
+    // The columns already in the image were drawn in the old colour.
+    redrawHistory();
+    repaint();
+}
+
+void Oscilloscope::SetFrozen(bool shouldBeFrozen)
+{
+    if (frozen == shouldBeFrozen)
+        return;
+
+    frozen = shouldBeFrozen;
+    updateScheduling();
+}
+
+bool Oscilloscope::IsFrozen() const
+{
+    return frozen;
+}
+
+void Oscilloscope::paint(juce::Graphics& graphics)
+{
+    DR_PROFILE_PAINT("Oscilloscope");
+
+    backgroundLayer.Draw(graphics, getLocalBounds(), [this](juce::Graphics& layerGraphics)
+    {
+        const auto bounds = getLocalBounds().toFloat();
+        const auto plotArea = getPlotArea().toFloat();
+
+        layerGraphics.setColour(background.darker(0.5));
+        layerGraphics.fillRoundedRectangle(bounds, 6.0f);
+
+        layerGraphics.setColour(wave.withAlpha(0.15f));
+        layerGraphics.drawHorizontalLine(juce::roundToInt(plotArea.getCentreY()), plotArea.getX(), plotArea.getRight());
+
+        layerGraphics.setColour(outline);
+        layerGraphics.drawRoundedRectangle(bounds.reduced(0.5f), 6.0f, 1.0f);
+    });
+
+    if (columnsImage.isValid())
+    {
+        const auto plotArea = getPlotArea();
+        graphics.drawImageAt(columnsImage, plotArea.getRight() - columnsImage.getWidth(), plotArea.getY());
+    }
+}
+
+void Oscilloscope::resized()
+{
+    const auto plotArea = getPlotArea();
+
+    if (plotArea.isEmpty())
+        columnsImage = {};
+    else
+        columnsImage = juce::Image(juce::Image::ARGB,
+                                   juce::jmin(plotArea.getWidth(), ScopeFeed::Capacity),
+                                   plotArea.getHeight(),
+                                   true);
+
+    redrawHistory();
+}
+
+bool Oscilloscope::AdvanceAnimation(double frameTimeSeconds)
+{
+    if (frozen || feed == nullptr || !columnsImage.isValid() || !isShowing())
+        return false;
+
+    if (frameTimeSeconds - lastFrameTimeSeconds < 1.0 / MaxFrameRateHz)
+        return true;
+
+    lastFrameTimeSeconds = frameTimeSeconds;
+
+    const int64_t writtenColumns = feed->GetWrittenColumns();
+    const int64_t newColumns = writtenColumns - readColumn;
+
+    if (newColumns <= 0)
+        return true;
+
+    const int width = columnsImage.getWidth();
+
+    if (newColumns >= width)
+    {
+        redrawHistory();
+    }
+    else
+    {
+        // Scroll what's there left and only draw the columns that arrived since last frame.
+        const int shift = static_cast<int>(newColumns);
+
+        columnsImage.moveImageSection(0, 0, shift, 0, width - shift, columnsImage.getHeight());
+        drawColumns(readColumn, shift);
+
+        readColumn = writtenColumns;
+    }
+
+    repaint(getPlotArea());
+    return true;
+}
+
+void Oscilloscope::updateScheduling()
+{
+    if (!frozen && feed != nullptr && isShowing())
+        StartAnimating(*this);
+    else
+        StopAnimating();
+}
+
+// Redraws the whole image from the newest columns still in the feed.
+void Oscilloscope::redrawHistory()
+{
+    if (!columnsImage.isValid())
+        return;
+
+    columnsImage.clear(columnsImage.getBounds());
+
+    if (feed == nullptr)
+        return;
+
+    const int64_t writtenColumns = feed->GetWrittenColumns();
+    const int numColumns = static_cast<int>(juce::jmin(static_cast<int64_t>(columnsImage.getWidth()), writtenColumns));
+
+    drawColumns(writtenColumns - numColumns, numColumns);
+    readColumn = writtenColumns;
+}
+
+// Draws numColumns columns, starting at firstColumn, into the rightmost pixels of the image.
+void Oscilloscope::drawColumns(int64_t firstColumn, int numColumns)
+{
+    if (numColumns <= 0)
+        return;
+
+    const int width = columnsImage.getWidth();
+    const int height = columnsImage.getHeight();
+    const int startX = width - numColumns;
+
+    columnsImage.clear({ startX, 0, numColumns, height });
+
+    juce::Graphics imageGraphics(columnsImage);
+    imageGraphics.setColour(wave);
+
+    const float halfHeight = static_cast<float>(height) * 0.5f;
+
+    for (int i = 0; i < numColumns; ++i)
+    {
+        const ScopeFeed::Column column = feed->GetColumn(firstColumn + i);
+
+        const float top = halfHeight - juce::jlimit(-1.0f, 1.0f, column.Max) * halfHeight;
+        const float bottom = halfHeight - juce::jlimit(-1.0f, 1.0f, column.Min) * halfHeight;
+
+        imageGraphics.fillRect(static_cast<float>(startX + i),
+                               top,
+                               1.0f,
+                               juce::jmax(1.0f, bottom - top));
+    }
+}
+
+juce::Rectangle<int> Oscilloscope::getPlotArea() const
+{
+    return getLocalBounds().reduced(8);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "../../../Filters/NewDelayReverb/Stages/Utils/ScopeFeed.h"
+#include "AnimationScheduler.h"
+#include "../../../Utils/CachedLayer.h"
+
+// Scrolling min/max waveform display for a rack module.
+//
+// Columns come from a ScopeFeed written by the audio thread, one pixel per column. New
+// columns are drawn into a backing image after scrolling what's already there, so a frame
+// costs an image move plus a few vertical lines no matter how wide the scope is. The
+// frame, background and centre line are a cached layer.
+//
+// Ticks on the editor's AnimationScheduler only while on screen and not frozen; a frozen
+// or hidden scope keeps its last picture and costs nothing.
+class Oscilloscope : public juce::Component,
+                     private AnimationScheduler::Client
+{
+public:
+    static constexpr double MaxFrameRateHz = 30.0;
+
+    Oscilloscope();
+    ~Oscilloscope() override = default;
+
+    void SetFeed(const ScopeFeed* newFeed);
+
+    void SetColours(juce::Colour newBackground, juce::Colour newOutline, juce::Colour newWave);
+
+    // Frozen scopes stop reading the feed and keep showing the last picture.
+    void SetFrozen(bool shouldBeFrozen);
+    bool IsFrozen() const;
+
+    void paint(juce::Graphics& graphics) override;
+    void resized() override;
+
+private:
+    // Tab pages hide whole subtrees, which Component::visibilityChanged() doesn't report.
+    class ShowingWatcher : public juce::ComponentMovementWatcher
+    {
+    public:
+        explicit ShowingWatcher(Oscilloscope& scope)
+            : juce::ComponentMovementWatcher(&scope), owner(scope) {}
+
+        void componentMovedOrResized(bool, bool) override {}
+        void componentPeerChanged() override { owner.updateScheduling(); }
+        void componentVisibilityChanged() override { owner.updateScheduling(); }
+
+    private:
+        Oscilloscope& owner;
+    };
+
+    bool AdvanceAnimation(double frameTimeSeconds) override;
+
+    void updateScheduling();
+    void redrawHistory();
+    void drawColumns(int64_t firstColumn, int numColumns);
+
+    juce::Rectangle<int> getPlotArea() const;
+
+    const ScopeFeed* feed = nullptr;
+
+    juce::Colour background = juce::Colours::black;
+    juce::Colour outline = juce::Colours::darkgrey;
+    juce::Colour wave = juce::Colours::white;
+
+    bool frozen = false;
+
+    CachedLayer backgroundLayer;
+    juce::Image columnsImage;
+
+    int64_t readColumn = 0;
+    double lastFrameTimeSeconds = 0.0;
+
+    ShowingWatcher showingWatcher { *this };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Oscilloscope)
+};
@@ -112,7 +112,7 @@ void DistortionModule::LayoutControls()
                          titleW,
                          theme.headerHeight);
 
-    const auto scopeBounds = GetOscilloscopePlaceholder().getBounds();
+    const auto scopeBounds = GetOscilloscope().getBounds();
 
     const int rightColumnX = scopeBounds.getRight() + theme.moduleInnerGap;
     const int rightColumnW = getWidth() - theme.modulePadding - rightColumnX;
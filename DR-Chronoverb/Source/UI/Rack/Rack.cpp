@@ -1,4 +1,5 @@
 #include "Rack.h"
+#include "PaintProfiler.h"
 
 void Rack::CreateRackLayout(juce::Component& parent,
                             AudioPluginAudioProcessor& processorRef,
@@ -9,6 +10,7 @@ void Rack::CreateRackLayout(juce::Component& parent,
     apvts = &processorRef.parameters;
 
     theme = newTheme;
+    backgroundLayer.Invalidate();
 
     parent.addAndMakeVisible(*this);
     setBounds(x, y, width, height);
@@ -29,13 +31,18 @@ void Rack::RegisterModule(Module& module)
 
 void Rack::paint(juce::Graphics& graphics)
 {
-    const auto bounds = getLocalBounds().toFloat();
+    DR_PROFILE_PAINT("Rack");
 
-    graphics.setColour(theme.rackBackgroundColour);
-    graphics.fillRoundedRectangle(bounds, theme.rackCornerRadius);
+    backgroundLayer.Draw(graphics, getLocalBounds(), [this](juce::Graphics& layerGraphics)
+    {
+        const auto bounds = getLocalBounds().toFloat();
+
+        layerGraphics.setColour(theme.rackBackgroundColour);
+        layerGraphics.fillRoundedRectangle(bounds, theme.rackCornerRadius);
 
-    graphics.setColour(theme.rackBackgroundColour.brighter(theme.rackOutlineBrightenAmount));
-    graphics.drawRoundedRectangle(bounds.reduced(0.5f), theme.rackCornerRadius, theme.rackOutlineThickness);
+        layerGraphics.setColour(theme.rackBackgroundColour.brighter(theme.rackOutlineBrightenAmount));
+        layerGraphics.drawRoundedRectangle(bounds.reduced(0.5f), theme.rackCornerRadius, theme.rackOutlineThickness);
+    });
 }
 
 void Rack::resized()
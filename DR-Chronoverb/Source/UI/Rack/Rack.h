@@ -3,6 +3,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "../../PluginProcessor.h"
 #include "RackTheme.h"
+#include "../../Utils/CachedLayer.h"
 #include "Modules/DistortionModule.h"
 
 class Rack : public juce::Component
@@ -32,6 +33,7 @@ private:
     std::vector<Module*> modules;
 
     RackTheme theme;
+    CachedLayer backgroundLayer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Rack)
 };
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "SpectrumView.h"
+#include "PaintProfiler.h"
+#include "../Utils/Theme.h"
+
+#include <cmath>
+
+SpectrumView::SpectrumView(SpectrumAnalyzer& analyzerToShow)
+    : analyzer(analyzerToShow)
+{
+    bandDecibels.fill(MinDecibels);
+
+    addAndMakeVisible(tapButtons);
+    tapButtons.setSelectedIndexSilently(static_cast<int>(analyzer.GetTapPoint()));
+
+    tapButtons.onSelectionChanged = [this](int newIndex)
+    {
+        analyzer.SetTapPoint(static_cast<SpectrumAnalyzer::TapPoint>(newIndex));
+
+        bandDecibels.fill(MinDecibels);
+        rebuildSpectrumPath();
+        repaint(getPlotArea());
+    };
+}
+
+SpectrumView::~SpectrumView()
+{
+    analyzer.SetActive(false);
+}
+
+void SpectrumView::paint(juce::Graphics& graphics)
+{
+    DR_PROFILE_PAINT("SpectrumView");
+
+    const auto plotArea = getPlotArea();
+
+    gridLayer.Draw(graphics, plotArea, [plotArea](juce::Graphics& layerGraphics)
+    {
+        const auto bounds = plotArea.withZeroOrigin().toFloat();
+
+        layerGraphics.setColour(UnfocusedGray);
+        layerGraphics.fillRoundedRectangle(bounds, 6.0f);
+
+        layerGraphics.setFont(juce::FontOptions(11.0f));
+
+        // Decades and their halves, labelled at the decades.
+        for (float decade : { 10.0f, 100.0f, 1000.0f, 10000.0f })
+        {
+            for (float multiple : { 1.0f, 2.0f, 5.0f })
+            {
+                const float frequency = decade * multiple;
+
+                if (frequency < SpectrumAnalyzer::MinFrequencyHz || frequency > SpectrumAnalyzer::MaxFrequencyHz)
+                    continue;
+
+                const float x = bounds.getX() + frequencyToProportion(frequency) * bounds.getWidth();
+
+                layerGraphics.setColour(FocusedGray.withAlpha(multiple == 1.0f ? 0.35f : 0.15f));
+                layerGraphics.drawVerticalLine(juce::roundToInt(x), bounds.getY(), bounds.getBottom());
+
+                if (multiple == 1.0f)
+                {
+                    const juce::String label = frequency >= 1000.0f ? juce::String(frequency / 1000.0f) + "k"
+                                                                    : juce::String(frequency);
+
+                    layerGraphics.setColour(FocusedGray);
+                    layerGraphics.drawText(label, juce::roundToInt(x) + 3, static_cast<int>(bounds.getBottom()) - 16,
+                        40, 14, juce::Justification::centredLeft);
+                }
+            }
+        }
+
+        for (float decibels = 0.0f; decibels > MinDecibels; decibels -= 12.0f)
+        {
+            const float y = bounds.getY() + (1.0f - decibelsToProportion(decibels)) * bounds.getHeight();
+
+            layerGraphics.setColour(FocusedGray.withAlpha(decibels == 0.0f ? 0.35f : 0.15f));
+            layerGraphics.drawHorizontalLine(juce::roundToInt(y), bounds.getX(), bounds.getRight());
+
+            layerGraphics.setColour(FocusedGray);
+            layerGraphics.drawText(juce::String(juce::roundToInt(decibels)) + " dB",
+                static_cast<int>(bounds.getX()) + 4, juce::roundToInt(y) + 1, 50, 14, juce::Justification::centredLeft);
+        }
+
+        layerGraphics.setColour(AccentGray.brighter(0.3f));
+        layerGraphics.drawRoundedRectangle(bounds.reduced(0.5f), 6.0f, 1.0f);
+    });
+
+    if (spectrumPath.isEmpty())
+        return;
+
+    juce::Graphics::ScopedSaveState saveState(graphics);
+    graphics.reduceClipRegion(plotArea);
+
+    juce::Path fillPath(spectrumPath);
+    fillPath.lineTo(static_cast<float>(plotArea.getRight()), static_cast<float>(plotArea.getBottom()));
+    fillPath.lineTo(static_cast<float>(plotArea.getX()), static_cast<float>(plotArea.getBottom()));
+    fillPath.closeSubPath();
+
+    graphics.setColour(ThemePink.withAlpha(0.18f));
+    graphics.fillPath(fillPath);
+
+    graphics.setColour(ThemePink);
+    graphics.strokePath(spectrumPath, juce::PathStrokeType(1.5f, juce::PathStrokeType::curved));
+}
+
+void SpectrumView::resized()
+{
+    auto bounds = getLocalBounds();
+
+    tapButtons.setBounds(bounds.removeFromTop(26).removeFromRight(270));
+
+    rebuildSpectrumPath();
+}
+
+bool SpectrumView::AdvanceAnimation(double)
+{
+    if (!isShowing())
+    {
+        analyzer.SetActive(false);
+        return false;
+    }
+
+    if (!analyzer.PullFrame())
+        return true;
+
+    const SpectrumAnalyzer::Frame& frame = analyzer.GetFrame();
+
+    // Frames still in flight from before a tap change.
+    if (frame.Tap != analyzer.GetTapPoint())
+        return true;
+
+    bandDecibels = frame.BandDecibels;
+
+    rebuildSpectrumPath();
+    repaint(getPlotArea());
+
+    return true;
+}
+
+void SpectrumView::updateScheduling()
+{
+    const bool showing = isShowing();
+
+    analyzer.SetActive(showing);
+
+    if (showing)
+        StartAnimating(*this);
+    else
+        StopAnimating();
+}
+
+void SpectrumView::rebuildSpectrumPath()
+{
+    spectrumPath.clear();
+
+    const auto plotArea = getPlotArea().toFloat();
+
+    if (plotArea.isEmpty())
+        return;
+
+    for (int bandIndex = 0; bandIndex < SpectrumAnalyzer::NumBands; ++bandIndex)
+    {
+        const float x = plotArea.getX()
+            + frequencyToProportion(SpectrumAnalyzer::GetBandFrequency(bandIndex)) * plotArea.getWidth();
+
+        const float y = plotArea.getY()
+            + (1.0f - decibelsToProportion(bandDecibels[static_cast<size_t>(bandIndex)])) * plotArea.getHeight();
+
+        if (bandIndex == 0)
+            spectrumPath.startNewSubPath(x, y);
+        else
+            spectrumPath.lineTo(x, y);
+    }
+}
+
+juce::Rectangle<int> SpectrumView::getPlotArea() const
+{
+    return getLocalBounds().withTrimmedTop(34);
+}
+
+float SpectrumView::frequencyToProportion(float frequencyHz)
+{
+    return std::log(frequencyHz / SpectrumAnalyzer::MinFrequencyHz)
+        / std::log(SpectrumAnalyzer::MaxFrequencyHz / SpectrumAnalyzer::MinFrequencyHz);
+}
+
+float SpectrumView::decibelsToProportion(float decibels)
+{
+    return juce::jlimit(0.0f, 1.0f, (decibels - MinDecibels) / (MaxDecibels - MinDecibels));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "../Filters/SpectrumAnalyzer.h"
+#include "AnimationScheduler.h"
+#include "../Utils/CachedLayer.h"
+#include "../Utils/SegmentedButton.h"
+
+// Log-frequency spectrum of the wet chain, with a selector for the tap point.
+//
+// Only switches the analyzer on while it is on screen, so the audio thread does no
+// extra copying unless someone is looking. Paints frames the analyzer has already
+// finished on its background thread; the grid is a cached layer.
+class SpectrumView : public juce::Component,
+                     private AnimationScheduler::Client
+{
+public:
+    explicit SpectrumView(SpectrumAnalyzer& analyzerToShow);
+    ~SpectrumView() override;
+
+    void paint(juce::Graphics& graphics) override;
+    void resized() override;
+
+private:
+    // Tab pages hide whole subtrees, which Component::visibilityChanged() doesn't report.
+    class ShowingWatcher : public juce::ComponentMovementWatcher
+    {
+    public:
+        explicit ShowingWatcher(SpectrumView& view)
+            : juce::ComponentMovementWatcher(&view), owner(view) {}
+
+        void componentMovedOrResized(bool, bool) override {}
+        void componentPeerChanged() override { owner.updateScheduling(); }
+        void componentVisibilityChanged() override { owner.updateScheduling(); }
+
+    private:
+        SpectrumView& owner;
+    };
+
+    static constexpr float MinDecibels = -84.0f;
+    static constexpr float MaxDecibels = 6.0f;
+
+    bool AdvanceAnimation(double frameTimeSeconds) override;
+
+    void updateScheduling();
+    void rebuildSpectrumPath();
+
+    juce::Rectangle<int> getPlotArea() const;
+    static float frequencyToProportion(float frequencyHz);
+    static float decibelsToProportion(float decibels);
+
+    SpectrumAnalyzer& analyzer;
+
+    SegmentedButton tapButtons { juce::StringArray { "Pre Damp", "Post Damp", "Post Dist" } };
+
+    CachedLayer gridLayer;
+
+    std::array<float, SpectrumAnalyzer::NumBands> bandDecibels {};
+    juce::Path spectrumPath;
+
+    ShowingWatcher showingWatcher { *this };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumView)
+};
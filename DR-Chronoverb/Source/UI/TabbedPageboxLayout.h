@@ -2,12 +2,15 @@
 
 #include "../PluginEditor.h"
 #include "PitchPageLayout.h"
+#include "SpectrumView.h"
+#include "TapeWobbleScope.h"
 
 class TabbedPageBoxLayout
 {
 public:
+    // Pages are filled on first view; buildDistortionPage receives the distortion page.
     void CreatePageBoxLayout(juce::Component& parent, UIHelpers uiHelpers, AudioPluginAudioProcessor& processorRef,
-        int x, int y, int width, int height)
+        int x, int y, int width, int height, std::function<void(juce::Component&)> buildDistortionPage)
     {
         TabbedPageBoxMain = std::make_unique<TabbedPageBox>();
 
@@ -19,13 +22,35 @@ public:
         DistortionPage = std::make_unique<juce::Component>();
         TapePage = std::make_unique<juce::Component>();
         GranularPage = std::make_unique<juce::Component>();
+        SpectrumPage = std::make_unique<juce::Component>();
+
+        TabbedPageBoxMain->AddTab("Pitch", PitchPage.get(), [this, uiHelpers, &processorRef]()
+        {
+            PitchLayout.CreatePitchPageLayout(*PitchPage, uiHelpers, processorRef);
+        });
+
+        TabbedPageBoxMain->AddTab("Distortion", DistortionPage.get(), [this, buildDistortionPage]()
+        {
+            if (buildDistortionPage != nullptr)
+                buildDistortionPage(*DistortionPage);
+        });
+
+        TabbedPageBoxMain->AddTab("Tape", TapePage.get(), [this, &processorRef]()
+        {
+            TapeScope = std::make_unique<TapeWobbleScope>(processorRef.DelayReverb.TapeLeftRight->GetWobbleLfo(),
+                *processorRef.parameters.getRawParameterValue("tapeWobbleDepth"));
+            TapePage->addAndMakeVisible(*TapeScope);
+            TapeScope->setBounds(TapePage->getLocalBounds().reduced(20, 14).removeFromTop(160));
+        });
 
-        TabbedPageBoxMain->AddTab("Pitch", PitchPage.get());
-        TabbedPageBoxMain->AddTab("Distortion", DistortionPage.get());
-        TabbedPageBoxMain->AddTab("Tape", TapePage.get());
         TabbedPageBoxMain->AddTab("Granular", GranularPage.get());
 
-        PitchLayout.CreatePitchPageLayout(*PitchPage, uiHelpers, processorRef);
+        TabbedPageBoxMain->AddTab("Spectrum", SpectrumPage.get(), [this, &processorRef]()
+        {
+            Spectrum = std::make_unique<SpectrumView>(*processorRef.DelayReverb.WetSpectrum);
+            SpectrumPage->addAndMakeVisible(*Spectrum);
+            Spectrum->setBounds(SpectrumPage->getLocalBounds().reduced(20, 14));
+        });
     }
 
     std::unique_ptr<TabbedPageBox> TabbedPageBoxMain;
@@ -35,7 +60,10 @@ public:
     std::unique_ptr<juce::Component> DistortionPage;
     std::unique_ptr<juce::Component> TapePage;
     std::unique_ptr<juce::Component> GranularPage;
+    std::unique_ptr<juce::Component> SpectrumPage;
 
     // Layouts
     PitchPageLayout PitchLayout;
+    std::unique_ptr<SpectrumView> Spectrum;
+    std::unique_ptr<TapeWobbleScope> TapeScope;
 };
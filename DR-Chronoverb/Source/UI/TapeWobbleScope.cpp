@@ -0,0 +1,125 @@
+#include "TapeWobbleScope.h"
+#include "PaintProfiler.h"
+#include "../Utils/Theme.h"
+
+TapeWobbleScope::TapeWobbleScope(const TapeWobbleLfo& lfoToShow, const std::atomic<float>& depthParameter)
+    : lfo(lfoToShow), depth(depthParameter)
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+void TapeWobbleScope::paint(juce::Graphics& graphics)
+{
+    DR_PROFILE_PAINT("TapeWobbleScope");
+
+    const auto plotArea = getPlotArea();
+
+    frameLayer.Draw(graphics, getLocalBounds(), [this, plotArea](juce::Graphics& layerGraphics)
+    {
+        const auto bounds = getLocalBounds().toFloat();
+        const auto plot = plotArea.toFloat();
+
+        layerGraphics.setColour(UnfocusedGray);
+        layerGraphics.fillRoundedRectangle(bounds, 6.0f);
+
+        layerGraphics.setColour(FocusedGray.withAlpha(0.15f));
+        layerGraphics.drawHorizontalLine(juce::roundToInt(plot.getCentreY()), plot.getX(), plot.getRight());
+
+        layerGraphics.setFont(juce::FontOptions(11.0f));
+        layerGraphics.setColour(FocusedGray);
+        layerGraphics.drawText("Lookback", plotArea.withHeight(14), juce::Justification::centredLeft);
+        layerGraphics.drawText("Lookahead", plotArea.withHeight(14), juce::Justification::centredRight);
+
+        layerGraphics.setColour(AccentGray.brighter(0.3f));
+        layerGraphics.drawRoundedRectangle(bounds.reduced(0.5f), 6.0f, 1.0f);
+    });
+
+    const int lookbackSamples = lfo.GetLookbackSamples();
+    const int spanSamples = lookbackSamples + lfo.GetLookaheadSamples();
+
+    if (spanSamples > 0)
+    {
+        const float playheadX = static_cast<float>(plotArea.getX())
+            + static_cast<float>(plotArea.getWidth()) * static_cast<float>(lookbackSamples) / static_cast<float>(spanSamples);
+
+        graphics.setColour(FocusedGray.withAlpha(0.6f));
+        graphics.drawVerticalLine(juce::roundToInt(playheadX), static_cast<float>(plotArea.getY()),
+            static_cast<float>(plotArea.getBottom()));
+    }
+
+    graphics.setColour(ThemePink);
+    graphics.strokePath(wavePath, juce::PathStrokeType(1.5f, juce::PathStrokeType::curved));
+}
+
+void TapeWobbleScope::resized()
+{
+    rebuildWavePath();
+}
+
+bool TapeWobbleScope::AdvanceAnimation(double frameTimeSeconds)
+{
+    if (!isShowing())
+        return false;
+
+    if (frameTimeSeconds - lastFrameTimeSeconds < 1.0 / MaxFrameRateHz)
+        return true;
+
+    lastFrameTimeSeconds = frameTimeSeconds;
+
+    // A stopped transport or an unchanged depth leaves the picture as it is.
+    if (lfo.GetNowPosition() == lastNowPosition && depth.load(std::memory_order_relaxed) == lastDepth)
+        return true;
+
+    rebuildWavePath();
+    repaint(getPlotArea());
+
+    return true;
+}
+
+void TapeWobbleScope::updateScheduling()
+{
+    if (isShowing())
+        StartAnimating(*this);
+    else
+        StopAnimating();
+}
+
+// One point per pixel column, sampled from the ring between now - lookback and now + lookahead.
+void TapeWobbleScope::rebuildWavePath()
+{
+    wavePath.clear();
+
+    lastNowPosition = lfo.GetNowPosition();
+    lastDepth = depth.load(std::memory_order_relaxed);
+
+    const auto plotArea = getPlotArea().toFloat();
+    const int numColumns = juce::roundToInt(plotArea.getWidth());
+
+    if (numColumns < 2)
+        return;
+
+    const int64_t firstPosition = lastNowPosition - lfo.GetLookbackSamples();
+    const double samplesPerColumn = static_cast<double>(lfo.GetLookbackSamples() + lfo.GetLookaheadSamples())
+                                  / static_cast<double>(numColumns - 1);
+
+    const float halfHeight = plotArea.getHeight() * 0.5f;
+
+    for (int column = 0; column < numColumns; ++column)
+    {
+        const int64_t position = firstPosition + static_cast<int64_t>(column * samplesPerColumn);
+        const float value = juce::jlimit(-1.0f, 1.0f, lfo.GetValueAt(position) * lastDepth);
+
+        const float x = plotArea.getX() + static_cast<float>(column);
+        const float y = plotArea.getCentreY() - value * halfHeight;
+
+        if (column == 0)
+            wavePath.startNewSubPath(x, y);
+        else
+            wavePath.lineTo(x, y);
+    }
+}
+
+juce::Rectangle<int> TapeWobbleScope::getPlotArea() const
+{
+    return getLocalBounds().reduced(8);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "../Filters/NewDelayReverb/Stages/Tape/TapeWobbleLfo.h"
+#include "AnimationScheduler.h"
+#include "../Utils/CachedLayer.h"
+
+// The tape wobble LFO around the current playback position, scaled by the wobble depth:
+// the LFO's whole lookback to the left of the playhead line and its lookahead to the right.
+//
+// Reads the LFO's own ring, which the audio thread fills ahead of time anyway, so showing it
+// costs the audio thread nothing. Ticks only while on screen; the frame is a cached layer.
+class TapeWobbleScope : public juce::Component,
+                        private AnimationScheduler::Client
+{
+public:
+    static constexpr double MaxFrameRateHz = 30.0;
+
+    // depthParameter is the raw tapeWobbleDepth value (0..1).
+    TapeWobbleScope(const TapeWobbleLfo& lfoToShow, const std::atomic<float>& depthParameter);
+
+    void paint(juce::Graphics& graphics) override;
+    void resized() override;
+
+private:
+    // Tab pages hide whole subtrees, which Component::visibilityChanged() doesn't report.
+    class ShowingWatcher : public juce::ComponentMovementWatcher
+    {
+    public:
+        explicit ShowingWatcher(TapeWobbleScope& scope)
+            : juce::ComponentMovementWatcher(&scope), owner(scope) {}
+
+        void componentMovedOrResized(bool, bool) override {}
+        void componentPeerChanged() override { owner.updateScheduling(); }
+        void componentVisibilityChanged() override { owner.updateScheduling(); }
+
+    private:
+        TapeWobbleScope& owner;
+    };
+
+    bool AdvanceAnimation(double frameTimeSeconds) override;
+
+    void updateScheduling();
+    void rebuildWavePath();
+
+    juce::Rectangle<int> getPlotArea() const;
+
+    const TapeWobbleLfo& lfo;
+    const std::atomic<float>& depth;
+
+    CachedLayer frameLayer;
+    juce::Path wavePath;
+
+    int64_t lastNowPosition = -1;
+    float lastDepth = -1.0f;
+    double lastFrameTimeSeconds = 0.0;
+
+    ShowingWatcher showingWatcher { *this };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TapeWobbleScope)
+};
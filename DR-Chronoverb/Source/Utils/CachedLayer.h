@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+// Static paint layer rendered once into an image and blitted on later paints.
+//
+// The image is rendered at the context's physical pixel scale, so it stays sharp on
+// high-DPI displays. It is re-rendered when the area size or the scale changes; owners
+// call Invalidate() when anything else the layer depends on (colours, state) changes.
+class CachedLayer
+{
+public:
+    // renderLayer(juce::Graphics&) draws in the area's local coordinates (origin at 0, 0).
+    template <typename RenderFunction>
+    void Draw(juce::Graphics& graphics, juce::Rectangle<int> area, RenderFunction&& renderLayer)
+    {
+        if (area.isEmpty())
+            return;
+
+        const float scale = graphics.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (!image.isValid() || area.getWidth() != width || area.getHeight() != height || scale != renderedScale)
+        {
+            width = area.getWidth();
+            height = area.getHeight();
+            renderedScale = scale;
+
+            image = juce::Image(juce::Image::ARGB,
+                                juce::jmax(1, juce::roundToInt(std::ceil(static_cast<float>(width) * scale))),
+                                juce::jmax(1, juce::roundToInt(std::ceil(static_cast<float>(height) * scale))),
+                                true);
+
+            juce::Graphics imageGraphics(image);
+            imageGraphics.addTransform(juce::AffineTransform::scale(scale));
+            renderLayer(imageGraphics);
+        }
+
+        graphics.drawImageTransformed(image,
+            juce::AffineTransform::scale(1.0f / renderedScale)
+                .translated(static_cast<float>(area.getX()), static_cast<float>(area.getY())));
+    }
+
+    void Invalidate()
+    {
+        image = {};
+    }
+
+private:
+    juce::Image image;
+
+    int width = 0;
+    int height = 0;
+    float renderedScale = 0.0f;
+};
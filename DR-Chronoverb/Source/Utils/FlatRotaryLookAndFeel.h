@@ -1,9 +1,13 @@
 #pragma once
 
+#include <map>
+#include <tuple>
+
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "Theme.h"
 #include "FlatLabel.h"
 #include "ThemeContext.h"
+#include "PaintProfiler.h"
 
 class FlatRotaryLookAndFeel : public juce::LookAndFeel_V4
 {
@@ -19,6 +23,8 @@ public:
         float RotaryEndAngle,
         juce::Slider& Slider) override
     {
+        DR_PROFILE_PAINT("FlatRotaryLookAndFeel::drawRotarySlider");
+
         juce::Rectangle<float> Bounds(static_cast<float>(X),
                                       static_cast<float>(Y),
                                       static_cast<float>(Width),
@@ -36,13 +42,9 @@ public:
         Graphics.fillEllipse(Center.x - Radius, Center.y - Radius, Diameter, Diameter);
 
         // Arc value
-        float Angle = RotaryStartAngle + SliderPosProportional * (RotaryEndAngle - RotaryStartAngle);
-        juce::Path ValueArc;
-        ValueArc.addArc(Center.x - Radius, Center.y - Radius, Diameter, Diameter,
-                        RotaryStartAngle, Angle, true);
-
         Graphics.setColour(ThemePink);
-        Graphics.strokePath(ValueArc, juce::PathStrokeType(6.0f));
+        Graphics.fillPath(getValueArc(Diameter, SliderPosProportional, RotaryStartAngle, RotaryEndAngle),
+                          juce::AffineTransform::translation(Center));
     }
 
     juce::Label* createSliderTextBox(juce::Slider& Slider) override
@@ -102,4 +104,38 @@ public:
                                4.0f,
                                1.0f);
     }
+
+private:
+    // Value arcs are stroked once per knob size and quantised position, then reused on
+    // every repaint; 512 steps over the travel is well under a pixel at knob sizes.
+    static constexpr int ArcValueSteps = 512;
+    static constexpr size_t MaxCachedArcs = 4096;
+
+    using ArcKey = std::tuple<int, int, float, float>;
+
+    // Stroked outline of the arc, centred on the origin.
+    const juce::Path& getValueArc(float diameter, float proportion, float startAngle, float endAngle)
+    {
+        const int step = juce::roundToInt(juce::jlimit(0.0f, 1.0f, proportion) * static_cast<float>(ArcValueSteps));
+        const ArcKey key { juce::roundToInt(diameter * 2.0f), step, startAngle, endAngle };
+
+        if (const auto found = valueArcs.find(key); found != valueArcs.end())
+            return found->second;
+
+        if (valueArcs.size() >= MaxCachedArcs)
+            valueArcs.clear();
+
+        const float radius = diameter / 2.0f;
+        const float angle = startAngle + (static_cast<float>(step) / static_cast<float>(ArcValueSteps)) * (endAngle - startAngle);
+
+        juce::Path arc;
+        arc.addArc(-radius, -radius, diameter, diameter, startAngle, angle, true);
+
+        auto& strokedArc = valueArcs[key];
+        juce::PathStrokeType(6.0f).createStrokedPath(strokedArc, arc);
+
+        return strokedArc;
+    }
+
+    std::map<ArcKey, juce::Path> valueArcs;
 };
\ No newline at end of file
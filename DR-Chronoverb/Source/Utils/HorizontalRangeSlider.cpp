@@ -1,4 +1,5 @@
 #include "HorizontalRangeSlider.h"
+#include "PaintProfiler.h"
 
 HorizontalRangeSlider::HorizontalRangeSlider(float MinimumValue, float MaximumValue)
     : minValue(MinimumValue),
@@ -152,6 +153,8 @@ HorizontalRangeSlider::ActiveThumb HorizontalRangeSlider::getActiveThumb() const
 
 void HorizontalRangeSlider::paint(juce::Graphics& GraphicsContext)
 {
+    DR_PROFILE_PAINT("HorizontalRangeSlider");
+
     const juce::Rectangle<float> bounds = getLocalBounds().toFloat();
 
     GraphicsContext.setColour(ThemeContext::GetAdjustedColour(AccentGray, *this));
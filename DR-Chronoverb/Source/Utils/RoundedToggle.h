@@ -4,6 +4,8 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "Theme.h"
 #include "ThemeContext.h"
+#include "PaintProfiler.h"
+#include "AnimationScheduler.h"
 
 // RoundedToggle
 // - A themed, rounded toggle switch supporting horizontal or vertical orientation.
@@ -25,12 +27,13 @@
 // Animation:
 // - The internal animated position (AnimationPosition) interpolates toward the logical state (ToggleState).
 // - Call setAnimationSpeed() to adjust responsiveness.
+// - Frames come from the editor's AnimationScheduler; the toggle is only ticked while moving.
 //
 // Accessibility / Keyboard:
 // - Space / Return toggles state when the component has focus.
 // - setWantsKeyboardFocus(true) is enabled by default.
 //
-class RoundedToggle : public juce::Component, private juce::Timer
+class RoundedToggle : public juce::Component, private AnimationScheduler::Client
 {
 public:
     enum class Orientation
@@ -55,11 +58,7 @@ public:
 
         ToggleState = NewState;
 
-        if (!IsAnimating)
-        {
-            startTimerHz(AnimationTimerFrequencyHz);
-            IsAnimating = true;
-        }
+        startAnimation();
 
         if (NotificationType == juce::sendNotificationAsync || NotificationType == juce::sendNotification)
         {
@@ -78,11 +77,7 @@ public:
 
         ToggleState = NewState;
 
-        if (!IsAnimating)
-        {
-            startTimerHz(AnimationTimerFrequencyHz);
-            IsAnimating = true;
-        }
+        startAnimation();
 
         repaint();
     }
@@ -145,6 +140,8 @@ public:
     // ----------------------------- JUCE Overrides -----------------------------
     void paint(juce::Graphics& GraphicsContext) override
     {
+        DR_PROFILE_PAINT("RoundedToggle");
+
         const juce::Rectangle<int> LocalBounds = getLocalBounds();
 
         if (LocalBounds.getWidth() <= 2 || LocalBounds.getHeight() <= 2)
@@ -312,22 +309,40 @@ public:
 
 private:
     // ----------------------------- Animation -----------------------------
-    void timerCallback() override
+    void startAnimation()
+    {
+        LastFrameTimeSeconds = -1.0;
+
+        // Not on an editor yet, so there's nothing to animate; just land on the new state.
+        if (!StartAnimating(*this))
+            AnimationPosition = (ToggleState ? 1.0f : 0.0f);
+    }
+
+    bool AdvanceAnimation(double FrameTimeSeconds) override
     {
-        // Smooth animation toward target state.
+        // Smooth animation toward target state. The smoothing coefficient is per 60 Hz
+        // frame, so the speed doesn't depend on the display's refresh rate.
         const float TargetValue = (ToggleState ? 1.0f : 0.0f);
 
-        AnimationPosition = AnimationPosition + AnimationSmoothingCoefficient * (TargetValue - AnimationPosition);
+        const double ElapsedFrames = (LastFrameTimeSeconds < 0.0)
+            ? 1.0
+            : juce::jlimit(0.0, 8.0, (FrameTimeSeconds - LastFrameTimeSeconds) * ReferenceFrameRateHz);
+
+        LastFrameTimeSeconds = FrameTimeSeconds;
+
+        const float Step = 1.0f - std::pow(1.0f - AnimationSmoothingCoefficient, static_cast<float>(ElapsedFrames));
+        AnimationPosition = AnimationPosition + Step * (TargetValue - AnimationPosition);
+
+        repaint();
 
         // Close enough: stop.
         if (std::abs(AnimationPosition - TargetValue) < 0.0005f)
         {
             AnimationPosition = TargetValue;
-            stopTimer();
-            IsAnimating = false;
+            return false;
         }
 
-        repaint();
+        return true;
     }
 
     // ----------------------------- Internal State -----------------------------
@@ -336,8 +351,8 @@ private:
 
     float AnimationPosition = 0.0f;
     float AnimationSmoothingCoefficient = 0.2f;
-    bool IsAnimating = false;
-    int AnimationTimerFrequencyHz = 60;
+    double LastFrameTimeSeconds = -1.0;
+    static constexpr double ReferenceFrameRateHz = 60.0;
 
     float TrackPaddingPixels = 4.0f;
     bool ThumbShadowEnabled = true;
@@ -9,6 +9,7 @@
 
 #include "Theme.h"
 #include "ThemeContext.h"
+#include "PaintProfiler.h"
 
 // SegmentedButton
 // - A header-only, rounded segmented control with an arbitrary number of options.
@@ -196,6 +197,8 @@ public:
 
     void paint(juce::Graphics& graphicsContext) override
     {
+        DR_PROFILE_PAINT("SegmentedButton");
+
         const juce::Rectangle<int> bounds = getLocalBounds();
 
         const juce::Colour adjustedAccentGray =
@@ -216,45 +219,13 @@ public:
         const int numberOfOptions = options.size();
         const bool vertical = isVertical();
 
-        const float totalMajor = vertical
-            ? static_cast<float>(bounds.getHeight())
-            : static_cast<float>(bounds.getWidth());
-
-        const float totalMinor = vertical
-            ? static_cast<float>(bounds.getWidth())
-            : static_cast<float>(bounds.getHeight());
-
-        const float segmentMajorFloat =
-            totalMajor / static_cast<float>(numberOfOptions);
+        if (segments.size() != static_cast<size_t>(numberOfOptions) || segmentsBounds != bounds)
+            rebuildSegments(bounds);
 
         for (int optionIndex = 0; optionIndex < numberOfOptions; ++optionIndex)
         {
-            const float majorPosition =
-                vertical
-                    ? static_cast<float>(bounds.getY())
-                        + std::floor(segmentMajorFloat * static_cast<float>(optionIndex))
-                    : static_cast<float>(bounds.getX())
-                        + std::floor(segmentMajorFloat * static_cast<float>(optionIndex));
-
-            const float majorSize =
-                (optionIndex == numberOfOptions - 1)
-                    ? (vertical
-                        ? static_cast<float>(bounds.getBottom()) - majorPosition
-                        : static_cast<float>(bounds.getRight()) - majorPosition)
-                    : std::floor(segmentMajorFloat);
-
-            const juce::Rectangle<float> segmentBounds =
-                vertical
-                    ? juce::Rectangle<float>(
-                        static_cast<float>(bounds.getX()),
-                        majorPosition,
-                        totalMinor,
-                        majorSize)
-                    : juce::Rectangle<float>(
-                        majorPosition,
-                        static_cast<float>(bounds.getY()),
-                        majorSize,
-                        totalMinor);
+            const juce::Rectangle<float>& segmentBounds = segments[static_cast<size_t>(optionIndex)].Bounds;
+            const juce::Path& segmentPath = segments[static_cast<size_t>(optionIndex)].Shape;
 
             const bool isFirst = (optionIndex == 0);
             const bool isLast = (optionIndex == numberOfOptions - 1);
@@ -263,37 +234,6 @@ public:
             const juce::Colour fillColour =
                 isSelected ? ThemePink : adjustedAccentGray;
 
-            juce::Path segmentPath;
-
-            if (vertical)
-            {
-                // top segment rounded on top, bottom segment rounded on bottom
-                segmentPath.addRoundedRectangle(segmentBounds.getX(),
-                                                segmentBounds.getY(),
-                                                segmentBounds.getWidth(),
-                                                segmentBounds.getHeight(),
-                                                cornerRadius,
-                                                cornerRadius,
-                                                isFirst,
-                                                isFirst,
-                                                isLast,
-                                                isLast);
-            }
-            else
-            {
-                // left segment rounded on left, right segment rounded on right
-                segmentPath.addRoundedRectangle(segmentBounds.getX(),
-                                                segmentBounds.getY(),
-                                                segmentBounds.getWidth(),
-                                                segmentBounds.getHeight(),
-                                                cornerRadius,
-                                                cornerRadius,
-                                                isFirst,
-                                                isLast,
-                                                isFirst,
-                                                isLast);
-            }
-
             graphicsContext.setColour(fillColour);
             graphicsContext.fillPath(segmentPath);
 
@@ -676,6 +616,95 @@ private:
         labelFont = juce::Font(fontOptions);
     }
 
+    // Segment rectangles and rounded shapes only change with size and layout, so they're
+    // built here rather than on every paint.
+    void rebuildSegments(const juce::Rectangle<int>& bounds)
+    {
+        const int numberOfOptions = options.size();
+        const bool vertical = isVertical();
+
+        const float totalMajor = vertical
+            ? static_cast<float>(bounds.getHeight())
+            : static_cast<float>(bounds.getWidth());
+
+        const float totalMinor = vertical
+            ? static_cast<float>(bounds.getWidth())
+            : static_cast<float>(bounds.getHeight());
+
+        const float segmentMajorFloat =
+            totalMajor / static_cast<float>(numberOfOptions);
+
+        segments.clear();
+        segments.reserve(static_cast<size_t>(numberOfOptions));
+        segmentsBounds = bounds;
+
+        for (int optionIndex = 0; optionIndex < numberOfOptions; ++optionIndex)
+        {
+            const float majorPosition =
+                vertical
+                    ? static_cast<float>(bounds.getY())
+                        + std::floor(segmentMajorFloat * static_cast<float>(optionIndex))
+                    : static_cast<float>(bounds.getX())
+                        + std::floor(segmentMajorFloat * static_cast<float>(optionIndex));
+
+            const float majorSize =
+                (optionIndex == numberOfOptions - 1)
+                    ? (vertical
+                        ? static_cast<float>(bounds.getBottom()) - majorPosition
+                        : static_cast<float>(bounds.getRight()) - majorPosition)
+                    : std::floor(segmentMajorFloat);
+
+            const juce::Rectangle<float> segmentBounds =
+                vertical
+                    ? juce::Rectangle<float>(
+                        static_cast<float>(bounds.getX()),
+                        majorPosition,
+                        totalMinor,
+                        majorSize)
+                    : juce::Rectangle<float>(
+                        majorPosition,
+                        static_cast<float>(bounds.getY()),
+                        majorSize,
+                        totalMinor);
+
+            const bool isFirst = (optionIndex == 0);
+            const bool isLast = (optionIndex == numberOfOptions - 1);
+
+            juce::Path segmentPath;
+
+            if (vertical)
+            {
+                // top segment rounded on top, bottom segment rounded on bottom
+                segmentPath.addRoundedRectangle(segmentBounds.getX(),
+                                                segmentBounds.getY(),
+                                                segmentBounds.getWidth(),
+                                                segmentBounds.getHeight(),
+                                                cornerRadius,
+                                                cornerRadius,
+                                                isFirst,
+                                                isFirst,
+                                                isLast,
+                                                isLast);
+            }
+            else
+            {
+                // left segment rounded on left, right segment rounded on right
+                segmentPath.addRoundedRectangle(segmentBounds.getX(),
+                                                segmentBounds.getY(),
+                                                segmentBounds.getWidth(),
+                                                segmentBounds.getHeight(),
+                                                cornerRadius,
+                                                cornerRadius,
+                                                isFirst,
+                                                isLast,
+                                                isFirst,
+                                                isLast);
+            }
+
+            segments.push_back({ segmentBounds, std::move(segmentPath) });
+        }
+    }
+
     int getIndexFromPosition(float position) const
     {
         const int numberOfOptions = options.size();
@@ -712,4 +741,13 @@ private:
 
     bool blockSelectionCallback = false;
     Orientation orientation = Orientation::Horizontal;
+
+    struct Segment
+    {
+        juce::Rectangle<float> Bounds;
+        juce::Path Shape;
+    };
+
+    std::vector<Segment> segments;
+    juce::Rectangle<int> segmentsBounds;
 };
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <functional>
+#include <utility>
+
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "Theme.h"
 #include "ThemeContext.h"
+#include "PaintProfiler.h"
 
 // TODO: Implement ability for tabs to have custom colors
 class TabbedPageBox : public juce::Component, public DarkeningThemeProvider
@@ -12,6 +16,9 @@ public:
     {
         juce::String Title;
         juce::Component* PageComponent = nullptr;
+
+        // Fills the page the first time it is shown, then is released.
+        std::function<void()> BuildPage;
     };
 
     TabbedPageBox()
@@ -21,13 +28,17 @@ public:
 
     ~TabbedPageBox() override = default;
 
-    void AddTab(const juce::String& tabTitle, juce::Component* pageComponent)
+    // buildPage is optional. When given, the page's controls and attachments are only
+    // created once the tab is first selected, so unvisited pages cost nothing to open.
+    void AddTab(const juce::String& tabTitle, juce::Component* pageComponent,
+                std::function<void()> buildPage = nullptr)
     {
         jassert(pageComponent != nullptr);
 
         Tab newTab;
         newTab.Title = tabTitle;
         newTab.PageComponent = pageComponent;
+        newTab.BuildPage = std::move(buildPage);
 
         tabs.push_back(newTab);
 
@@ -58,6 +69,11 @@ public:
         repaint();
     }
 
+    int GetNumTabs() const
+    {
+        return static_cast<int>(tabs.size());
+    }
+
     int GetSelectedTabIndex() const
     {
         return selectedTabIndex;
@@ -131,6 +147,8 @@ public:
 
     void paint(juce::Graphics& graphics) override
     {
+        DR_PROFILE_PAINT("TabbedPageBox");
+
         const juce::Rectangle<int> panelBounds = getPanelBounds();
 
         graphics.setColour(AccentGray.darker(0.25f));
@@ -239,8 +257,21 @@ private:
     {
         for (int tabIndex = 0; tabIndex < static_cast<int>(tabs.size()); ++tabIndex)
         {
-            if (tabs[static_cast<size_t>(tabIndex)].PageComponent != nullptr)
-                tabs[static_cast<size_t>(tabIndex)].PageComponent->setVisible(tabIndex == selectedTabIndex);
+            Tab& tab = tabs[static_cast<size_t>(tabIndex)];
+
+            if (tab.PageComponent == nullptr)
+                continue;
+
+            const bool isSelected = (tabIndex == selectedTabIndex);
+
+            // Builders lay out against the page's bounds, so size it first.
+            if (isSelected && tab.BuildPage != nullptr)
+            {
+                tab.PageComponent->setBounds(getContentBounds());
+                std::exchange(tab.BuildPage, nullptr)();
+            }
+
+            tab.PageComponent->setVisible(isSelected);
         }
     }
 };
@@ -2,6 +2,8 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "Theme.h"
+#include "PaintProfiler.h"
+#include "AnimationScheduler.h"
 
 class TooltipClient
 {
@@ -29,8 +31,10 @@ public:
     }
 };
 
+// Idle until TooltipStateChanged() is called (wire it to the client's tooltip-state
+// callback), then ticks on the editor's AnimationScheduler until the fade has settled.
 class TooltipOverlay : public juce::Component,
-                       private juce::Timer
+                       private AnimationScheduler::Client
 {
 public:
     explicit TooltipOverlay(TooltipClient& TooltipClientReference)
@@ -38,44 +42,35 @@ public:
     {
         setInterceptsMouseClicks(false, false);
         setAlwaysOnTop(true);
-        startTimerHz(60);
     }
 
     ~TooltipOverlay() override = default;
 
+    void TooltipStateChanged()
+    {
+        StartAnimating(*this);
+    }
+
     void paint(juce::Graphics& GraphicsContext) override
     {
+        DR_PROFILE_PAINT("TooltipOverlay");
+
         if (currentAlpha <= 0.001f)
             return;
 
         if (cachedTargetBounds.isEmpty() || cachedTooltipText.isEmpty())
             return;
 
-        constexpr float tooltipHeight = 24.0f;
-        constexpr float tooltipHorizontalPadding = 8.0f;
-        constexpr float tooltipGap = 10.0f;
-        constexpr float tooltipCornerRadius = 6.0f;
-
-        juce::Font tooltipFont(14.0f);
+        juce::Font tooltipFont(TooltipFontHeight);
         GraphicsContext.setFont(tooltipFont);
 
-        const float tooltipWidth =
-            juce::GlyphArrangement::getStringWidth(tooltipFont, cachedTooltipText)
-            + (tooltipHorizontalPadding * 2.0f);
-
-        juce::Rectangle<float> tooltipBounds = CalculateTooltipBounds(
-            tooltipWidth,
-            tooltipHeight,
-            tooltipGap);
-
-        const juce::Rectangle<float> overlayBounds = getLocalBounds().toFloat();
-        ClampTooltipBoundsToOverlay(tooltipBounds, overlayBounds);
+        const juce::Rectangle<float> tooltipBounds = CalculateTooltipArea();
 
         const juce::Colour backgroundColour = juce::Colours::black.withAlpha(currentAlpha);
         const juce::Colour textColour = juce::Colours::white.withAlpha(currentAlpha);
 
         GraphicsContext.setColour(backgroundColour);
-        GraphicsContext.fillRoundedRectangle(tooltipBounds, tooltipCornerRadius);
+        GraphicsContext.fillRoundedRectangle(tooltipBounds, TooltipCornerRadius);
 
         GraphicsContext.setColour(textColour);
         GraphicsContext.drawFittedText(
@@ -86,8 +81,18 @@ public:
     }
 
 private:
-    void timerCallback() override
+    static constexpr float TooltipHeight = 24.0f;
+    static constexpr float TooltipHorizontalPadding = 8.0f;
+    static constexpr float TooltipGap = 10.0f;
+    static constexpr float TooltipCornerRadius = 6.0f;
+    static constexpr float TooltipFontHeight = 14.0f;
+
+    bool AdvanceAnimation(double FrameTimeSeconds) override
     {
+        juce::ignoreUnused(FrameTimeSeconds);
+
+        const juce::Rectangle<float> previousArea = CalculateTooltipArea();
+
         const bool shouldShowTooltip = trackedTooltipClient.ShouldShowTooltip();
         bool shouldRepaint = false;
 
@@ -138,8 +143,31 @@ private:
             }
         }
 
+        // Only the old and new tooltip areas need repainting, not the whole overlay.
         if (shouldRepaint)
-            repaint();
+            repaint(previousArea.getUnion(CalculateTooltipArea()).getSmallestIntegerContainer().expanded(1));
+
+        return currentAlpha != targetAlpha;
+    }
+
+    // Where the tooltip sits for the cached target, or empty when there is nothing to show.
+    juce::Rectangle<float> CalculateTooltipArea() const
+    {
+        if (cachedTargetBounds.isEmpty() || cachedTooltipText.isEmpty())
+            return {};
+
+        const float tooltipWidth =
+            juce::GlyphArrangement::getStringWidth(juce::Font(TooltipFontHeight), cachedTooltipText)
+            + (TooltipHorizontalPadding * 2.0f);
+
+        juce::Rectangle<float> tooltipBounds = CalculateTooltipBounds(
+            tooltipWidth,
+            TooltipHeight,
+            TooltipGap);
+
+        ClampTooltipBoundsToOverlay(tooltipBounds, getLocalBounds().toFloat());
+
+        return tooltipBounds;
     }
 
     juce::Rectangle<float> CalculateTooltipBounds(
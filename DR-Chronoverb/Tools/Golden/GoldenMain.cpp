@@ -0,0 +1,227 @@
+// ChronoverbGolden: golden-output regression test. Renders fixed stereo signals through
+// Chronoverb (defaults, extreme settings, each distortion type) and the legacy
+// NewDelayReverb with a fixed seed, and checks every channel against the goldens in
+// Tools/Golden/Goldens within a RenderComparison budget set per case below. Exits with 1
+// on any failure, a missing golden included. Registered with CTest when built with
+// -DDR_BUILD_TOOLS=ON, once Tools/Golden/Goldens exists.
+//
+//   ChronoverbGolden --goldens=<folder> [--update] [--allow-missing]
+//
+// --update rewrites the goldens from this build; see Utils/GoldenRegression.h at the repo
+// root.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include "GoldenRegression.h"
+#include "../GridRender/HeadlessParameterHost.h"
+#include "../Measurement/RenderComparison.h"
+#include "../../Source/Filters/Chronoverb.h"
+#include "../../Source/Filters/NewDelayReverb.h"
+
+namespace
+{
+    using Settings = std::vector<std::pair<juce::String, float>>;
+
+    constexpr double SampleRate = 48000.0;
+    constexpr int BlockSize = 512;
+    constexpr uint32_t RandomSeed = static_cast<uint32_t>(RandomStream::DefaultSeed);
+
+    //region Input signals
+    // A unit impulse on both channels at sample 0, then silence.
+    juce::AudioBuffer<float> makeImpulse(double seconds)
+    {
+        juce::AudioBuffer<float> buffer(2, static_cast<int>(seconds * SampleRate));
+        buffer.clear();
+
+        buffer.setSample(0, 0, 1.0f);
+        buffer.setSample(1, 0, 1.0f);
+
+        return buffer;
+    }
+
+    // 100 ms of white noise at -6 dBFS, different on each channel so the two sides of the
+    // chain get different material, then silence.
+    juce::AudioBuffer<float> makeNoiseBurst(double seconds)
+    {
+        juce::AudioBuffer<float> buffer(2, static_cast<int>(seconds * SampleRate));
+        buffer.clear();
+
+        const int burstSamples = std::min(buffer.getNumSamples(), static_cast<int>(0.1 * SampleRate));
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            RandomStream noise(RandomStream::DeriveSeed(RandomSeed, static_cast<uint32_t>(channel)));
+            noise.FillBipolar(buffer.getWritePointer(channel), burstSamples, 0.5f);
+        }
+
+        return buffer;
+    }
+
+    // A 220 Hz sine on the left and 330 Hz on the right at -6 dBFS, for the distortion cases.
+    juce::AudioBuffer<float> makeTones(double seconds)
+    {
+        juce::AudioBuffer<float> buffer(2, static_cast<int>(seconds * SampleRate));
+
+        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        {
+            const double time = sample / SampleRate;
+
+            buffer.setSample(0, sample, 0.5f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 220.0 * time)));
+            buffer.setSample(1, sample, 0.5f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 330.0 * time)));
+        }
+
+        return buffer;
+    }
+    //endregion
+
+    // In place, block by block, as a host would.
+    template <typename Processor>
+    void processInBlocks(Processor& processor, juce::AudioBuffer<float>& buffer)
+    {
+        for (int blockStart = 0; blockStart < buffer.getNumSamples(); blockStart += BlockSize)
+        {
+            const int blockSamples = std::min(BlockSize, buffer.getNumSamples() - blockStart);
+
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, blockStart, blockSamples);
+            processor.ProcessBlock(block);
+        }
+    }
+
+    // Plain values, as in Source/ParameterEntries.h; everything else keeps its default.
+    juce::AudioBuffer<float> renderChronoverb(juce::AudioBuffer<float> buffer, const Settings& settings)
+    {
+        HeadlessParameterHost host;
+
+        for (const auto& [parameterID, value] : settings)
+        {
+            const bool known = host.SetPlainValue(parameterID, value);
+            jassert(known);
+            juce::ignoreUnused(known);
+        }
+
+        // Same order as the plugin's prepareToPlay: parameters first, then DSP prep.
+        Chronoverb chronoverb;
+        PluginParameterRegistry::ApplyAll(chronoverb, host.Parameters);
+        chronoverb.SetRandomSeed(RandomSeed);
+        chronoverb.PrepareToPlay(SampleRate);
+
+        processInBlocks(chronoverb, buffer);
+        return buffer;
+    }
+
+    // The legacy engine has no parameter tree and seeds itself from RandomStream::DefaultSeed.
+    juce::AudioBuffer<float> renderNewDelayReverb(juce::AudioBuffer<float> buffer)
+    {
+        NewDelayReverb reverb;
+        reverb.PrepareToPlay(SampleRate);
+
+        reverb.SetDelayTime(0.25f);
+        reverb.SetFeedbackTime(3.0f);
+        reverb.SetDiffusionAmount(0.7f);
+        reverb.SetDiffusionSize(0.5f);
+        reverb.SetDiffusionQuality(6);
+        reverb.SetDryVolume(1.0f);
+        reverb.SetWetVolume(0.8f);
+        reverb.SetLowpassCutoff(0.6f);
+        reverb.SetHighpassCutoff(0.1f);
+        reverb.SetStereoSpread(0.5f);
+
+        processInBlocks(reverb, buffer);
+        return buffer;
+    }
+
+    // For budgets on signals that don't decay, where an RT60 fit means nothing.
+    constexpr float NoRt60Check = std::numeric_limits<float>::infinity();
+
+    // The RenderComparison budget on each channel.
+    GoldenRegression::ChannelComparator withinBudget(const RenderComparison::Budget& budget)
+    {
+        return [budget](const std::vector<float>& golden, const std::vector<float>& rendered, double sampleRate)
+        {
+            const auto result = RenderComparison::Compare(golden, rendered, sampleRate);
+
+            juce::String details = "max abs " + juce::String(result.MaxAbsoluteError)
+                                 + "  spectral " + juce::String(result.SpectralDistanceDecibels) + " dB";
+
+            if (budget.MaxRt60DriftSeconds != NoRt60Check)
+                details << "  RT60 drift " << juce::String(result.Rt60DriftSeconds) << " s";
+
+            return GoldenRegression::ChannelResult { result.IsWithin(budget), details };
+        };
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ScopedNoDenormals noDenormals;
+
+    const juce::ArgumentList arguments(argc, argv);
+    const auto options = GoldenRegression::ReadOptions(arguments);
+
+    if (!options.has_value())
+        return 1;
+
+    // Every case passes its own budget.
+    GoldenRegression::Checker checker(*options);
+
+    // Budget: the RenderComparison defaults. One impulse through the default chain has little
+    // to accumulate rounding, and the tail decays far enough within 1.5 s for an RT60 fit.
+    checker.CheckAudio("Chronoverb_Impulse_Defaults", renderChronoverb(makeImpulse(1.5), {}), SampleRate,
+                       withinBudget({ 1.0e-5f, 0.1f, 0.02f }));
+
+    // Every stage in the loop: long feedback, full diffusion, random pitch sequence, filters
+    // after the delay, ducking, wide stereo, and tape with its (seeded) noise.
+    // Budget: rounding differences recirculate through 10 s of feedback and the pitch
+    // shifter's grains, so sample errors grow along the tail; allow 10x the sample error and
+    // twice the spectral distance, and a looser RT60 for the long decay.
+    checker.CheckAudio("Chronoverb_Noise_Extreme", renderChronoverb(makeNoiseBurst(1.5),
+    {
+        { "delayTime",         40.0f },
+        { "feedbackTime",      10.0f },
+        { "diffusionAmount",    1.0f },
+        { "diffusionSize",      1.0f },
+        { "stereoSpread",       1.0f },
+        { "filtersOrder",       2.0f },
+        { "lowPassCutoff",   3000.0f },
+        { "highPassCutoff",   200.0f },
+        { "duckAmount",         0.5f },
+        { "pitchSequence",      2.0f },
+        { "pitchWetMix",        0.5f },
+        { "tapeEnabled",        1.0f },
+        { "tapeNoiseEnabled",   1.0f }
+    }), SampleRate, withinBudget({ 1.0e-4f, 0.2f, 0.05f }));
+
+    // Each distortion type on the dry path alone, with the wet path muted.
+    // Budget: a short, steady, feedback-free waveshaper path, so both sample and spectral
+    // error stay tight; steady tones don't decay, so no RT60 check.
+    const RenderComparison::Budget distortionBudget { 1.0e-6f, 0.05f, NoRt60Check };
+
+    const juce::StringArray distortionTypes { "Heat", "Chebyshev", "HardClip", "Tube" };
+
+    for (int type = 0; type < distortionTypes.size(); ++type)
+    {
+        checker.CheckAudio("Chronoverb_Distortion_" + distortionTypes[type], renderChronoverb(makeTones(0.25),
+        {
+            { "wetVolume",                0.0f },
+            { "distortionMod1Enabled",    1.0f },
+            { "distortionMod1Type",       static_cast<float>(type) },
+            { "distortionMod1Target",     0.0f },
+            { "distortionMod1Drive",      0.8f },
+            { "distortionMod1Mix",        1.0f }
+        }), SampleRate, withinBudget(distortionBudget));
+    }
+
+    // Budget: as Chronoverb_Noise_Extreme; a noise burst into a 3 s feedback loop.
+    checker.CheckAudio("NewDelayReverb_Noise", renderNewDelayReverb(makeNoiseBurst(1.5)), SampleRate,
+                       withinBudget({ 1.0e-4f, 0.2f, 0.05f }));
+
+    return checker.GetExitCode();
+}
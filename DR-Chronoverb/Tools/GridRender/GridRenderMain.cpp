@@ -0,0 +1,353 @@
+// ChronoverbGridRender: renders Chronoverb impulse responses over a parameter grid, one
+// Chronoverb per worker thread, and writes their metrics as comparison JSON.
+//
+//   ChronoverbGridRender <parameterID>=<values> ... [--output-dir=grid_renders] [--seconds=10]
+//                        [--rate=48000] [--threads=<cores>] [--baseline=<point name>] [--write-irs]
+//                        [--seed=<n>]
+//
+// Values are a comma list (0.15,0.5,1) or start:end:count (0:1:11). Parameter IDs are the
+// plugin's (Source/ParameterEntries.h) and values are plain (ms, seconds, choice index).
+// Anything not on the grid keeps its plugin default, except dryVolume, which defaults to 0
+// so the IR is the wet chain only.
+//
+//   ChronoverbGridRender diffusionAmount=0.15,0.5,1 delayTime=503,1000 diffusionSize=1
+//                        --baseline=DiffAmt_0.5_503ms_DiffSize_1_WetOnly
+//
+// writes grid_report.json with every point and, with --baseline, one
+// ir_compare_<baseline>_vs_<point>.json per other point, as in Docs/Deelay_IR_Comparisons.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include "HeadlessParameterHost.h"
+#include "../Measurement/ImpulseResponseMetrics.h"
+#include "../Measurement/WavFiles.h"
+#include "../../Source/Filters/Chronoverb.h"
+
+namespace
+{
+    struct Axis
+    {
+        juce::String ParameterID;
+        std::vector<float> Values;
+    };
+
+    struct GridPoint
+    {
+        juce::String Name;
+        std::vector<std::pair<juce::String, float>> Settings;
+    };
+
+    struct RenderSettings
+    {
+        double SampleRate = 48000.0;
+        double Seconds = 10.0;
+        uint32_t RandomSeed = static_cast<uint32_t>(RandomStream::DefaultSeed);
+        bool WriteImpulseResponses = false;
+        juce::File OutputDirectory;
+    };
+
+    constexpr int BlockSize = 512;
+
+    int fail(const juce::String& message)
+    {
+        std::cerr << message << std::endl;
+        return 1;
+    }
+
+    // "0.15,0.5,1" or "start:end:count"
+    std::optional<std::vector<float>> parseValues(const juce::String& text)
+    {
+        std::vector<float> values;
+
+        if (text.containsChar(':'))
+        {
+            const juce::StringArray parts = juce::StringArray::fromTokens(text, ":", "");
+
+            if (parts.size() != 3 || parts[2].getIntValue() < 1)
+                return std::nullopt;
+
+            const float start = parts[0].getFloatValue();
+            const float end = parts[1].getFloatValue();
+            const int count = parts[2].getIntValue();
+
+            for (int index = 0; index < count; ++index)
+                values.push_back(count == 1 ? start
+                                            : start + (end - start) * static_cast<float>(index) / static_cast<float>(count - 1));
+
+            return values;
+        }
+
+        for (const auto& token : juce::StringArray::fromTokens(text, ",", ""))
+            if (token.trim().isNotEmpty())
+                values.push_back(token.trim().getFloatValue());
+
+        if (values.empty())
+            return std::nullopt;
+
+        return values;
+    }
+
+    // Shortest decimal form: 0.5, 1, 503.
+    juce::String formatValue(float value)
+    {
+        juce::String text(value, 3);
+
+        if (text.containsChar('.'))
+            text = text.trimCharactersAtEnd("0").trimCharactersAtEnd(".");
+
+        return text;
+    }
+
+    // Names follow Docs/Deelay_IR_Comparisons, e.g. "DiffAmt_0.5_503ms_DiffSize_1_WetOnly".
+    juce::String getLabel(const juce::String& parameterID, float value)
+    {
+        if (parameterID == "delayTime")       return formatValue(value) + "ms";
+        if (parameterID == "diffusionAmount") return "DiffAmt_" + formatValue(value);
+        if (parameterID == "diffusionSize")   return "DiffSize_" + formatValue(value);
+        if (parameterID == "dryVolume")       return value <= 0.0f ? "WetOnly" : "Dry_" + formatValue(value);
+
+        return parameterID + "_" + formatValue(value);
+    }
+
+    // Cartesian product, first axis slowest.
+    std::vector<GridPoint> expandGrid(const std::vector<Axis>& axes)
+    {
+        std::vector<GridPoint> points { GridPoint {} };
+
+        for (const auto& axis : axes)
+        {
+            std::vector<GridPoint> expanded;
+            expanded.reserve(points.size() * axis.Values.size());
+
+            for (const auto& point : points)
+            {
+                for (const float value : axis.Values)
+                {
+                    GridPoint next = point;
+                    next.Settings.emplace_back(axis.ParameterID, value);
+                    expanded.push_back(std::move(next));
+                }
+            }
+
+            points = std::move(expanded);
+        }
+
+        for (auto& point : points)
+        {
+            juce::StringArray labels;
+            juce::String dryLabel;
+
+            for (const auto& [parameterID, value] : point.Settings)
+            {
+                if (parameterID == "dryVolume")
+                    dryLabel = getLabel(parameterID, value);
+                else
+                    labels.add(getLabel(parameterID, value));
+            }
+
+            labels.add(dryLabel);
+            point.Name = labels.joinIntoString("_");
+        }
+
+        return points;
+    }
+
+    // Runs on a pool thread. Every call builds its own parameter tree and Chronoverb, so
+    // points never share DSP state and a worker holds at most one instance at a time.
+    ImpulseResponseMetrics::Metrics renderPoint(const GridPoint& point, const RenderSettings& settings)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        HeadlessParameterHost host;
+
+        for (const auto& [parameterID, value] : point.Settings)
+            host.SetPlainValue(parameterID, value);
+
+        // Same order as the plugin's prepareToPlay: parameters first, then DSP prep.
+        Chronoverb chronoverb;
+        PluginParameterRegistry::ApplyAll(chronoverb, host.Parameters);
+        chronoverb.SetRandomSeed(settings.RandomSeed);
+        chronoverb.PrepareToPlay(settings.SampleRate);
+
+        const int totalSamples = static_cast<int>(std::round(settings.Seconds * settings.SampleRate));
+        std::vector<float> impulseResponse(static_cast<size_t>(totalSamples), 0.0f);
+
+        juce::AudioBuffer<float> block(2, BlockSize);
+
+        for (int blockStart = 0; blockStart < totalSamples; blockStart += BlockSize)
+        {
+            const int blockSamples = std::min(BlockSize, totalSamples - blockStart);
+
+            block.setSize(2, blockSamples, false, false, true);
+            block.clear();
+
+            if (blockStart == 0)
+            {
+                block.setSample(0, 0, 1.0f);
+                block.setSample(1, 0, 1.0f);
+            }
+
+            chronoverb.ProcessBlock(block);
+
+            // Mono: the mean of left and right
+            float* destination = impulseResponse.data() + blockStart;
+            juce::FloatVectorOperations::addWithMultiply(destination, block.getReadPointer(0), 0.5f, blockSamples);
+            juce::FloatVectorOperations::addWithMultiply(destination, block.getReadPointer(1), 0.5f, blockSamples);
+        }
+
+        if (settings.WriteImpulseResponses)
+            WavFiles::WriteMono(settings.OutputDirectory.getChildFile(point.Name + ".wav"), impulseResponse, settings.SampleRate);
+
+        return ImpulseResponseMetrics::Analyze(impulseResponse, settings.SampleRate);
+    }
+
+    bool writeReport(const juce::File& file, const juce::StringArray& names,
+        const std::vector<ImpulseResponseMetrics::Metrics>& results)
+    {
+        return file.replaceWithText(juce::JSON::toString(ImpulseResponseMetrics::MakeReport(names, results)));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // The parameter trees start timers, which need a message manager (never dispatched here).
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList arguments(argc, argv);
+
+    std::vector<Axis> axes;
+
+    for (const auto& argument : arguments.arguments)
+    {
+        if (argument.isOption())
+            continue;
+
+        const auto values = parseValues(argument.text.fromFirstOccurrenceOf("=", false, false));
+
+        if (!argument.text.containsChar('=') || !values.has_value())
+            return fail("Couldn't parse grid axis \"" + argument.text + "\" (expected <parameterID>=<values>)");
+
+        axes.push_back({ argument.text.upToFirstOccurrenceOf("=", false, false), *values });
+    }
+
+    if (axes.empty())
+        return fail("usage: ChronoverbGridRender <parameterID>=<values> ... [--output-dir=] [--seconds=10] "
+                    "[--rate=48000] [--threads=] [--baseline=<point name>] [--write-irs] [--seed=]");
+
+    {
+        HeadlessParameterHost host;
+
+        for (const auto& axis : axes)
+            if (host.Parameters.getParameter(axis.ParameterID) == nullptr)
+                return fail("Unknown parameter \"" + axis.ParameterID + "\" (IDs are in Source/ParameterEntries.h)");
+    }
+
+    const bool hasDryAxis = std::any_of(axes.begin(), axes.end(),
+        [](const Axis& axis) { return axis.ParameterID == "dryVolume"; });
+
+    if (!hasDryAxis)
+        axes.push_back({ "dryVolume", { 0.0f } });
+
+    RenderSettings settings;
+
+    if (arguments.containsOption("--rate"))
+        settings.SampleRate = arguments.getValueForOption("--rate").getDoubleValue();
+
+    if (arguments.containsOption("--seconds"))
+        settings.Seconds = arguments.getValueForOption("--seconds").getDoubleValue();
+
+    if (!HeadlessParameterHost::ReadRandomSeedOption(arguments, settings.RandomSeed))
+        return fail("--seed must be a whole number from 0 to 4294967295");
+
+    settings.WriteImpulseResponses = arguments.containsOption("--write-irs");
+    settings.OutputDirectory = arguments.containsOption("--output-dir")
+        ? arguments.getFileForOption("--output-dir")
+        : juce::File::getCurrentWorkingDirectory().getChildFile("grid_renders");
+
+    if (settings.SampleRate <= 0.0 || settings.Seconds <= 0.0)
+        return fail("--rate and --seconds must be positive");
+
+    if (!settings.OutputDirectory.createDirectory())
+        return fail("Couldn't create " + settings.OutputDirectory.getFullPathName());
+
+    const int numThreads = arguments.containsOption("--threads")
+        ? std::max(1, arguments.getValueForOption("--threads").getIntValue())
+        : juce::SystemStats::getNumCpus();
+
+    const std::vector<GridPoint> points = expandGrid(axes);
+
+    juce::StringArray names;
+
+    for (const auto& point : points)
+        names.add(point.Name);
+
+    const juce::String baseline = arguments.getValueForOption("--baseline");
+
+    if (baseline.isNotEmpty() && !names.contains(baseline))
+        return fail("--baseline \"" + baseline + "\" isn't a grid point");
+
+    //region Render
+    std::vector<ImpulseResponseMetrics::Metrics> results(points.size());
+    std::atomic<int> numFinished { 0 };
+
+    const double startMilliseconds = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        juce::ThreadPool pool(numThreads);
+
+        for (size_t pointIndex = 0; pointIndex < points.size(); ++pointIndex)
+        {
+            pool.addJob([&, pointIndex]
+            {
+                results[pointIndex] = renderPoint(points[pointIndex], settings);
+                numFinished.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        while (numFinished.load(std::memory_order_acquire) < static_cast<int>(points.size()))
+        {
+            juce::Thread::sleep(250);
+            std::cout << "\rRendered " << numFinished.load() << " / " << points.size() << std::flush;
+        }
+    }
+
+    const double elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startMilliseconds) * 0.001;
+
+    std::cout << "\rRendered " << points.size() << " points on " << numThreads << " threads in "
+              << juce::String(elapsedSeconds, 1) << " s" << std::endl;
+    //endregion
+
+    //region Reports
+    if (!writeReport(settings.OutputDirectory.getChildFile("grid_report.json"), names, results))
+        return fail("Couldn't write grid_report.json");
+
+    if (baseline.isNotEmpty())
+    {
+        const int baselineIndex = names.indexOf(baseline);
+
+        for (int pointIndex = 0; pointIndex < names.size(); ++pointIndex)
+        {
+            if (pointIndex == baselineIndex)
+                continue;
+
+            const juce::File file = settings.OutputDirectory.getChildFile(
+                "ir_compare_" + baseline + "_vs_" + names[pointIndex] + ".json");
+
+            if (!writeReport(file, { baseline, names[pointIndex] },
+                    { results[static_cast<size_t>(baselineIndex)], results[static_cast<size_t>(pointIndex)] }))
+                return fail("Couldn't write " + file.getFullPathName());
+        }
+    }
+    //endregion
+
+    return 0;
+}
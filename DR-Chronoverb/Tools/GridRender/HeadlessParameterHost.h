@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include "../../Source/PluginParameterRegistry.h"
+
+// Just enough of an AudioProcessor to own the plugin's parameter tree, so the offline tools
+// apply settings through PluginParameterRegistry exactly the way the plugin does (including
+// every parameter they don't mention, which keeps its plugin default).
+class HeadlessParameterHost : public juce::AudioProcessor
+{
+public:
+    HeadlessParameterHost()
+        : Parameters(*this, nullptr, "PARAMS", PluginParameterRegistry::CreateLayout())
+    {
+    }
+
+    // Plain (unnormalised) value: milliseconds, seconds, a choice index, 0/1 for toggles.
+    // Returns false for an unknown parameter ID.
+    bool SetPlainValue(const juce::String& parameterID, float plainValue)
+    {
+        auto* parameter = Parameters.getParameter(parameterID);
+
+        if (parameter == nullptr)
+            return false;
+
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+        return true;
+    }
+
+    // The tools' --seed option, for Chronoverb::SetRandomSeed. Leaves seed alone without the
+    // option; returns false when the value isn't a whole number that fits in 32 bits, rather
+    // than silently truncating it.
+    static bool ReadRandomSeedOption(const juce::ArgumentList& arguments, uint32_t& seed)
+    {
+        if (!arguments.containsOption("--seed"))
+            return true;
+
+        const juce::String seedText = arguments.getValueForOption("--seed").trim();
+
+        // Ten digits bound the value well inside int64, so getLargeIntValue can't overflow.
+        if (seedText.isEmpty() || !seedText.containsOnly("0123456789") || seedText.length() > 10)
+            return false;
+
+        const juce::int64 value = seedText.getLargeIntValue();
+
+        if (value > static_cast<juce::int64>(std::numeric_limits<uint32_t>::max()))
+            return false;
+
+        seed = static_cast<uint32_t>(value);
+        return true;
+    }
+
+    juce::AudioProcessorValueTreeState Parameters;
+
+    //region AudioProcessor (unused)
+    const juce::String getName() const override { return "HeadlessParameterHost"; }
+
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+    //endregion
+};
@@ -0,0 +1,501 @@
+#include "ImpulseResponseMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numeric>
+
+#include <juce_dsp/juce_dsp.h>
+
+namespace ImpulseResponseMetrics
+{
+namespace
+{
+    constexpr float BroadbandLowHz = 200.0f;
+    constexpr float BroadbandHighHz = 8000.0f;
+
+    constexpr float EchoDensityWindowMilliseconds = 20.0f;
+    constexpr float EchoDensityHopMilliseconds = 5.0f;
+
+    // Smallest power of two holding numSamples, as an FFT order.
+    int getFftOrder(size_t numSamples)
+    {
+        int order = 1;
+
+        while ((size_t(1) << order) < numSamples)
+            ++order;
+
+        return order;
+    }
+
+    // Real signal -> bins 0..N/2 as std::complex.
+    std::vector<std::complex<float>> forwardTransform(const std::vector<float>& signal, int order)
+    {
+        const size_t size = size_t(1) << order;
+
+        std::vector<float> data(size * 2, 0.0f);
+        std::copy_n(signal.begin(), std::min(signal.size(), size), data.begin());
+
+        juce::dsp::FFT(order).performRealOnlyForwardTransform(data.data(), true);
+
+        std::vector<std::complex<float>> bins(size / 2 + 1);
+
+        for (size_t bin = 0; bin < bins.size(); ++bin)
+            bins[bin] = { data[bin * 2], data[bin * 2 + 1] };
+
+        return bins;
+    }
+
+    // Bins 0..N/2 -> real signal of N samples.
+    std::vector<float> inverseTransform(const std::vector<std::complex<float>>& bins, int order)
+    {
+        const size_t size = size_t(1) << order;
+
+        std::vector<float> data(size * 2, 0.0f);
+
+        for (size_t bin = 0; bin < size; ++bin)
+        {
+            const std::complex<float> value = bin <= size / 2 ? bins[bin] : std::conj(bins[size - bin]);
+
+            data[bin * 2] = value.real();
+            data[bin * 2 + 1] = value.imag();
+        }
+
+        juce::dsp::FFT(order).performRealOnlyInverseTransform(data.data());
+
+        data.resize(size);
+        return data;
+    }
+
+    // Brick-wall band limit in the frequency domain, back to the IR's length.
+    std::vector<float> bandLimit(const std::vector<std::complex<float>>& spectrum, int order, size_t length,
+        double sampleRate, float lowHz, float highHz)
+    {
+        const size_t size = size_t(1) << order;
+        const double hzPerBin = sampleRate / static_cast<double>(size);
+
+        std::vector<std::complex<float>> masked(spectrum.size());
+
+        for (size_t bin = 0; bin < spectrum.size(); ++bin)
+        {
+            const double frequency = static_cast<double>(bin) * hzPerBin;
+
+            if (frequency >= lowHz && frequency < highHz)
+                masked[bin] = spectrum[bin];
+        }
+
+        std::vector<float> filtered = inverseTransform(masked, order);
+        filtered.resize(length);
+
+        return filtered;
+    }
+
+    // Decay rate from a T20 fit (-5 to -25 dB), falling back to T10 for short or noisy tails.
+    float fitRt60(const std::vector<float>& decayDecibels, double sampleRate)
+    {
+        auto firstBelow = [&decayDecibels](float level)
+        {
+            const auto found = std::find_if(decayDecibels.begin(), decayDecibels.end(),
+                [level](float value) { return value <= level; });
+
+            return static_cast<size_t>(std::distance(decayDecibels.begin(), found));
+        };
+
+        const size_t fitStart = firstBelow(-5.0f);
+        size_t fitEnd = firstBelow(-25.0f);
+
+        if (fitEnd >= decayDecibels.size())
+            fitEnd = firstBelow(-15.0f);
+
+        if (fitEnd >= decayDecibels.size() || fitEnd <= fitStart + 1)
+            return 0.0f;
+
+        // Least-squares slope in dB per sample.
+        const double count = static_cast<double>(fitEnd - fitStart);
+        const double meanX = 0.5 * static_cast<double>(fitStart + fitEnd - 1);
+
+        double meanY = 0.0;
+
+        for (size_t i = fitStart; i < fitEnd; ++i)
+            meanY += decayDecibels[i];
+
+        meanY /= count;
+
+        double covariance = 0.0;
+        double variance = 0.0;
+
+        for (size_t i = fitStart; i < fitEnd; ++i)
+        {
+            const double dx = static_cast<double>(i) - meanX;
+
+            covariance += dx * (decayDecibels[i] - meanY);
+            variance += dx * dx;
+        }
+
+        const double slope = covariance / variance;
+
+        if (slope >= 0.0)
+            return 0.0f;
+
+        return static_cast<float>(-60.0 / slope / sampleRate);
+    }
+
+    double energyBetween(const std::vector<float>& signal, size_t start, size_t end)
+    {
+        end = std::min(end, signal.size());
+
+        double energy = 0.0;
+
+        for (size_t i = start; i < end; ++i)
+            energy += static_cast<double>(signal[i]) * signal[i];
+
+        return energy;
+    }
+
+    // Every step-th value of a profile.
+    std::vector<float> decimate(const std::vector<float>& values, size_t step)
+    {
+        std::vector<float> decimated;
+
+        for (size_t i = 0; i < values.size(); i += std::max<size_t>(1, step))
+            decimated.push_back(values[i]);
+
+        return decimated;
+    }
+
+    double roundTo(double value, int decimals)
+    {
+        const double scale = std::pow(10.0, decimals);
+        return std::round(value * scale) / scale;
+    }
+
+    juce::String getBandName(float centreHz)
+    {
+        if (centreHz >= 1000.0f)
+            return juce::String(juce::roundToInt(centreHz / 1000.0f)) + "kHz";
+
+        return juce::String(juce::roundToInt(centreHz)) + "Hz";
+    }
+
+    juce::var makeBandObject(const std::array<float, NumOctaveBands>& values, int decimals)
+    {
+        auto* bands = new juce::DynamicObject();
+
+        for (int band = 0; band < NumOctaveBands; ++band)
+            bands->setProperty(getBandName(OctaveBandCentresHz[static_cast<size_t>(band)]),
+                roundTo(values[static_cast<size_t>(band)], decimals));
+
+        return juce::var(bands);
+    }
+
+    juce::var makeArray(const std::vector<float>& values, int decimals)
+    {
+        juce::Array<juce::var> array;
+
+        for (float value : values)
+            array.add(roundTo(value, decimals));
+
+        return array;
+    }
+
+    // B - A for numbers, key by key for band objects.
+    juce::var difference(const juce::var& a, const juce::var& b)
+    {
+        if (auto* objectA = a.getDynamicObject())
+        {
+            auto* result = new juce::DynamicObject();
+
+            for (const auto& property : objectA->getProperties())
+                result->setProperty(property.name, difference(property.value, b[property.name]));
+
+            return juce::var(result);
+        }
+
+        return roundTo(static_cast<double>(b) - static_cast<double>(a), 3);
+    }
+}
+
+std::vector<float> Deconvolve(const std::vector<float>& capture, const std::vector<float>& stimulus,
+    int lengthSamples)
+{
+    const int order = getFftOrder(capture.size() + stimulus.size());
+
+    const auto captureSpectrum = forwardTransform(capture, order);
+    const auto stimulusSpectrum = forwardTransform(stimulus, order);
+
+    float maxPower = 0.0f;
+
+    for (const auto& bin : stimulusSpectrum)
+        maxPower = std::max(maxPower, std::norm(bin));
+
+    // Keeps bins the stimulus barely excites (outside a sweep's range) from blowing up.
+    const float regularisation = maxPower * 1.0e-6f;
+
+    std::vector<std::complex<float>> responseSpectrum(captureSpectrum.size());
+
+    for (size_t bin = 0; bin < responseSpectrum.size(); ++bin)
+    {
+        responseSpectrum[bin] = captureSpectrum[bin] * std::conj(stimulusSpectrum[bin])
+            / (std::norm(stimulusSpectrum[bin]) + regularisation);
+    }
+
+    std::vector<float> impulseResponse = inverseTransform(responseSpectrum, order);
+    impulseResponse.resize(static_cast<size_t>(std::max(0, lengthSamples)), 0.0f);
+
+    return impulseResponse;
+}
+
+Metrics Analyze(const std::vector<float>& impulseResponse, double sampleRate)
+{
+    Metrics metrics;
+    metrics.SampleRate = sampleRate;
+    metrics.DurationSeconds = static_cast<double>(impulseResponse.size()) / sampleRate;
+
+    if (impulseResponse.empty())
+        return metrics;
+
+    const auto samplesAt = [sampleRate](double milliseconds)
+    {
+        return static_cast<size_t>(std::round(milliseconds * 0.001 * sampleRate));
+    };
+
+    // Level and onset
+    float peak = 0.0f;
+
+    for (float sample : impulseResponse)
+        peak = std::max(peak, std::abs(sample));
+
+    metrics.PeakAmplitudeDecibels = juce::Decibels::gainToDecibels(peak, -200.0f);
+
+    // The onset is the first sample within 20 dB of the peak.
+    const auto onset = std::find_if(impulseResponse.begin(), impulseResponse.end(),
+        [peak](float sample) { return std::abs(sample) >= peak * 0.1f; });
+
+    metrics.PreDelayMilliseconds = static_cast<float>(
+        1000.0 * static_cast<double>(std::distance(impulseResponse.begin(), onset)) / sampleRate);
+
+    // Early / late energy, measured from the start of the response like the hand-made studies.
+    const double totalEnergy = energyBetween(impulseResponse, 0, impulseResponse.size());
+    const double energyTo50 = energyBetween(impulseResponse, 0, samplesAt(50.0));
+    const double energyTo80 = energyBetween(impulseResponse, 0, samplesAt(80.0));
+
+    if (totalEnergy > 0.0)
+    {
+        metrics.DefinitionD50Percent = static_cast<float>(100.0 * energyTo50 / totalEnergy);
+        metrics.ClarityC80Decibels = static_cast<float>(
+            10.0 * std::log10(std::max(energyTo80, 1.0e-30) / std::max(totalEnergy - energyTo80, 1.0e-30)));
+    }
+
+    // Decay
+    metrics.EnergyDecayDecibels = EnergyDecayCurve(impulseResponse);
+
+    const int order = getFftOrder(impulseResponse.size());
+    const auto spectrum = forwardTransform(impulseResponse, order);
+
+    metrics.Rt60BroadbandSeconds = fitRt60(
+        EnergyDecayCurve(bandLimit(spectrum, order, impulseResponse.size(), sampleRate, BroadbandLowHz, BroadbandHighHz)),
+        sampleRate);
+
+    // Octave bands
+    const double hzPerBin = sampleRate / static_cast<double>(size_t(1) << order);
+    const float nyquistHz = static_cast<float>(0.5 * sampleRate);
+
+    for (int band = 0; band < NumOctaveBands; ++band)
+    {
+        const float lowHz = OctaveBandCentresHz[static_cast<size_t>(band)] / juce::MathConstants<float>::sqrt2;
+        const float highHz = std::min(OctaveBandCentresHz[static_cast<size_t>(band)] * juce::MathConstants<float>::sqrt2, nyquistHz);
+
+        if (lowHz >= nyquistHz)
+            continue;
+
+        metrics.Rt60BandSeconds[static_cast<size_t>(band)] = fitRt60(
+            EnergyDecayCurve(bandLimit(spectrum, order, impulseResponse.size(), sampleRate, lowHz, highHz)),
+            sampleRate);
+
+        double magnitudeSum = 0.0;
+        int numBins = 0;
+
+        for (size_t bin = 0; bin < spectrum.size(); ++bin)
+        {
+            const double frequency = static_cast<double>(bin) * hzPerBin;
+
+            if (frequency >= lowHz && frequency < highHz)
+            {
+                magnitudeSum += std::abs(spectrum[bin]);
+                ++numBins;
+            }
+        }
+
+        if (numBins > 0)
+            metrics.BandLevelDecibels[static_cast<size_t>(band)] =
+                juce::Decibels::gainToDecibels(static_cast<float>(magnitudeSum / numBins), -200.0f);
+    }
+
+    // Tone
+    double weightedFrequency = 0.0;
+    double magnitudeTotal = 0.0;
+
+    for (size_t bin = 0; bin < spectrum.size(); ++bin)
+    {
+        const double magnitude = std::abs(spectrum[bin]);
+
+        weightedFrequency += static_cast<double>(bin) * hzPerBin * magnitude;
+        magnitudeTotal += magnitude;
+    }
+
+    if (magnitudeTotal > 0.0)
+        metrics.SpectralCentroidHz = static_cast<float>(weightedFrequency / magnitudeTotal);
+
+    // Echo density
+    const std::vector<float> echoDensity = NormalizedEchoDensity(impulseResponse, sampleRate,
+        EchoDensityWindowMilliseconds, EchoDensityHopMilliseconds);
+
+    const size_t onsetFrame = static_cast<size_t>(metrics.PreDelayMilliseconds / EchoDensityHopMilliseconds);
+
+    for (size_t frame = onsetFrame; frame < echoDensity.size(); ++frame)
+    {
+        if (echoDensity[frame] >= 1.0f)
+        {
+            metrics.MixingTimeMilliseconds = static_cast<float>(frame) * EchoDensityHopMilliseconds;
+            break;
+        }
+    }
+
+    metrics.EnergyDecayDecibels = decimate(metrics.EnergyDecayDecibels, samplesAt(ProfileStepMilliseconds));
+    metrics.EchoDensity = decimate(echoDensity,
+        static_cast<size_t>(ProfileStepMilliseconds / EchoDensityHopMilliseconds));
+
+    return metrics;
+}
+
+std::vector<float> EnergyDecayCurve(const std::vector<float>& impulseResponse)
+{
+    std::vector<float> decayDecibels(impulseResponse.size(), -200.0f);
+
+    double remainingEnergy = energyBetween(impulseResponse, 0, impulseResponse.size());
+    const double totalEnergy = remainingEnergy;
+
+    if (totalEnergy <= 0.0)
+        return decayDecibels;
+
+    for (size_t i = 0; i < impulseResponse.size(); ++i)
+    {
+        decayDecibels[i] = static_cast<float>(10.0 * std::log10(std::max(remainingEnergy / totalEnergy, 1.0e-20)));
+        remainingEnergy -= static_cast<double>(impulseResponse[i]) * impulseResponse[i];
+    }
+
+    return decayDecibels;
+}
+
+std::vector<float> NormalizedEchoDensity(const std::vector<float>& impulseResponse, double sampleRate,
+    float windowMilliseconds, float hopMilliseconds)
+{
+    const int windowSamples = std::max(2, juce::roundToInt(windowMilliseconds * 0.001 * sampleRate));
+    const int hopSamples = std::max(1, juce::roundToInt(hopMilliseconds * 0.001 * sampleRate));
+
+    std::vector<double> window(static_cast<size_t>(windowSamples));
+
+    for (int i = 0; i < windowSamples; ++i)
+        window[static_cast<size_t>(i)] = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (i + 0.5) / windowSamples);
+
+    const double windowSum = std::accumulate(window.begin(), window.end(), 0.0);
+
+    for (double& weight : window)
+        weight /= windowSum;
+
+    // Share of a Gaussian's samples lying beyond one standard deviation.
+    const double gaussianOutsideFraction = std::erfc(1.0 / std::sqrt(2.0));
+
+    std::vector<float> density;
+
+    for (size_t frameStart = 0; frameStart + static_cast<size_t>(windowSamples) <= impulseResponse.size();
+         frameStart += static_cast<size_t>(hopSamples))
+    {
+        double variance = 0.0;
+
+        for (int i = 0; i < windowSamples; ++i)
+        {
+            const double sample = impulseResponse[frameStart + static_cast<size_t>(i)];
+            variance += window[static_cast<size_t>(i)] * sample * sample;
+        }
+
+        const double deviation = std::sqrt(variance);
+        double outsideWeight = 0.0;
+
+        for (int i = 0; i < windowSamples; ++i)
+            if (std::abs(impulseResponse[frameStart + static_cast<size_t>(i)]) > deviation)
+                outsideWeight += window[static_cast<size_t>(i)];
+
+        density.push_back(variance > 0.0 ? static_cast<float>(outsideWeight / gaussianOutsideFraction) : 0.0f);
+    }
+
+    return density;
+}
+
+juce::var ToVar(const Metrics& metrics)
+{
+    auto* object = new juce::DynamicObject();
+
+    object->setProperty("duration_s", roundTo(metrics.DurationSeconds, 3));
+    object->setProperty("sample_rate", juce::roundToInt(metrics.SampleRate));
+    object->setProperty("pre_delay_ms", roundTo(metrics.PreDelayMilliseconds, 2));
+    object->setProperty("peak_amplitude_db", roundTo(metrics.PeakAmplitudeDecibels, 2));
+    object->setProperty("rt60_broadband_s", roundTo(metrics.Rt60BroadbandSeconds, 3));
+    object->setProperty("rt60_bands_s", makeBandObject(metrics.Rt60BandSeconds, 3));
+    object->setProperty("band_levels_db", makeBandObject(metrics.BandLevelDecibels, 2));
+    object->setProperty("clarity_c80_db", roundTo(metrics.ClarityC80Decibels, 2));
+    object->setProperty("definition_d50_pct", roundTo(metrics.DefinitionD50Percent, 2));
+    object->setProperty("spectral_centroid_hz", roundTo(metrics.SpectralCentroidHz, 1));
+    object->setProperty("mixing_time_ms", roundTo(metrics.MixingTimeMilliseconds, 1));
+    object->setProperty("edc_db_100ms", makeArray(metrics.EnergyDecayDecibels, 1));
+    object->setProperty("echo_density_100ms", makeArray(metrics.EchoDensity, 2));
+
+    return juce::var(object);
+}
+
+juce::var MakeReport(const juce::StringArray& names, const std::vector<Metrics>& results)
+{
+    auto* report = new juce::DynamicObject();
+
+    auto* interpretation = new juce::DynamicObject();
+    interpretation->setProperty("pre_delay_ms", "Time from IR start to first peak (wet signal onset)");
+    interpretation->setProperty("rt60_broadband_s", "Broadband RT60: time for 60 dB decay (200 Hz – 8 kHz)");
+    interpretation->setProperty("rt60_bands_s", "Per-octave-band RT60 in seconds");
+    interpretation->setProperty("band_levels_db", "Average magnitude per octave band (from FFT)");
+    interpretation->setProperty("clarity_c80_db", "C80: ratio of early (< 80 ms) to late energy. Higher = clearer/more direct");
+    interpretation->setProperty("definition_d50_pct", "D50: % of total energy arriving in first 50 ms. Higher = drier");
+    interpretation->setProperty("spectral_centroid_hz", "Frequency center of mass (higher = brighter overall tone)");
+    interpretation->setProperty("mixing_time_ms", "Time the normalized echo density first reaches 1 (diffuse tail)");
+    interpretation->setProperty("edc_db_100ms", "Schroeder energy decay curve, every 100 ms");
+    interpretation->setProperty("echo_density_100ms", "Normalized echo density (20 ms window), every 100 ms");
+
+    auto* info = new juce::DynamicObject();
+    info->setProperty("description", "Impulse response comparison — compact LLM-ready metrics");
+    info->setProperty("interpretation", juce::var(interpretation));
+
+    report->setProperty("_info", juce::var(info));
+
+    std::vector<juce::var> resultVars;
+
+    for (size_t i = 0; i < results.size() && static_cast<int>(i) < names.size(); ++i)
+    {
+        resultVars.push_back(ToVar(results[i]));
+        report->setProperty(names[static_cast<int>(i)], resultVars.back());
+    }
+
+    if (resultVars.size() == 2)
+    {
+        auto* diff = new juce::DynamicObject();
+
+        for (const char* key : { "pre_delay_ms", "rt60_broadband_s", "rt60_bands_s", "band_levels_db",
+                                 "clarity_c80_db", "definition_d50_pct", "spectral_centroid_hz", "mixing_time_ms" })
+        {
+            diff->setProperty(key, difference(resultVars[0][key], resultVars[1][key]));
+        }
+
+        report->setProperty("diff (B minus A)", juce::var(diff));
+    }
+
+    return juce::var(report);
+}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+// Offline impulse response analysis shared by the measurement tools.
+//
+// Everything here is plain batch code: allocation is fine, nothing runs on an audio thread.
+// The metric names and units follow the comparison JSON in Docs/Deelay_IR_Comparisons, so
+// tool output can be diffed against the hand-made studies there.
+namespace ImpulseResponseMetrics
+{
+    static constexpr int NumOctaveBands = 8;
+    static constexpr std::array<float, NumOctaveBands> OctaveBandCentresHz =
+    {
+        125.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f
+    };
+
+    struct Metrics
+    {
+        double DurationSeconds = 0.0;
+        double SampleRate = 48000.0;
+
+        float PreDelayMilliseconds = 0.0f;
+        float PeakAmplitudeDecibels = 0.0f;
+
+        // 0 when the decay never falls far enough to fit.
+        float Rt60BroadbandSeconds = 0.0f;
+        std::array<float, NumOctaveBands> Rt60BandSeconds {};
+        std::array<float, NumOctaveBands> BandLevelDecibels {};
+
+        float ClarityC80Decibels = 0.0f;
+        float DefinitionD50Percent = 0.0f;
+        float SpectralCentroidHz = 0.0f;
+
+        // Time the normalized echo density first reaches 1 (a diffuse, Gaussian tail).
+        float MixingTimeMilliseconds = 0.0f;
+
+        // Sampled every ProfileStepMilliseconds.
+        std::vector<float> EnergyDecayDecibels;
+        std::vector<float> EchoDensity;
+    };
+
+    static constexpr float ProfileStepMilliseconds = 100.0f;
+
+    // Recovers an impulse response from a capture of the system's response to a known
+    // stimulus, by regularised spectral division. The result starts where the stimulus
+    // started in the capture and is lengthSamples long.
+    std::vector<float> Deconvolve(const std::vector<float>& capture, const std::vector<float>& stimulus,
+        int lengthSamples);
+
+    Metrics Analyze(const std::vector<float>& impulseResponse, double sampleRate);
+
+    // Schroeder backward integral, in dB relative to the total energy.
+    std::vector<float> EnergyDecayCurve(const std::vector<float>& impulseResponse);
+
+    // Abel & Huang normalized echo density over a sliding window, one value per hop.
+    std::vector<float> NormalizedEchoDensity(const std::vector<float>& impulseResponse, double sampleRate,
+        float windowMilliseconds, float hopMilliseconds);
+
+    //region JSON (schema of Docs/Deelay_IR_Comparisons)
+    juce::var ToVar(const Metrics& metrics);
+
+    // "_info", each named result, then "diff (B minus A)" when there are exactly two.
+    juce::var MakeReport(const juce::StringArray& names, const std::vector<Metrics>& results);
+    //endregion
+}
@@ -0,0 +1,205 @@
+// ChronoverbMeasure: writes measurement stimuli and turns captures of them into impulse
+// responses and metrics.
+//
+//   ChronoverbMeasure stimulus <impulse|sweep|mls|noise> <out.wav> [--rate=48000]
+//   ChronoverbMeasure analyze <impulse|sweep|mls|noise> <capture.wav> [--compare=<capture.wav>]
+//                     [--ir-seconds=10] [--ir-output=<ir.wav>] [--output=<report.json>]
+//   ChronoverbMeasure compare <reference.wav> <candidate.wav> [--max-abs=1e-5]
+//                     [--max-spectral-db=0.1] [--max-rt60-drift=0.02]
+//
+// Captures must start where the stimulus starts (the plugin fires it from F1..F4, so record
+// from the key press, or play the "stimulus" file through the chain). Results are named
+// after the capture files; with --compare the report also holds "diff (B minus A)".
+//
+// "compare" checks a render against a golden reference within tolerance budgets, each
+// channel on its own, and exits with 1 when any channel exceeds a budget (see
+// RenderComparison.h).
+
+#include <cmath>
+#include <iostream>
+#include <optional>
+
+#include <juce_core/juce_core.h>
+
+#include "ImpulseResponseMetrics.h"
+#include "RenderComparison.h"
+#include "WavFiles.h"
+#include "../../Source/Filters/MeasurementSignalGenerator.h"
+
+namespace
+{
+    std::optional<MeasurementSignalGenerator::Signal> parseSignal(const juce::String& name)
+    {
+        using Signal = MeasurementSignalGenerator::Signal;
+
+        if (name == "impulse") return Signal::Impulse;
+        if (name == "sweep")   return Signal::LogSweep;
+        if (name == "mls")     return Signal::Mls;
+        if (name == "noise")   return Signal::NoiseBurst;
+
+        return std::nullopt;
+    }
+
+    int fail(const juce::String& message)
+    {
+        std::cerr << message << std::endl;
+        return 1;
+    }
+
+    int writeStimulus(const juce::ArgumentList& arguments)
+    {
+        const auto signal = arguments.size() >= 3 ? parseSignal(arguments[1].text) : std::nullopt;
+
+        if (!signal.has_value())
+            return fail("usage: stimulus <impulse|sweep|mls|noise> <out.wav> [--rate=48000]");
+
+        const double sampleRate = arguments.containsOption("--rate")
+            ? arguments.getValueForOption("--rate").getDoubleValue()
+            : 48000.0;
+
+        const juce::File outputFile = arguments[2].resolveAsFile();
+
+        if (!WavFiles::WriteMono(outputFile, MeasurementSignalGenerator::RenderSignal(*signal, sampleRate), sampleRate))
+            return fail("Couldn't write " + outputFile.getFullPathName());
+
+        return 0;
+    }
+
+    // Deconvolved IR of one capture, or nullopt after reporting why not.
+    std::optional<std::vector<float>> extractImpulseResponse(MeasurementSignalGenerator::Signal signal,
+        const juce::File& captureFile, double irSeconds, double& sampleRate)
+    {
+        std::vector<float> capture;
+
+        if (!WavFiles::ReadMono(captureFile, capture, sampleRate))
+        {
+            std::cerr << "Couldn't read " << captureFile.getFullPathName() << std::endl;
+            return std::nullopt;
+        }
+
+        const auto stimulus = MeasurementSignalGenerator::RenderSignal(signal, sampleRate);
+
+        return ImpulseResponseMetrics::Deconvolve(capture, stimulus,
+            static_cast<int>(std::round(irSeconds * sampleRate)));
+    }
+
+    int analyze(const juce::ArgumentList& arguments)
+    {
+        const auto signal = arguments.size() >= 3 ? parseSignal(arguments[1].text) : std::nullopt;
+
+        if (!signal.has_value())
+            return fail("usage: analyze <impulse|sweep|mls|noise> <capture.wav> [--compare=<capture.wav>] "
+                        "[--ir-seconds=10] [--ir-output=<ir.wav>] [--output=<report.json>]");
+
+        const double irSeconds = arguments.containsOption("--ir-seconds")
+            ? arguments.getValueForOption("--ir-seconds").getDoubleValue()
+            : 10.0;
+
+        juce::Array<juce::File> captureFiles { arguments[2].resolveAsFile() };
+
+        if (arguments.containsOption("--compare"))
+            captureFiles.add(arguments.getFileForOption("--compare"));
+
+        juce::StringArray names;
+        std::vector<ImpulseResponseMetrics::Metrics> results;
+
+        for (const auto& captureFile : captureFiles)
+        {
+            double sampleRate = 48000.0;
+            const auto impulseResponse = extractImpulseResponse(*signal, captureFile, irSeconds, sampleRate);
+
+            if (!impulseResponse.has_value())
+                return 1;
+
+            // Only the first capture's IR is written out.
+            if (results.empty() && arguments.containsOption("--ir-output"))
+                WavFiles::WriteMono(arguments.getFileForOption("--ir-output"), *impulseResponse, sampleRate);
+
+            names.add(captureFile.getFileNameWithoutExtension());
+            results.push_back(ImpulseResponseMetrics::Analyze(*impulseResponse, sampleRate));
+        }
+
+        const juce::String report = juce::JSON::toString(ImpulseResponseMetrics::MakeReport(names, results));
+
+        if (arguments.containsOption("--output"))
+        {
+            const juce::File outputFile = arguments.getFileForOption("--output");
+
+            if (!outputFile.replaceWithText(report))
+                return fail("Couldn't write " + outputFile.getFullPathName());
+        }
+        else
+        {
+            std::cout << report << std::endl;
+        }
+
+        return 0;
+    }
+
+    int compare(const juce::ArgumentList& arguments)
+    {
+        if (arguments.size() < 3)
+            return fail("usage: compare <reference.wav> <candidate.wav> [--max-abs=1e-5] "
+                        "[--max-spectral-db=0.1] [--max-rt60-drift=0.02]");
+
+        const RenderComparison::Budget budget = RenderComparison::ReadBudget(arguments);
+
+        const juce::File referenceFile = arguments[1].resolveAsFile();
+        const juce::File candidateFile = arguments[2].resolveAsFile();
+
+        juce::AudioBuffer<float> reference;
+        juce::AudioBuffer<float> candidate;
+        double referenceSampleRate = 0.0;
+        double candidateSampleRate = 0.0;
+
+        if (!WavFiles::Read(referenceFile, reference, referenceSampleRate))
+            return fail("Couldn't read " + referenceFile.getFullPathName());
+
+        if (!WavFiles::Read(candidateFile, candidate, candidateSampleRate))
+            return fail("Couldn't read " + candidateFile.getFullPathName());
+
+        if (referenceSampleRate != candidateSampleRate)
+            return fail("Sample rates differ");
+
+        if (reference.getNumChannels() != candidate.getNumChannels())
+            return fail("Channel counts differ");
+
+        // Channel by channel: an L/R average would hide a change to the stereo image.
+        bool passed = true;
+
+        for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+        {
+            const auto result = RenderComparison::Compare(WavFiles::GetChannel(reference, channel),
+                                                          WavFiles::GetChannel(candidate, channel),
+                                                          referenceSampleRate);
+            const bool channelPassed = result.IsWithin(budget);
+
+            std::cout << candidateFile.getFileName() << " channel " << (channel + 1)
+                      << (result.LengthsMatch ? "" : "  lengths differ")
+                      << "  max abs " << result.MaxAbsoluteError
+                      << "  spectral " << result.SpectralDistanceDecibels << " dB"
+                      << "  RT60 drift " << result.Rt60DriftSeconds << " s"
+                      << (channelPassed ? "  ok" : "  OVER BUDGET") << std::endl;
+
+            passed = passed && channelPassed;
+        }
+
+        return passed ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ArgumentList arguments(argc, argv);
+
+    if (arguments.size() > 0 && arguments[0] == "stimulus")
+        return writeStimulus(arguments);
+
+    if (arguments.size() > 0 && arguments[0] == "analyze")
+        return analyze(arguments);
+
+    if (arguments.size() > 0 && arguments[0] == "compare")
+        return compare(arguments);
+
+    return fail("usage: ChronoverbMeasure <stimulus|analyze|compare> ...");
+}
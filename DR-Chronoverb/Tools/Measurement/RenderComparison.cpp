@@ -0,0 +1,141 @@
+#include "RenderComparison.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <juce_dsp/juce_dsp.h>
+
+#include "ImpulseResponseMetrics.h"
+
+namespace RenderComparison
+{
+namespace
+{
+    constexpr int SpectrumFftOrder = 11;
+    constexpr int SpectrumFftSize = 1 << SpectrumFftOrder;
+    constexpr int SpectrumHopSize = SpectrumFftSize / 2;
+
+    // Bins quieter than this (relative to the reference's loudest) are left out, so noise
+    // floor differences in silent stretches don't dominate.
+    constexpr float SpectrumFloorDecibels = -120.0f;
+
+    // Hann-windowed magnitude spectra, one frame per hop over the first numSamples.
+    std::vector<std::vector<float>> getMagnitudeFrames(const std::vector<float>& signal, size_t numSamples)
+    {
+        juce::dsp::FFT fft(SpectrumFftOrder);
+
+        std::vector<float> window(SpectrumFftSize);
+
+        for (int i = 0; i < SpectrumFftSize; ++i)
+            window[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi
+                * static_cast<float>(i) / static_cast<float>(SpectrumFftSize));
+
+        std::vector<std::vector<float>> frames;
+        std::vector<float> data(SpectrumFftSize * 2);
+
+        for (size_t frameStart = 0; frameStart < numSamples; frameStart += SpectrumHopSize)
+        {
+            std::fill(data.begin(), data.end(), 0.0f);
+
+            const size_t frameSamples = std::min(numSamples - frameStart, static_cast<size_t>(SpectrumFftSize));
+
+            for (size_t i = 0; i < frameSamples; ++i)
+                data[i] = signal[frameStart + i] * window[i];
+
+            fft.performFrequencyOnlyForwardTransform(data.data(), true);
+
+            frames.emplace_back(data.begin(), data.begin() + SpectrumFftSize / 2 + 1);
+        }
+
+        return frames;
+    }
+
+    float getSpectralDistance(const std::vector<float>& reference, const std::vector<float>& candidate, size_t numSamples)
+    {
+        const auto referenceFrames = getMagnitudeFrames(reference, numSamples);
+        const auto candidateFrames = getMagnitudeFrames(candidate, numSamples);
+
+        float loudest = 0.0f;
+
+        for (const auto& frame : referenceFrames)
+            loudest = std::max(loudest, *std::max_element(frame.begin(), frame.end()));
+
+        if (loudest <= 0.0f)
+            return 0.0f;
+
+        const float floorMagnitude = loudest * juce::Decibels::decibelsToGain(SpectrumFloorDecibels);
+
+        double sumSquares = 0.0;
+        size_t numBins = 0;
+
+        for (size_t frameIndex = 0; frameIndex < referenceFrames.size(); ++frameIndex)
+        {
+            for (size_t bin = 0; bin < referenceFrames[frameIndex].size(); ++bin)
+            {
+                const float referenceMagnitude = referenceFrames[frameIndex][bin];
+                const float candidateMagnitude = candidateFrames[frameIndex][bin];
+
+                if (std::max(referenceMagnitude, candidateMagnitude) < floorMagnitude)
+                    continue;
+
+                const double difference = 20.0 * std::log10((candidateMagnitude + floorMagnitude)
+                                                            / (referenceMagnitude + floorMagnitude));
+
+                sumSquares += difference * difference;
+                ++numBins;
+            }
+        }
+
+        return numBins > 0 ? static_cast<float>(std::sqrt(sumSquares / static_cast<double>(numBins))) : 0.0f;
+    }
+}
+
+bool Result::IsWithin(const Budget& budget) const
+{
+    return LengthsMatch
+        && MaxAbsoluteError <= budget.MaxAbsoluteError
+        && SpectralDistanceDecibels <= budget.MaxSpectralDistanceDecibels
+        && Rt60DriftSeconds <= budget.MaxRt60DriftSeconds;
+}
+
+Budget ReadBudget(const juce::ArgumentList& arguments)
+{
+    Budget budget;
+
+    if (arguments.containsOption("--max-abs"))
+        budget.MaxAbsoluteError = arguments.getValueForOption("--max-abs").getFloatValue();
+
+    if (arguments.containsOption("--max-spectral-db"))
+        budget.MaxSpectralDistanceDecibels = arguments.getValueForOption("--max-spectral-db").getFloatValue();
+
+    if (arguments.containsOption("--max-rt60-drift"))
+        budget.MaxRt60DriftSeconds = arguments.getValueForOption("--max-rt60-drift").getFloatValue();
+
+    return budget;
+}
+
+Result Compare(const std::vector<float>& reference, const std::vector<float>& candidate, double sampleRate)
+{
+    Result result;
+
+    const size_t numSamples = std::min(reference.size(), candidate.size());
+
+    result.LengthsMatch = (reference.size() == candidate.size());
+
+    for (size_t i = 0; i < numSamples; ++i)
+        result.MaxAbsoluteError = std::max(result.MaxAbsoluteError, std::abs(candidate[i] - reference[i]));
+
+    result.SpectralDistanceDecibels = getSpectralDistance(reference, candidate, numSamples);
+
+    const float referenceRt60 = ImpulseResponseMetrics::Analyze(reference, sampleRate).Rt60BroadbandSeconds;
+    const float candidateRt60 = ImpulseResponseMetrics::Analyze(candidate, sampleRate).Rt60BroadbandSeconds;
+
+    if ((referenceRt60 > 0.0f) != (candidateRt60 > 0.0f))
+        result.Rt60DriftSeconds = std::numeric_limits<float>::infinity();
+    else
+        result.Rt60DriftSeconds = std::abs(candidateRt60 - referenceRt60);
+
+    return result;
+}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+// Tolerance checks between a reference render and a candidate render of the same input,
+// for confirming that an optimisation keeps the output "bit-close".
+//
+// Typical use: render with ChronoverbGridRender --write-irs before and after a change, then
+// run ChronoverbMeasure compare on each pair of WAVs. ChronoverbGolden checks its cases
+// against the checked-in goldens, each with its own budget. Compare one channel at a time:
+// an average of L and R hides changes to the stereo image.
+namespace RenderComparison
+{
+    struct Budget
+    {
+        float MaxAbsoluteError = 1.0e-5f;
+        float MaxSpectralDistanceDecibels = 0.1f;
+        float MaxRt60DriftSeconds = 0.02f;
+    };
+
+    struct Result
+    {
+        bool LengthsMatch = true;
+
+        // Largest |candidate - reference| over the common length.
+        float MaxAbsoluteError = 0.0f;
+
+        // RMS dB difference between short-time magnitude spectra, over bins within 120 dB of
+        // the reference's loudest bin.
+        float SpectralDistanceDecibels = 0.0f;
+
+        // |RT60 difference|; 0 when neither render decays far enough to fit, infinite when
+        // only one does.
+        float Rt60DriftSeconds = 0.0f;
+
+        bool IsWithin(const Budget& budget) const;
+    };
+
+    // [--max-abs=] [--max-spectral-db=] [--max-rt60-drift=] over the defaults.
+    Budget ReadBudget(const juce::ArgumentList& arguments);
+
+    Result Compare(const std::vector<float>& reference, const std::vector<float>& candidate, double sampleRate);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+// WAV (and other basic formats) in, 32-bit float WAV out, for the offline tools.
+namespace WavFiles
+{
+    // Channels are averaged. Returns false (and leaves the outputs untouched) on failure.
+    inline bool ReadMono(const juce::File& file, std::vector<float>& samples, double& sampleRate)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if (reader == nullptr || reader->numChannels == 0)
+            return false;
+
+        const int numChannels = static_cast<int>(reader->numChannels);
+        const int numSamples = static_cast<int>(reader->lengthInSamples);
+
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        reader->read(&buffer, 0, numSamples, 0, true, true);
+
+        samples.assign(static_cast<size_t>(numSamples), 0.0f);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::addWithMultiply(samples.data(), buffer.getReadPointer(channel),
+                1.0f / static_cast<float>(numChannels), numSamples);
+
+        sampleRate = reader->sampleRate;
+        return true;
+    }
+
+    // 32-bit float, overwriting any existing file.
+    inline bool WriteMono(const juce::File& file, const std::vector<float>& samples, double sampleRate)
+    {
+        file.deleteFile();
+
+        std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+
+        if (stream == nullptr)
+            return false;
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wavFormat.createWriterFor(stream.get(), sampleRate, 1, 32, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        // The writer owns the stream from here on.
+        stream.release();
+
+        const float* channels[] = { samples.data() };
+        return writer->writeFromFloatArrays(channels, 1, static_cast<int>(samples.size()));
+    }
+
+    // Length in samples without reading the audio, or -1 if the file can't be opened.
+    inline int64_t GetLengthInSamples(const juce::File& file)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        return reader != nullptr ? reader->lengthInSamples : -1;
+    }
+
+    // Every channel of the file. Returns false (and leaves the outputs untouched) on failure.
+    inline bool Read(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if (reader == nullptr || reader->numChannels == 0)
+            return false;
+
+        buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+
+        sampleRate = reader->sampleRate;
+        return true;
+    }
+
+    // One channel of a buffer as a vector, for RenderComparison and ImpulseResponseMetrics.
+    inline std::vector<float> GetChannel(const juce::AudioBuffer<float>& buffer, int channel)
+    {
+        const float* samples = buffer.getReadPointer(channel);
+        return std::vector<float>(samples, samples + buffer.getNumSamples());
+    }
+
+    // Stereo: mono files are copied to both channels, channels past the second are dropped.
+    inline bool ReadStereo(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if (reader == nullptr || reader->numChannels == 0)
+            return false;
+
+        const int numSamples = static_cast<int>(reader->lengthInSamples);
+
+        buffer.setSize(2, numSamples);
+        reader->read(&buffer, 0, numSamples, 0, true, true);
+
+        sampleRate = reader->sampleRate;
+        return true;
+    }
+
+    // 32-bit float, every channel of the buffer, overwriting any existing file.
+    inline bool Write(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate)
+    {
+        file.deleteFile();
+
+        std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+
+        if (stream == nullptr)
+            return false;
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wavFormat.createWriterFor(stream.get(), sampleRate, static_cast<unsigned int>(buffer.getNumChannels()), 32, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        // The writer owns the stream from here on.
+        stream.release();
+
+        return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    }
+}
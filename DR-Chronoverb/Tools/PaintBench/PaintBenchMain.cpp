@@ -0,0 +1,231 @@
+// ChronoverbPaintBench: headless paint benchmark for the Chronoverb editor. Builds the
+// editor offscreen, drives scripted scenarios through it (knob drags, tab switches,
+// tooltip fades, SegmentedButton clicks) and reports the paint cost per component against
+// a ms budget. Exits with 1 when anything is over budget.
+//
+//   ChronoverbPaintBench [--frames=240] [--component-avg-ms=0.5] [--component-worst-ms=4]
+//                        [--frame-avg-ms=8]
+//
+// How frames are driven and timed is described in Utils/PaintBenchmark.h at the repo root.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "PaintBenchmark.h"
+#include "../../Source/PluginEditor.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/Utils/HorizontalRangeSlider.h"
+
+namespace
+{
+    constexpr double SampleRate = 48000.0;
+
+    // One 60 fps frame of audio.
+    constexpr int BlockSize = 800;
+
+    // A quiet sine through the processor every frame, so the scopes and the spectrum have
+    // something to draw.
+    class AudioFeed
+    {
+    public:
+        explicit AudioFeed(AudioPluginAudioProcessor& processorToFeed)
+            : processor(processorToFeed), buffer(2, BlockSize)
+        {
+            processor.prepareToPlay(SampleRate, BlockSize);
+        }
+
+        ~AudioFeed()
+        {
+            processor.releaseResources();
+        }
+
+        void ProcessFrame()
+        {
+            for (int sample = 0; sample < BlockSize; ++sample)
+            {
+                const float value = 0.25f * static_cast<float>(std::sin(phase));
+                phase += juce::MathConstants<double>::twoPi * 220.0 / SampleRate;
+
+                buffer.setSample(0, sample, value);
+                buffer.setSample(1, sample, value);
+            }
+
+            phase = std::fmod(phase, juce::MathConstants<double>::twoPi);
+
+            juce::MidiBuffer midi;
+            processor.processBlock(buffer, midi);
+        }
+
+    private:
+        AudioPluginAudioProcessor& processor;
+        juce::AudioBuffer<float> buffer;
+        double phase = 0.0;
+    };
+
+    // Selects whichever tab shows the component. Pages are built on first visit, so every
+    // tab has been visited by the time this is needed.
+    void showInTabs(juce::Component& component, const std::vector<TabbedPageBox*>& tabBoxes)
+    {
+        for (auto* tabBox : tabBoxes)
+        {
+            if (!tabBox->isParentOf(&component))
+                continue;
+
+            for (int tabIndex = 0; tabIndex < tabBox->GetNumTabs() && !PaintBenchmark::IsVisibleInEditor(component); ++tabIndex)
+                tabBox->SetSelectedTabIndex(tabIndex, juce::sendNotification);
+        }
+    }
+
+    template <typename ComponentType>
+    std::vector<ComponentType*> findVisible(juce::Component& root)
+    {
+        std::vector<ComponentType*> visible;
+
+        for (auto* component : PaintBenchmark::FindAll<ComponentType>(root))
+            if (PaintBenchmark::IsVisibleInEditor(*component))
+                visible.push_back(component);
+
+        return visible;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList arguments(argc, argv);
+
+    const int numFrames = arguments.containsOption("--frames")
+        ? arguments.getValueForOption("--frames").getIntValue()
+        : 240;
+
+    if (numFrames < 1)
+    {
+        std::cerr << "usage: ChronoverbPaintBench [--frames=240] [--component-avg-ms=] "
+                     "[--component-worst-ms=] [--frame-avg-ms=]" << std::endl;
+        return 1;
+    }
+
+    AudioPluginAudioProcessor processor;
+    AudioFeed audioFeed(processor);
+
+    std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+    auto& animationScheduler = dynamic_cast<AnimationScheduler::Host&>(*editor).GetAnimationScheduler();
+
+    PaintBenchmark::Runner runner(*editor,
+        [&animationScheduler](double frameTimeSeconds) { animationScheduler.AdvanceFrame(frameTimeSeconds); },
+        PaintBenchmark::ReadBudget(arguments));
+
+    PaintBenchmark::ScriptedMouse mouse;
+
+    std::cout << "Chronoverb editor " << editor->getWidth() << "x" << editor->getHeight() << "\n";
+
+    runner.Run("Idle", numFrames, [&](int)
+    {
+        audioFeed.ProcessFrame();
+    });
+
+    const auto tabBoxes = PaintBenchmark::FindAll<TabbedPageBox>(*editor);
+
+    runner.Run("Tab switches", numFrames, [&](int frameIndex)
+    {
+        constexpr int FramesPerTab = 12;
+
+        if (frameIndex % FramesPerTab == 0)
+            for (auto* tabBox : tabBoxes)
+                tabBox->SetSelectedTabIndex((frameIndex / FramesPerTab) % std::max(1, tabBox->GetNumTabs()), juce::sendNotification);
+
+        audioFeed.ProcessFrame();
+    });
+
+    for (auto* tabBox : tabBoxes)
+        tabBox->SetSelectedTabIndex(0, juce::sendNotification);
+
+    const auto knobs = findVisible<juce::Slider>(*editor);
+
+    runner.Run("Knob drags", numFrames, [&](int frameIndex)
+    {
+        PaintBenchmark::StepSliderDrags(mouse, knobs, frameIndex);
+        audioFeed.ProcessFrame();
+    });
+
+    // The pointer sweeps across each range slider, hovering both thumbs, then leaves and
+    // the tooltip fades out.
+    const auto rangeSliders = PaintBenchmark::FindAll<HorizontalRangeSlider>(*editor);
+
+    runner.Run("Tooltip fades", numFrames, [&](int frameIndex)
+    {
+        constexpr int FramesPerSweep = 40;
+        constexpr int FramesPerGesture = 90;
+
+        if (!rangeSliders.empty())
+        {
+            auto& slider = *rangeSliders[static_cast<size_t>(frameIndex / FramesPerGesture) % rangeSliders.size()];
+            const int phase = frameIndex % FramesPerGesture;
+
+            if (phase == 0)
+                showInTabs(slider, tabBoxes);
+
+            if (phase < FramesPerSweep)
+            {
+                const float x = slider.getWidth() * (static_cast<float>(phase) + 0.5f) / FramesPerSweep;
+                mouse.Move(slider, { x, slider.getHeight() * 0.5f });
+            }
+            else if (phase == FramesPerSweep)
+            {
+                mouse.Exit(slider);
+            }
+        }
+
+        audioFeed.ProcessFrame();
+    });
+
+    // Clicks through every option of each SegmentedButton, one click every few frames.
+    const auto segmentedButtons = PaintBenchmark::FindAll<SegmentedButton>(*editor);
+
+    runner.Run("SegmentedButton clicks", numFrames, [&](int frameIndex)
+    {
+        constexpr int FramesPerClick = 6;
+
+        if (!segmentedButtons.empty() && frameIndex % FramesPerClick <= 1)
+        {
+            const int clickIndex = frameIndex / FramesPerClick;
+            auto& button = *segmentedButtons[static_cast<size_t>(clickIndex / 4) % segmentedButtons.size()];
+            const int numOptions = std::max(1, button.getNumOptions());
+
+            const float position = (static_cast<float>(clickIndex % numOptions) + 0.5f) / numOptions;
+            const juce::Point<float> point = button.isVertical()
+                ? juce::Point<float>(button.getWidth() * 0.5f, button.getHeight() * position)
+                : juce::Point<float>(button.getWidth() * position, button.getHeight() * 0.5f);
+
+            if (frameIndex % FramesPerClick == 0)
+            {
+                showInTabs(button, tabBoxes);
+                mouse.Down(button, point);
+            }
+            else
+            {
+                mouse.Up(button, point);
+            }
+        }
+
+        audioFeed.ProcessFrame();
+    });
+
+    editor.reset();
+
+    if (!runner.AllWithinBudget())
+    {
+        std::cout << "Over budget" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Within budget" << std::endl;
+    return 0;
+}
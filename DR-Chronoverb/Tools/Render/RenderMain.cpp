@@ -0,0 +1,384 @@
+// ChronoverbRender: offline bounces of many files through many settings at once, one
+// Chronoverb per job on a thread pool.
+//
+//   ChronoverbRender <input file or folder> ... [<parameterID>=<value> ...]
+//                    [--presets=<preset file>[,<preset file>...]] [--output-dir=renders]
+//                    [--tail-seconds=0] [--threads=<cores>] [--seed=<n>]
+//
+// Every input is rendered once per preset (or once, with no presets). Folders contribute the
+// audio files directly inside them. A preset file holds one <parameterID>=<value> per line,
+// '#' starts a comment; values are plain (ms, seconds, choice index, 0/1), as in
+// Source/ParameterEntries.h. Settings on the command line apply to every job after the
+// preset's, and anything set by neither keeps its plugin default.
+//
+// Outputs are 32-bit float stereo WAVs named <input>.wav, or <input>_<preset>.wav with
+// several presets. Mono inputs are rendered as dual mono. Jobs that would share an output
+// name (same-named inputs from two folders, or two presets with one name) are an error.
+//
+// Jobs are independent, so they spread over every core. Idle workers take the next queued
+// job, and the queue is ordered longest first so a long file never starts last.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include "../GridRender/HeadlessParameterHost.h"
+#include "../Measurement/WavFiles.h"
+#include "../../Source/Filters/Chronoverb.h"
+
+namespace
+{
+    using Settings = std::vector<std::pair<juce::String, float>>;
+
+    struct Preset
+    {
+        juce::String Name;
+        Settings Values;
+    };
+
+    struct RenderJob
+    {
+        juce::File Input;
+        juce::File Output;
+        const Preset* SourcePreset = nullptr;
+        int64_t LengthInSamples = 0;
+    };
+
+    struct RenderOptions
+    {
+        Settings CommandLineSettings;
+        double TailSeconds = 0.0;
+        uint32_t RandomSeed = static_cast<uint32_t>(RandomStream::DefaultSeed);
+    };
+
+    constexpr int BlockSize = 512;
+
+    int fail(const juce::String& message)
+    {
+        std::cerr << message << std::endl;
+        return 1;
+    }
+
+    // "<parameterID>=<value>". On nullopt, error says what was wrong with text. The value must
+    // be a finite number: juce::String::getFloatValue would read "abc" as 0 without a word.
+    std::optional<std::pair<juce::String, float>> parseSetting(const juce::String& text, juce::String& error)
+    {
+        const juce::String parameterID = text.upToFirstOccurrenceOf("=", false, false).trim();
+        const juce::String value = text.fromFirstOccurrenceOf("=", false, false).trim();
+
+        if (!text.containsChar('=') || parameterID.isEmpty() || value.isEmpty())
+        {
+            error = "expected <parameterID>=<value>";
+            return std::nullopt;
+        }
+
+        const char* const valueText = value.toRawUTF8();
+        char* valueEnd = nullptr;
+        const double number = std::strtod(valueText, &valueEnd);
+
+        if (valueEnd == valueText || *valueEnd != '\0' || !std::isfinite(number))
+        {
+            error = "\"" + value + "\" isn't a number (for " + parameterID + ")";
+            return std::nullopt;
+        }
+
+        return std::make_pair(parameterID, static_cast<float>(number));
+    }
+
+    std::optional<Preset> readPreset(const juce::File& file, juce::String& error)
+    {
+        if (!file.existsAsFile())
+        {
+            error = "Couldn't read preset " + file.getFullPathName();
+            return std::nullopt;
+        }
+
+        Preset preset { file.getFileNameWithoutExtension(), {} };
+
+        juce::StringArray lines;
+        file.readLines(lines);
+
+        for (int lineIndex = 0; lineIndex < lines.size(); ++lineIndex)
+        {
+            const juce::String line = lines[lineIndex].upToFirstOccurrenceOf("#", false, false).trim();
+
+            if (line.isEmpty())
+                continue;
+
+            juce::String settingError;
+            const auto setting = parseSetting(line, settingError);
+
+            if (!setting.has_value())
+            {
+                error = file.getFileName() + ":" + juce::String(lineIndex + 1) + ": " + settingError;
+                return std::nullopt;
+            }
+
+            preset.Values.push_back(*setting);
+        }
+
+        return preset;
+    }
+
+    bool isKnownParameter(const juce::String& parameterID)
+    {
+        const auto& entries = PluginParameterRegistry::GetEntries();
+
+        return std::any_of(entries.begin(), entries.end(),
+            [&](const PluginParameterRegistry::Entry& entry) { return entry.parameterID == parameterID; });
+    }
+
+    juce::String describeJob(const RenderJob& job)
+    {
+        if (job.SourcePreset == nullptr)
+            return job.Input.getFullPathName();
+
+        return job.Input.getFullPathName() + " (preset " + job.SourcePreset->Name + ")";
+    }
+
+    // Runs on a pool thread with its own parameter tree and Chronoverb. Returns an error
+    // message, empty on success.
+    juce::String render(const RenderJob& job, const RenderOptions& options)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        juce::AudioBuffer<float> input;
+        double sampleRate = 0.0;
+
+        if (!WavFiles::ReadStereo(job.Input, input, sampleRate))
+            return "Couldn't read " + job.Input.getFullPathName();
+
+        HeadlessParameterHost host;
+
+        if (job.SourcePreset != nullptr)
+            for (const auto& [parameterID, value] : job.SourcePreset->Values)
+                host.SetPlainValue(parameterID, value);
+
+        for (const auto& [parameterID, value] : options.CommandLineSettings)
+            host.SetPlainValue(parameterID, value);
+
+        // Same order as the plugin's prepareToPlay: parameters first, then DSP prep.
+        Chronoverb chronoverb;
+        PluginParameterRegistry::ApplyAll(chronoverb, host.Parameters);
+        chronoverb.SetRandomSeed(options.RandomSeed);
+        chronoverb.PrepareToPlay(sampleRate);
+
+        const int inputSamples = input.getNumSamples();
+        const int totalSamples = inputSamples + static_cast<int>(options.TailSeconds * sampleRate);
+
+        // Rendered in place, block by block, as a host would; the tail runs on silence.
+        juce::AudioBuffer<float> output(2, totalSamples);
+        output.clear();
+
+        for (int channel = 0; channel < 2; ++channel)
+            output.copyFrom(channel, 0, input, channel, 0, inputSamples);
+
+        for (int blockStart = 0; blockStart < totalSamples; blockStart += BlockSize)
+        {
+            const int blockSamples = std::min(BlockSize, totalSamples - blockStart);
+
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), 2, blockStart, blockSamples);
+            chronoverb.ProcessBlock(block);
+        }
+
+        if (!WavFiles::Write(job.Output, output, sampleRate))
+            return "Couldn't write " + job.Output.getFullPathName();
+
+        return {};
+    }
+
+    bool isAudioFile(const juce::File& file)
+    {
+        return file.hasFileExtension("wav;aif;aiff;flac");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // The parameter trees start timers, which need a message manager (never dispatched here).
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList arguments(argc, argv);
+
+    RenderOptions options;
+    juce::Array<juce::File> inputs;
+
+    for (const auto& argument : arguments.arguments)
+    {
+        if (argument.isOption())
+            continue;
+
+        if (argument.text.containsChar('='))
+        {
+            juce::String settingError;
+            const auto setting = parseSetting(argument.text, settingError);
+
+            if (!setting.has_value())
+                return fail("Couldn't parse setting \"" + argument.text + "\": " + settingError);
+
+            options.CommandLineSettings.push_back(*setting);
+            continue;
+        }
+
+        const juce::File path = argument.resolveAsFile();
+
+        if (path.isDirectory())
+        {
+            for (const auto& file : path.findChildFiles(juce::File::findFiles, false))
+                if (isAudioFile(file))
+                    inputs.addIfNotAlreadyThere(file);
+        }
+        else if (path.existsAsFile())
+        {
+            inputs.addIfNotAlreadyThere(path);
+        }
+        else
+        {
+            return fail("No such file or folder: " + path.getFullPathName());
+        }
+    }
+
+    if (inputs.isEmpty())
+        return fail("usage: ChronoverbRender <input file or folder> ... [<parameterID>=<value> ...] "
+                    "[--presets=<file>,...] [--output-dir=] [--tail-seconds=0] [--threads=] [--seed=]");
+
+    std::vector<Preset> presets;
+
+    for (const auto& presetPath : juce::StringArray::fromTokens(arguments.getValueForOption("--presets"), ",", ""))
+    {
+        if (presetPath.trim().isEmpty())
+            continue;
+
+        juce::String error;
+        auto preset = readPreset(juce::File::getCurrentWorkingDirectory().getChildFile(presetPath.trim()), error);
+
+        if (!preset.has_value())
+            return fail(error);
+
+        presets.push_back(std::move(*preset));
+    }
+
+    for (const auto& preset : presets)
+        for (const auto& [parameterID, value] : preset.Values)
+            if (!isKnownParameter(parameterID))
+                return fail("Unknown parameter \"" + parameterID + "\" in preset " + preset.Name);
+
+    for (const auto& [parameterID, value] : options.CommandLineSettings)
+        if (!isKnownParameter(parameterID))
+            return fail("Unknown parameter \"" + parameterID + "\" (IDs are in Source/ParameterEntries.h)");
+
+    if (arguments.containsOption("--tail-seconds"))
+        options.TailSeconds = arguments.getValueForOption("--tail-seconds").getDoubleValue();
+
+    if (!HeadlessParameterHost::ReadRandomSeedOption(arguments, options.RandomSeed))
+        return fail("--seed must be a whole number from 0 to 4294967295");
+
+    if (options.TailSeconds < 0.0)
+        return fail("--tail-seconds can't be negative");
+
+    const juce::File outputDirectory = arguments.containsOption("--output-dir")
+        ? arguments.getFileForOption("--output-dir")
+        : juce::File::getCurrentWorkingDirectory().getChildFile("renders");
+
+    if (!outputDirectory.createDirectory())
+        return fail("Couldn't create " + outputDirectory.getFullPathName());
+
+    const int numThreads = arguments.containsOption("--threads")
+        ? std::max(1, arguments.getValueForOption("--threads").getIntValue())
+        : juce::SystemStats::getNumCpus();
+
+    //region Jobs
+    std::vector<RenderJob> jobs;
+
+    for (const auto& input : inputs)
+    {
+        const int64_t lengthInSamples = WavFiles::GetLengthInSamples(input);
+
+        if (lengthInSamples < 0)
+            return fail("Couldn't read " + input.getFullPathName());
+
+        const juce::String inputName = input.getFileNameWithoutExtension();
+
+        if (presets.empty())
+            jobs.push_back({ input, outputDirectory.getChildFile(inputName + ".wav"), nullptr, lengthInSamples });
+
+        for (const auto& preset : presets)
+        {
+            const juce::String outputName = presets.size() == 1 ? inputName : inputName + "_" + preset.Name;
+            jobs.push_back({ input, outputDirectory.getChildFile(outputName + ".wav"), &preset, lengthInSamples });
+        }
+    }
+
+    // Names drop the input's folder and extension, so two jobs can land on one output
+    // (a.wav and a.flac, or same-named files from two folders). Refuse before rendering
+    // anything rather than let one job overwrite another.
+    std::map<juce::File, const RenderJob*> jobsByOutput;
+
+    for (const auto& job : jobs)
+    {
+        const auto [existing, inserted] = jobsByOutput.emplace(job.Output, &job);
+
+        if (!inserted)
+            return fail("Both " + describeJob(*existing->second) + " and " + describeJob(job)
+                        + " would render to " + job.Output.getFullPathName());
+    }
+
+    // Longest first: the last jobs to start are the short ones, so the workers finish together.
+    std::stable_sort(jobs.begin(), jobs.end(),
+        [](const RenderJob& a, const RenderJob& b) { return a.LengthInSamples > b.LengthInSamples; });
+    //endregion
+
+    //region Render
+    std::atomic<int> numFinished { 0 };
+    std::mutex errorsLock;
+    juce::StringArray errors;
+
+    const double startMilliseconds = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        juce::ThreadPool pool(numThreads);
+
+        for (const auto& job : jobs)
+        {
+            pool.addJob([&]
+            {
+                const juce::String error = render(job, options);
+
+                if (error.isNotEmpty())
+                {
+                    const std::scoped_lock lock(errorsLock);
+                    errors.add(error);
+                }
+
+                numFinished.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        while (numFinished.load(std::memory_order_acquire) < static_cast<int>(jobs.size()))
+        {
+            juce::Thread::sleep(250);
+            std::cout << "\rRendered " << numFinished.load() << " / " << jobs.size() << std::flush;
+        }
+    }
+
+    const double elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startMilliseconds) * 0.001;
+
+    std::cout << "\rRendered " << jobs.size() << " files on " << numThreads << " threads in "
+              << juce::String(elapsedSeconds, 1) << " s" << std::endl;
+    //endregion
+
+    for (const auto& error : errors)
+        std::cerr << error << std::endl;
+
+    return errors.isEmpty() ? 0 : 1;
+}
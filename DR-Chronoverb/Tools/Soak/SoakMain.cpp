@@ -0,0 +1,360 @@
+// ChronoverbSoak: a long-tail CPU soak. Drives one Chronoverb with short bursts followed by
+// long silences under random automation for simulated minutes or hours, and reports the
+// processing cost in ns/sample per window of simulated time.
+//
+//   ChronoverbSoak [--minutes=60] [--window-seconds=60] [--rate=48000] [--block=512]
+//                  [--automation-seconds=2] [--seed=<n>] [--allow-denormals]
+//                  [--csv=<file>] [--max-creep=<ratio>]
+//
+// Starts from extreme settings (10 s feedback, full diffusion, pitch and tape in the loop, no
+// tape noise), so every silence is a long decay towards zero: the case where denormals and
+// anything else that slows down with time show up as cost creeping up window by window.
+//
+// --allow-denormals runs without ScopedNoDenormals, to see what the plugin's flush-to-zero is
+// saving. --max-creep fails (exit 1) when the last quarter of the run costs more than <ratio>
+// times the first quarter.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include "../GridRender/HeadlessParameterHost.h"
+#include "../../Source/Filters/Chronoverb.h"
+
+namespace
+{
+    struct SoakSettings
+    {
+        double SampleRate = 48000.0;
+        int BlockSize = 512;
+        double Minutes = 60.0;
+        double WindowSeconds = 60.0;
+        double AutomationSeconds = 2.0;
+        uint32_t RandomSeed = static_cast<uint32_t>(RandomStream::DefaultSeed);
+        bool AllowDenormals = false;
+    };
+
+    struct Window
+    {
+        int64_t Ticks = 0;
+        int64_t NumSamples = 0;
+        int64_t NumSilentSamples = 0;
+        int64_t NumSubnormalOutputs = 0;
+        double WorstBlockNanosecondsPerSample = 0.0;
+
+        double GetNanosecondsPerSample() const
+        {
+            return NumSamples > 0 ? juce::Time::highResolutionTicksToSeconds(Ticks) * 1.0e9 / static_cast<double>(NumSamples)
+                                  : 0.0;
+        }
+    };
+
+    // Plain values: the far end of every range that makes tails longer.
+    constexpr std::pair<const char*, float> ExtremeSettings[] =
+    {
+        { "feedbackTime",     10.0f },
+        { "diffusionAmount",   1.0f },
+        { "diffusionSize",     1.0f },
+        { "pitchWetMix",       1.0f },
+        { "tapeEnabled",       1.0f },
+        { "tapeNoiseEnabled",  0.0f },
+    };
+
+    // Never automated: tape noise keeps the tail from ever reaching silence.
+    bool isAutomatable(const juce::String& parameterID)
+    {
+        return parameterID != "tapeNoiseEnabled";
+    }
+
+    int fail(const juce::String& message)
+    {
+        std::cerr << message << std::endl;
+        return 1;
+    }
+
+    // Bursts of 0.1 to 2 s of noise at a random level, each followed by 5 to 60 s of silence.
+    class BurstSource
+    {
+    public:
+        BurstSource(double sampleRate, uint64_t seed)
+            : sampleRate(sampleRate), random(seed)
+        {
+            startSilence();
+        }
+
+        // Returns true when the block is all silence.
+        bool Fill(juce::AudioBuffer<float>& block)
+        {
+            const int numSamples = block.getNumSamples();
+            bool isSilent = true;
+
+            block.clear();
+
+            for (int start = 0; start < numSamples;)
+            {
+                if (samplesRemaining == 0)
+                {
+                    if (inBurst)
+                        startSilence();
+                    else
+                        startBurst();
+                }
+
+                const int count = static_cast<int>(std::min<int64_t>(samplesRemaining, numSamples - start));
+
+                if (inBurst)
+                {
+                    for (int channel = 0; channel < block.getNumChannels(); ++channel)
+                        random.FillBipolar(block.getWritePointer(channel, start), count, burstGain);
+
+                    isSilent = false;
+                }
+
+                samplesRemaining -= count;
+                start += count;
+            }
+
+            return isSilent;
+        }
+
+    private:
+        void startBurst()
+        {
+            inBurst = true;
+            burstGain = juce::Decibels::decibelsToGain(-36.0f + 36.0f * random.NextFloat01());
+            samplesRemaining = getSamples(0.1 + 1.9 * random.NextFloat01());
+        }
+
+        void startSilence()
+        {
+            inBurst = false;
+            samplesRemaining = getSamples(5.0 + 55.0 * random.NextFloat01());
+        }
+
+        int64_t getSamples(double seconds) const
+        {
+            return std::max<int64_t>(1, static_cast<int64_t>(seconds * sampleRate));
+        }
+
+        double sampleRate;
+        RandomStream random;
+
+        bool inBurst = false;
+        float burstGain = 0.0f;
+        int64_t samplesRemaining = 0;
+    };
+
+    int64_t countSubnormals(const juce::AudioBuffer<float>& block)
+    {
+        int64_t count = 0;
+
+        for (int channel = 0; channel < block.getNumChannels(); ++channel)
+        {
+            const float* samples = block.getReadPointer(channel);
+
+            for (int i = 0; i < block.getNumSamples(); ++i)
+                if (std::fpclassify(samples[i]) == FP_SUBNORMAL)
+                    ++count;
+        }
+
+        return count;
+    }
+
+    double getMeanNanosecondsPerSample(const std::vector<Window>& windows, size_t begin, size_t end)
+    {
+        int64_t ticks = 0;
+        int64_t numSamples = 0;
+
+        for (size_t index = begin; index < end; ++index)
+        {
+            ticks += windows[index].Ticks;
+            numSamples += windows[index].NumSamples;
+        }
+
+        return numSamples > 0 ? juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / static_cast<double>(numSamples)
+                              : 0.0;
+    }
+
+    std::vector<Window> runSoak(const SoakSettings& settings)
+    {
+        std::optional<juce::ScopedNoDenormals> noDenormals;
+
+        if (!settings.AllowDenormals)
+            noDenormals.emplace();
+
+        HeadlessParameterHost host;
+
+        for (const auto& [parameterID, value] : ExtremeSettings)
+            host.SetPlainValue(parameterID, value);
+
+        // Same order as the plugin's prepareToPlay: parameters first, then DSP prep.
+        Chronoverb chronoverb;
+        PluginParameterRegistry::ApplyAll(chronoverb, host.Parameters);
+        chronoverb.SetRandomSeed(settings.RandomSeed);
+        chronoverb.PrepareToPlay(settings.SampleRate);
+
+        juce::StringArray automatable;
+
+        for (const auto& entry : PluginParameterRegistry::GetEntries())
+            if (isAutomatable(entry.parameterID))
+                automatable.add(entry.parameterID);
+
+        RandomStream automationRandom(RandomStream::DeriveSeed(settings.RandomSeed, 0));
+        BurstSource source(settings.SampleRate, RandomStream::DeriveSeed(settings.RandomSeed, 1));
+
+        const int64_t totalSamples = static_cast<int64_t>(settings.Minutes * 60.0 * settings.SampleRate);
+        const int64_t windowSamples = std::max<int64_t>(1, static_cast<int64_t>(settings.WindowSeconds * settings.SampleRate));
+        const int64_t automationSamples = std::max<int64_t>(1, static_cast<int64_t>(settings.AutomationSeconds * settings.SampleRate));
+
+        std::vector<Window> windows;
+        juce::AudioBuffer<float> block(2, settings.BlockSize);
+
+        int64_t nextAutomation = automationSamples;
+
+        for (int64_t blockStart = 0; blockStart < totalSamples;)
+        {
+            // Blocks never straddle a window, so each window's cost is its own.
+            const int64_t windowIndex = blockStart / windowSamples;
+            const int64_t windowEnd = std::min(totalSamples, (windowIndex + 1) * windowSamples);
+            const int blockSamples = static_cast<int>(std::min<int64_t>(settings.BlockSize, windowEnd - blockStart));
+
+            if (static_cast<size_t>(windowIndex) >= windows.size())
+                windows.emplace_back();
+
+            // Automation lands between blocks, the way a host delivers it. Changes go through
+            // the same registry path as the plugin's parameterChanged.
+            if (blockStart >= nextAutomation)
+            {
+                const juce::String& parameterID = automatable[automationRandom.NextInt(automatable.size())];
+
+                if (auto* parameter = host.Parameters.getParameter(parameterID))
+                    parameter->setValueNotifyingHost(automationRandom.NextFloat01());
+
+                PluginParameterRegistry::ApplyOneIfMatched(chronoverb, host.Parameters, parameterID);
+                nextAutomation += automationSamples;
+            }
+
+            block.setSize(2, blockSamples, false, false, true);
+            const bool isSilent = source.Fill(block);
+
+            const int64_t startTicks = juce::Time::getHighResolutionTicks();
+            chronoverb.ProcessBlock(block);
+            const int64_t blockTicks = juce::Time::getHighResolutionTicks() - startTicks;
+
+            Window& window = windows.back();
+            window.Ticks += blockTicks;
+            window.NumSamples += blockSamples;
+            window.NumSilentSamples += isSilent ? blockSamples : 0;
+            window.NumSubnormalOutputs += countSubnormals(block);
+            window.WorstBlockNanosecondsPerSample = std::max(window.WorstBlockNanosecondsPerSample,
+                juce::Time::highResolutionTicksToSeconds(blockTicks) * 1.0e9 / blockSamples);
+
+            blockStart += blockSamples;
+        }
+
+        return windows;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // The parameter tree starts timers, which need a message manager (never dispatched here).
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList arguments(argc, argv);
+
+    SoakSettings settings;
+
+    if (arguments.containsOption("--minutes"))
+        settings.Minutes = arguments.getValueForOption("--minutes").getDoubleValue();
+
+    if (arguments.containsOption("--window-seconds"))
+        settings.WindowSeconds = arguments.getValueForOption("--window-seconds").getDoubleValue();
+
+    if (arguments.containsOption("--rate"))
+        settings.SampleRate = arguments.getValueForOption("--rate").getDoubleValue();
+
+    if (arguments.containsOption("--block"))
+        settings.BlockSize = arguments.getValueForOption("--block").getIntValue();
+
+    if (arguments.containsOption("--automation-seconds"))
+        settings.AutomationSeconds = arguments.getValueForOption("--automation-seconds").getDoubleValue();
+
+    if (!HeadlessParameterHost::ReadRandomSeedOption(arguments, settings.RandomSeed))
+        return fail("--seed must be a whole number from 0 to 4294967295");
+
+    settings.AllowDenormals = arguments.containsOption("--allow-denormals");
+
+    if (settings.Minutes <= 0.0 || settings.WindowSeconds <= 0.0 || settings.SampleRate <= 0.0
+        || settings.BlockSize < 1 || settings.AutomationSeconds <= 0.0)
+        return fail("usage: ChronoverbSoak [--minutes=60] [--window-seconds=60] [--rate=48000] [--block=512] "
+                    "[--automation-seconds=2] [--seed=] [--allow-denormals] [--csv=] [--max-creep=]");
+
+    std::cout << "Soaking " << settings.Minutes << " simulated minutes at " << settings.SampleRate << " Hz, "
+              << settings.BlockSize << "-sample blocks" << (settings.AllowDenormals ? ", denormals allowed" : "")
+              << std::endl;
+
+    const double startMilliseconds = juce::Time::getMillisecondCounterHiRes();
+    const std::vector<Window> windows = runSoak(settings);
+    const double elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startMilliseconds) * 0.001;
+
+    //region Report
+    juce::String csv = "window_start_seconds,ns_per_sample,worst_block_ns_per_sample,silent_fraction,subnormal_outputs\n";
+
+    for (size_t index = 0; index < windows.size(); ++index)
+    {
+        const Window& window = windows[index];
+        const double startSeconds = static_cast<double>(index) * settings.WindowSeconds;
+        const double silentFraction = static_cast<double>(window.NumSilentSamples) / static_cast<double>(window.NumSamples);
+
+        std::cout << juce::String(startSeconds / 60.0, 1).paddedLeft(' ', 8) << " min"
+                  << juce::String(window.GetNanosecondsPerSample(), 1).paddedLeft(' ', 10) << " ns/sample"
+                  << "   worst block " << juce::String(window.WorstBlockNanosecondsPerSample, 1)
+                  << "   silent " << juce::roundToInt(silentFraction * 100.0) << "%"
+                  << "   subnormal outputs " << window.NumSubnormalOutputs << std::endl;
+
+        csv << juce::String(startSeconds, 1) << "," << juce::String(window.GetNanosecondsPerSample(), 3) << ","
+            << juce::String(window.WorstBlockNanosecondsPerSample, 3) << "," << juce::String(silentFraction, 4) << ","
+            << juce::String(window.NumSubnormalOutputs) << "\n";
+    }
+
+    if (arguments.containsOption("--csv") && !arguments.getFileForOption("--csv").replaceWithText(csv))
+        return fail("Couldn't write " + arguments.getFileForOption("--csv").getFullPathName());
+
+    // Creep: the last quarter of the run against the first. Stays near 1 when the cost of a
+    // decaying tail doesn't grow with time.
+    const size_t quarter = std::max<size_t>(1, windows.size() / 4);
+    const double firstQuarter = getMeanNanosecondsPerSample(windows, 0, quarter);
+    const double lastQuarter = getMeanNanosecondsPerSample(windows, windows.size() - quarter, windows.size());
+    const double creep = firstQuarter > 0.0 ? lastQuarter / firstQuarter : 0.0;
+
+    const auto worst = std::max_element(windows.begin(), windows.end(),
+        [](const Window& a, const Window& b) { return a.GetNanosecondsPerSample() < b.GetNanosecondsPerSample(); });
+
+    const double realTimeNanosecondsPerSample = 1.0e9 / settings.SampleRate;
+
+    std::cout << "First quarter " << juce::String(firstQuarter, 1) << " ns/sample, last quarter "
+              << juce::String(lastQuarter, 1) << " ns/sample (creep x" << juce::String(creep, 2) << ")" << std::endl
+              << "Worst window " << juce::String(worst->GetNanosecondsPerSample(), 1) << " ns/sample at "
+              << juce::String(static_cast<double>(worst - windows.begin()) * settings.WindowSeconds / 60.0, 1) << " min ("
+              << juce::String(100.0 * worst->GetNanosecondsPerSample() / realTimeNanosecondsPerSample, 2)
+              << "% of real time per channel pair)" << std::endl
+              << "Ran in " << juce::String(elapsedSeconds, 1) << " s" << std::endl;
+    //endregion
+
+    if (arguments.containsOption("--max-creep"))
+    {
+        const double maxCreep = arguments.getValueForOption("--max-creep").getDoubleValue();
+
+        if (creep > maxCreep)
+            return fail("Cost crept x" + juce::String(creep, 2) + ", over the x" + juce::String(maxCreep, 2) + " budget");
+    }
+
+    return 0;
+}
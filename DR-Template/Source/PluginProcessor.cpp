@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "BinaryPluginState.h"
 
 //==============================================================================
 AudioPluginAudioProcessor::AudioPluginAudioProcessor()
@@ -177,14 +178,17 @@ juce::AudioProcessorEditor* AudioPluginAudioProcessor::createEditor()
 //==============================================================================
 void AudioPluginAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    // Save all parameters as XML
-    auto xmlState = parameters.copyState().createXml();
-    copyXmlToBinary(*xmlState, destData);
+    // Parameter table in layout order (append new parameters at the end).
+    BinaryPluginState::Write(*this, destData);
 }
 
 void AudioPluginAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    // Load parameters from XML
+    // Nothing derives state from the parameters, so Read needs no parameter batch.
+    if (BinaryPluginState::Read(*this, data, sizeInBytes))
+        return;
+
+    // Sessions saved before the binary format are XML.
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
     if (xmlState != nullptr)
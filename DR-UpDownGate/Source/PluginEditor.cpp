@@ -1,5 +1,6 @@
 #include "PluginEditor.h"
 #include "BinaryData.h"
+#include "PaintProfiler.h"
 
 static FlatRotaryLookAndFeel flatKnobLAF;
 
@@ -13,7 +14,8 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
     // editor's size to whatever you need it to be.
     setSize (300, 500);
 
-    BGAndLogo = juce::ImageFileFormat::loadFrom(BinaryData::BGAndLogo_png, BinaryData::BGAndLogo_pngSize);
+    // Decoded once and shared by every open editor.
+    BGAndLogo = juce::ImageCache::getFromMemory(BinaryData::BGAndLogo_png, BinaryData::BGAndLogo_pngSize);
 
     // Range slider
     rangeSlider = std::make_unique<VerticalRangeSlider>(-60.0f, 0.0f);
@@ -80,7 +82,7 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
     {
         if (tooltipOverlay)
         {
-            tooltipOverlay->repaint();
+            tooltipOverlay->tooltipStateChanged();
         }
     };
 }
@@ -90,6 +92,8 @@ AudioPluginAudioProcessorEditor::~AudioPluginAudioProcessorEditor() = default;
 //==============================================================================c
 void AudioPluginAudioProcessorEditor::paint (juce::Graphics& graphics)
 {
+    DR_PROFILE_PAINT("Editor");
+
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     graphics.fillAll(BGGray);
 
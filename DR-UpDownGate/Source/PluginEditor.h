@@ -7,11 +7,13 @@
 #include "PluginProcessor.h"
 #include "Utils/GateLevelDisplay.h"
 #include "Utils/TooltipOverlay.h"
+#include "AnimationScheduler.h"
 #include "Utils/VerticalRangeSlider.h"
 #include "Utils/VerticalRangeSliderAttachment.h"
 
 //==============================================================================
-class AudioPluginAudioProcessorEditor  : public juce::AudioProcessorEditor
+class AudioPluginAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                         public AnimationScheduler::Host
 {
 public:
     explicit AudioPluginAudioProcessorEditor (AudioPluginAudioProcessor&);
@@ -26,11 +28,16 @@ public:
     float getAttack() const { return attackKnob ? attackKnob->getValue() : 0.0f; }
     float getRelease() const { return releaseKnob ? releaseKnob->getValue() : 0.0f; }
 
+    AnimationScheduler& GetAnimationScheduler() override { return animationScheduler; }
+
 private:
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     AudioPluginAudioProcessor& processorRef;
 
+    // Declared before any animated component so it outlives them.
+    AnimationScheduler animationScheduler { *this };
+
     juce::Image BGAndLogo;
 
     std::unique_ptr<VerticalRangeSlider> rangeSlider;
@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "BinaryPluginState.h"
 
 //==============================================================================
 AudioPluginAudioProcessor::AudioPluginAudioProcessor()
@@ -137,6 +138,9 @@ bool AudioPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 
 void AudioPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    // The envelope decays towards zero through every silence and would go denormal.
+    juce::ScopedNoDenormals noDenormals;
+
     float thresholdLow = parameters.getRawParameterValue("thresholdLow")->load();
     float thresholdHigh = parameters.getRawParameterValue("thresholdHigh")->load();
 
@@ -200,16 +204,18 @@ juce::AudioProcessorEditor* AudioPluginAudioProcessor::createEditor()
 // Loading
 void AudioPluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // Store the state of the parameters using a ValueTree.
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    // Parameter table in layout order (append new parameters at the end).
+    BinaryPluginState::Write(*this, destData);
 }
 
 // Saving
 void AudioPluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // Restore the state from the ValueTree.
+    // processBlock reads the raw values, so Read needs no parameter batch.
+    if (BinaryPluginState::Read(*this, data, sizeInBytes))
+        return;
+
+    // Sessions saved before the binary format are XML.
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary (data, sizeInBytes));
 
     if (xmlState.get() != nullptr)
@@ -3,6 +3,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "Theme.h"
 #include "FlatTextBox.h"
+#include "PaintProfiler.h"
 
 class FlatRotaryLookAndFeel : public juce::LookAndFeel_V4
 {
@@ -20,6 +21,8 @@ public:
         float RotaryEndAngle,
         juce::Slider& Slider) override
     {
+        DR_PROFILE_PAINT("FlatRotaryLookAndFeel::drawRotarySlider");
+
         juce::Rectangle<int> Bounds(X, Y, Width, Height);
 
         float Diameter = juce::jmin(static_cast<float>(Width), static_cast<float>(Height)) - 8.0f;
@@ -1,18 +1,76 @@
 #include "GateLevelDisplay.h"
 #include "Theme.h"
+#include "PaintProfiler.h"
 
 GateLevelDisplay::GateLevelDisplay(AudioPluginAudioProcessor& audioProcessor,
                                    VerticalRangeSlider& thresholdSlider)
     : processorRef(audioProcessor),
       rangeSliderRef(thresholdSlider)
 {
-    startTimerHz(30);
 }
 
-void GateLevelDisplay::timerCallback()
+bool GateLevelDisplay::AdvanceAnimation(double frameTimeSeconds)
 {
+    // Keep the meter at its old rate on high refresh displays.
+    if (frameTimeSeconds - lastPollTimeSeconds < PollIntervalSeconds)
+        return true;
+
+    lastPollTimeSeconds = frameTimeSeconds;
+
     currentLevelDecibels = processorRef.getVisualInputLevelDb();
-    repaint();
+
+    // Stays scheduled, and keeps the level current, while hidden: an ancestor being shown
+    // again doesn't notify this component, so dropping off here would leave the meter
+    // frozen. Only the repaint is skipped, and the next visible frame repaints everything.
+    if (!isShowing())
+    {
+        paintedLevelY = -1;
+        paintedThresholdLowY = -1;
+        paintedThresholdHighY = -1;
+
+        return true;
+    }
+
+    const int levelY = juce::roundToInt(decibelsToY(currentLevelDecibels));
+    const int thresholdLowY = juce::roundToInt(decibelsToY(rangeSliderRef.getLowerValue()));
+    const int thresholdHighY = juce::roundToInt(decibelsToY(rangeSliderRef.getUpperValue()));
+
+    if (thresholdLowY != paintedThresholdLowY || thresholdHighY != paintedThresholdHighY)
+    {
+        repaint();
+    }
+    else if (levelY != paintedLevelY)
+    {
+        // Only the strip between the old and new meter tops changes.
+        const int top = juce::jmin(levelY, paintedLevelY) - 1;
+        const int bottom = juce::jmax(levelY, paintedLevelY) + 1;
+
+        repaint(0, top, getWidth(), bottom - top);
+    }
+
+    paintedLevelY = levelY;
+    paintedThresholdLowY = thresholdLowY;
+    paintedThresholdHighY = thresholdHighY;
+
+    return true;
+}
+
+void GateLevelDisplay::updateScheduling()
+{
+    // Keyed on this component's own visibility, which does notify us. Whether the
+    // ancestors are showing is checked per frame.
+    if (isVisible())
+    {
+        paintedLevelY = -1;
+        paintedThresholdLowY = -1;
+        paintedThresholdHighY = -1;
+
+        StartAnimating(*this);
+    }
+    else
+    {
+        StopAnimating();
+    }
 }
 
 float GateLevelDisplay::decibelsToY(float decibelValue) const
@@ -30,6 +88,8 @@ float GateLevelDisplay::decibelsToY(float decibelValue) const
 
 void GateLevelDisplay::paint(juce::Graphics& graphics)
 {
+    DR_PROFILE_PAINT("GateLevelDisplay");
+
     juce::Rectangle<float> bounds = getLocalBounds().toFloat();
 
     graphics.setColour(juce::Colours::black.withAlpha(0.25f));
@@ -81,4 +141,14 @@ void GateLevelDisplay::paint(juce::Graphics& graphics)
 
 void GateLevelDisplay::resized()
 {
+}
+
+void GateLevelDisplay::parentHierarchyChanged()
+{
+    updateScheduling();
+}
+
+void GateLevelDisplay::visibilityChanged()
+{
+    updateScheduling();
 }
\ No newline at end of file
@@ -3,9 +3,12 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "../PluginProcessor.h"
 #include "VerticalRangeSlider.h"
+#include "AnimationScheduler.h"
 
+// Polls the input level on the editor's AnimationScheduler while visible, and repaints
+// only when it is showing and the meter or the threshold lines would move by at least a pixel.
 class GateLevelDisplay : public juce::Component,
-                         private juce::Timer
+                         private AnimationScheduler::Client
 {
 public:
     GateLevelDisplay(AudioPluginAudioProcessor& audioProcessor,
@@ -15,9 +18,14 @@ public:
 
     void paint(juce::Graphics& graphics) override;
     void resized() override;
+    void parentHierarchyChanged() override;
+    void visibilityChanged() override;
 
 private:
-    void timerCallback() override;
+    static constexpr double PollIntervalSeconds = 1.0 / 30.0;
+
+    bool AdvanceAnimation(double frameTimeSeconds) override;
+    void updateScheduling();
     float decibelsToY(float decibelValue) const;
 
     AudioPluginAudioProcessor& processorRef;
@@ -25,5 +33,10 @@ private:
 
     float currentLevelDecibels = -60.0f;
 
+    double lastPollTimeSeconds = 0.0;
+    int paintedLevelY = -1;
+    int paintedThresholdLowY = -1;
+    int paintedThresholdHighY = -1;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GateLevelDisplay)
 };
\ No newline at end of file
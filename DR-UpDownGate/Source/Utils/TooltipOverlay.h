@@ -3,9 +3,13 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "VerticalRangeSlider.h"
 #include "Theme.h"
+#include "PaintProfiler.h"
+#include "AnimationScheduler.h"
 
+// Idle until tooltipStateChanged() is called (wire it to the slider's OnTooltipStateChanged),
+// then ticks on the editor's AnimationScheduler until the fade has settled.
 class TooltipOverlay : public juce::Component,
-                       private juce::Timer
+                       private AnimationScheduler::Client
 {
 public:
     explicit TooltipOverlay(VerticalRangeSlider& verticalRangeSlider)
@@ -13,11 +17,17 @@ public:
     {
         setInterceptsMouseClicks(false, false);
         setAlwaysOnTop(true);
-        startTimerHz(60);
+    }
+
+    void tooltipStateChanged()
+    {
+        StartAnimating(*this);
     }
 
     void paint(juce::Graphics& graphics) override
     {
+        DR_PROFILE_PAINT("TooltipOverlay");
+
         if (currentAlpha <= 0.001f)
         {
             return;
@@ -28,57 +38,10 @@ public:
             return;
         }
 
-        constexpr float tooltipHeight = 24.0f;
-        constexpr float tooltipHorizontalPadding = 8.0f;
-        constexpr float tooltipVerticalGap = 10.0f;
-        constexpr float tooltipCornerRadius = 6.0f;
-
-        juce::Font tooltipFont(14.0f);
+        juce::Font tooltipFont(tooltipFontHeight);
         graphics.setFont(tooltipFont);
 
-        float tooltipWidth = static_cast<float>(tooltipFont.getStringWidth(cachedTooltipText))
-                             + (tooltipHorizontalPadding * 2.0f);
-
-        float tooltipXPosition = cachedThumbBounds.getCentreX() - (tooltipWidth * 0.5f);
-        float tooltipYPosition = 0.0f;
-
-        if (cachedActiveThumb == VerticalRangeSlider::UpperThumb)
-        {
-            tooltipYPosition = cachedThumbBounds.getY() - tooltipVerticalGap - tooltipHeight;
-        }
-        else
-        {
-            tooltipYPosition = cachedThumbBounds.getBottom() + tooltipVerticalGap;
-        }
-
-        juce::Rectangle<float> tooltipBounds(
-            tooltipXPosition,
-            tooltipYPosition,
-            tooltipWidth,
-            tooltipHeight
-        );
-
-        juce::Rectangle<float> overlayBounds = getLocalBounds().toFloat();
-
-        if (tooltipBounds.getX() < overlayBounds.getX())
-        {
-            tooltipBounds.setX(overlayBounds.getX());
-        }
-
-        if (tooltipBounds.getRight() > overlayBounds.getRight())
-        {
-            tooltipBounds.setX(overlayBounds.getRight() - tooltipWidth);
-        }
-
-        if (tooltipBounds.getY() < overlayBounds.getY())
-        {
-            tooltipBounds.setY(overlayBounds.getY());
-        }
-
-        if (tooltipBounds.getBottom() > overlayBounds.getBottom())
-        {
-            tooltipBounds.setY(overlayBounds.getBottom() - tooltipHeight);
-        }
+        juce::Rectangle<float> tooltipBounds = calculateTooltipArea();
 
         juce::Colour backgroundColour = AccentGray.darker(0.25f).withAlpha(currentAlpha);
         juce::Colour textColour = juce::Colours::white.withAlpha(currentAlpha);
@@ -96,8 +59,19 @@ public:
     }
 
 private:
-    void timerCallback() override
+    static constexpr float tooltipHeight = 24.0f;
+    static constexpr float tooltipHorizontalPadding = 8.0f;
+    static constexpr float tooltipVerticalGap = 10.0f;
+    static constexpr float tooltipCornerRadius = 6.0f;
+    static constexpr float tooltipFontHeight = 14.0f;
+
+    bool AdvanceAnimation(double frameTimeSeconds) override
     {
+        juce::ignoreUnused(frameTimeSeconds);
+
+        const juce::Rectangle<float> previousArea = calculateTooltipArea();
+        bool shouldRepaint = false;
+
         bool shouldShowTooltip = trackedSlider.shouldShowTooltip();
 
         if (shouldShowTooltip)
@@ -110,6 +84,10 @@ private:
                 && !latestTooltipText.isEmpty()
                 && latestActiveThumb != VerticalRangeSlider::NoThumb)
             {
+                shouldRepaint = cachedThumbBounds != latestThumbBounds
+                                || cachedTooltipText != latestTooltipText
+                                || cachedActiveThumb != latestActiveThumb;
+
                 cachedThumbBounds = latestThumbBounds;
                 cachedTooltipText = latestTooltipText;
                 cachedActiveThumb = latestActiveThumb;
@@ -123,12 +101,12 @@ private:
         if (currentAlpha < targetAlpha)
         {
             currentAlpha = juce::jmin(targetAlpha, currentAlpha + fadeInSpeed);
-            repaint();
+            shouldRepaint = true;
         }
         else if (currentAlpha > targetAlpha)
         {
             currentAlpha = juce::jmax(targetAlpha, currentAlpha - fadeOutSpeed);
-            repaint();
+            shouldRepaint = true;
 
             if (currentAlpha <= 0.001f)
             {
@@ -137,6 +115,71 @@ private:
                 cachedActiveThumb = VerticalRangeSlider::NoThumb;
             }
         }
+
+        // Only the old and new tooltip areas need repainting, not the whole overlay.
+        if (shouldRepaint)
+        {
+            repaint(previousArea.getUnion(calculateTooltipArea()).getSmallestIntegerContainer().expanded(1));
+        }
+
+        return currentAlpha != targetAlpha;
+    }
+
+    // Where the tooltip sits for the cached thumb, or empty when there is nothing to show.
+    juce::Rectangle<float> calculateTooltipArea() const
+    {
+        if (cachedThumbBounds.isEmpty() || cachedTooltipText.isEmpty() || cachedActiveThumb == VerticalRangeSlider::NoThumb)
+        {
+            return {};
+        }
+
+        juce::Font tooltipFont(tooltipFontHeight);
+
+        float tooltipWidth = static_cast<float>(tooltipFont.getStringWidth(cachedTooltipText))
+                             + (tooltipHorizontalPadding * 2.0f);
+
+        float tooltipXPosition = cachedThumbBounds.getCentreX() - (tooltipWidth * 0.5f);
+        float tooltipYPosition = 0.0f;
+
+        if (cachedActiveThumb == VerticalRangeSlider::UpperThumb)
+        {
+            tooltipYPosition = cachedThumbBounds.getY() - tooltipVerticalGap - tooltipHeight;
+        }
+        else
+        {
+            tooltipYPosition = cachedThumbBounds.getBottom() + tooltipVerticalGap;
+        }
+
+        juce::Rectangle<float> tooltipBounds(
+            tooltipXPosition,
+            tooltipYPosition,
+            tooltipWidth,
+            tooltipHeight
+        );
+
+        juce::Rectangle<float> overlayBounds = getLocalBounds().toFloat();
+
+        if (tooltipBounds.getX() < overlayBounds.getX())
+        {
+            tooltipBounds.setX(overlayBounds.getX());
+        }
+
+        if (tooltipBounds.getRight() > overlayBounds.getRight())
+        {
+            tooltipBounds.setX(overlayBounds.getRight() - tooltipWidth);
+        }
+
+        if (tooltipBounds.getY() < overlayBounds.getY())
+        {
+            tooltipBounds.setY(overlayBounds.getY());
+        }
+
+        if (tooltipBounds.getBottom() > overlayBounds.getBottom())
+        {
+            tooltipBounds.setY(overlayBounds.getBottom() - tooltipHeight);
+        }
+
+        return tooltipBounds;
     }
 
     VerticalRangeSlider& trackedSlider;
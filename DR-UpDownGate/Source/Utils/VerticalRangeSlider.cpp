@@ -1,5 +1,6 @@
 #include "VerticalRangeSlider.h"
 #include "Theme.h"
+#include "PaintProfiler.h"
 
 VerticalRangeSlider::VerticalRangeSlider(float minimumValue, float maximumValue)
     : minValue(minimumValue),
@@ -251,6 +252,8 @@ juce::String VerticalRangeSlider::getActiveThumbTooltipText() const
 
 void VerticalRangeSlider::paint(juce::Graphics& Graphics)
 {
+    DR_PROFILE_PAINT("VerticalRangeSlider");
+
     juce::Rectangle Bounds = getLocalBounds().toFloat();
 
     Graphics.setColour(AccentGray.brighter(0.02f));
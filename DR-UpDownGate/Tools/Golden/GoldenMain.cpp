@@ -0,0 +1,108 @@
+// UpDownGateGolden: golden-output regression test. Runs a fixed stereo signal whose level
+// sweeps through both thresholds through the gate, and checks each channel against the
+// golden in Tools/Golden/Goldens. Exits with 1 on any failure, a missing golden included.
+// Registered with CTest when built with -DDR_BUILD_TOOLS=ON, once Tools/Golden/Goldens
+// exists.
+//
+//   UpDownGateGolden --goldens=<folder> [--update] [--allow-missing] [--max-abs=1e-6]
+//
+// --update rewrites the golden from this build; see Utils/GoldenRegression.h at the repo
+// root.
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include "GoldenRegression.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double SampleRate = 48000.0;
+    constexpr int BlockSize = 512;
+    constexpr juce::int64 NoiseSeed = 0x5EEDC0DE;
+
+    // 220 Hz sine on the left and white noise on the right (so a swapped or dropped channel
+    // shows), under an envelope that rises from -60 to 0 dB and falls back over the signal.
+    juce::AudioBuffer<float> makeLevelSweep(double seconds)
+    {
+        juce::AudioBuffer<float> buffer(2, static_cast<int>(seconds * SampleRate));
+        juce::Random noise(NoiseSeed);
+
+        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        {
+            const double position = static_cast<double>(sample) / buffer.getNumSamples();
+            const float levelDecibels = static_cast<float>(-60.0 * std::abs(2.0 * position - 1.0));
+            const float gain = juce::Decibels::decibelsToGain(levelDecibels, -100.0f);
+
+            const double time = sample / SampleRate;
+
+            buffer.setSample(0, sample, gain * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 220.0 * time)));
+            buffer.setSample(1, sample, gain * (2.0f * noise.nextFloat() - 1.0f));
+        }
+
+        return buffer;
+    }
+
+    // In place, block by block, as a host would.
+    juce::AudioBuffer<float> render(juce::AudioBuffer<float> buffer, const std::vector<std::pair<const char*, float>>& settings)
+    {
+        AudioPluginAudioProcessor processor;
+
+        for (const auto& [parameterID, value] : settings)
+        {
+            auto* parameter = processor.parameters.getParameter(parameterID);
+            jassert(parameter != nullptr);
+
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        }
+
+        processor.setRateAndBufferSizeDetails(SampleRate, BlockSize);
+        processor.prepareToPlay(SampleRate, BlockSize);
+
+        for (int blockStart = 0; blockStart < buffer.getNumSamples(); blockStart += BlockSize)
+        {
+            const int blockSamples = std::min(BlockSize, buffer.getNumSamples() - blockStart);
+
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, blockStart, blockSamples);
+            juce::MidiBuffer midi;
+            processor.processBlock(block, midi);
+        }
+
+        processor.releaseResources();
+        return buffer;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList arguments(argc, argv);
+    const auto options = GoldenRegression::ReadOptions(arguments);
+
+    if (!options.has_value())
+        return 1;
+
+    // The gate is a switch on a smoothed level, so anything past float noise is a change.
+    const float maxAbsoluteError = arguments.containsOption("--max-abs")
+        ? arguments.getValueForOption("--max-abs").getFloatValue()
+        : 1.0e-6f;
+
+    GoldenRegression::Checker checker(*options, GoldenRegression::MaxAbsoluteErrorWithin(maxAbsoluteError));
+
+    // Open between -30 and -6 dB, with fast enough envelope times that the gate opens and
+    // closes on both the way up and the way down.
+    checker.CheckAudio("UpDownGate_LevelSweep", render(makeLevelSweep(1.5),
+    {
+        { "thresholdLow",  -30.0f },
+        { "thresholdHigh",  -6.0f },
+        { "attack",         10.0f },
+        { "release",        50.0f }
+    }), SampleRate);
+
+    return checker.GetExitCode();
+}
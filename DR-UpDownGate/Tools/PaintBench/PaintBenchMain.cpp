@@ -0,0 +1,177 @@
+// UpDownGatePaintBench: headless paint benchmark for the Up-down gate editor. Builds the
+// editor offscreen, drives scripted scenarios through it (knob drags, range slider drags
+// with their tooltip fades, the GateLevelDisplay following a moving input level) and
+// reports the paint cost per component against a ms budget. Exits with 1 when anything is
+// over budget.
+//
+//   UpDownGatePaintBench [--frames=240] [--component-avg-ms=0.5] [--component-worst-ms=4]
+//                        [--frame-avg-ms=8]
+//
+// How frames are driven and timed is described in Utils/PaintBenchmark.h at the repo root.
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "PaintBenchmark.h"
+#include "../../Source/PluginEditor.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double SampleRate = 48000.0;
+
+    // One 60 fps frame of audio.
+    constexpr int BlockSize = 800;
+
+    // A sine through the processor every frame, at whatever level the scenario asks for,
+    // so the GateLevelDisplay has a level to follow.
+    class AudioFeed
+    {
+    public:
+        explicit AudioFeed(AudioPluginAudioProcessor& processorToFeed)
+            : processor(processorToFeed), buffer(2, BlockSize)
+        {
+            processor.prepareToPlay(SampleRate, BlockSize);
+        }
+
+        ~AudioFeed()
+        {
+            processor.releaseResources();
+        }
+
+        void ProcessFrame(float levelDecibels)
+        {
+            const float gain = juce::Decibels::decibelsToGain(levelDecibels);
+
+            for (int sample = 0; sample < BlockSize; ++sample)
+            {
+                const float value = gain * static_cast<float>(std::sin(phase));
+                phase += juce::MathConstants<double>::twoPi * 220.0 / SampleRate;
+
+                buffer.setSample(0, sample, value);
+                buffer.setSample(1, sample, value);
+            }
+
+            phase = std::fmod(phase, juce::MathConstants<double>::twoPi);
+
+            juce::MidiBuffer midi;
+            processor.processBlock(buffer, midi);
+        }
+
+    private:
+        AudioPluginAudioProcessor& processor;
+        juce::AudioBuffer<float> buffer;
+        double phase = 0.0;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList arguments(argc, argv);
+
+    const int numFrames = arguments.containsOption("--frames")
+        ? arguments.getValueForOption("--frames").getIntValue()
+        : 240;
+
+    if (numFrames < 1)
+    {
+        std::cerr << "usage: UpDownGatePaintBench [--frames=240] [--component-avg-ms=] "
+                     "[--component-worst-ms=] [--frame-avg-ms=]" << std::endl;
+        return 1;
+    }
+
+    AudioPluginAudioProcessor processor;
+    AudioFeed audioFeed(processor);
+
+    std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+    auto& animationScheduler = dynamic_cast<AnimationScheduler::Host&>(*editor).GetAnimationScheduler();
+
+    PaintBenchmark::Runner runner(*editor,
+        [&animationScheduler](double frameTimeSeconds) { animationScheduler.AdvanceFrame(frameTimeSeconds); },
+        PaintBenchmark::ReadBudget(arguments));
+
+    PaintBenchmark::ScriptedMouse mouse;
+
+    std::cout << "Up-down gate editor " << editor->getWidth() << "x" << editor->getHeight() << "\n";
+
+    runner.Run("Idle", numFrames, [&](int)
+    {
+        audioFeed.ProcessFrame(-24.0f);
+    });
+
+    // The input swings between -60 and 0 dB every two seconds, so the meter moves on every
+    // poll and crosses both threshold lines.
+    runner.Run("GateLevelDisplay", numFrames, [&](int frameIndex)
+    {
+        const double phase = juce::MathConstants<double>::twoPi * frameIndex / 120.0;
+        audioFeed.ProcessFrame(static_cast<float>(-30.0 + 30.0 * std::sin(phase)));
+    });
+
+    const auto knobs = PaintBenchmark::FindAll<juce::Slider>(*editor);
+
+    runner.Run("Knob drags", numFrames, [&](int frameIndex)
+    {
+        PaintBenchmark::StepSliderDrags(mouse, knobs, frameIndex);
+        audioFeed.ProcessFrame(-24.0f);
+    });
+
+    // The pointer sweeps down the range slider (hovering both thumbs), grabs the middle of
+    // it and drags, then leaves and the tooltip fades out.
+    const auto rangeSliders = PaintBenchmark::FindAll<VerticalRangeSlider>(*editor);
+
+    runner.Run("Range slider and tooltip fades", numFrames, [&](int frameIndex)
+    {
+        constexpr int FramesPerSweep = 40;
+        constexpr int FramesPerDrag = 20;
+        constexpr int FramesPerGesture = 120;
+
+        if (!rangeSliders.empty())
+        {
+            auto& slider = *rangeSliders[static_cast<size_t>(frameIndex / FramesPerGesture) % rangeSliders.size()];
+            const int phase = frameIndex % FramesPerGesture;
+
+            const float centreX = slider.getWidth() * 0.5f;
+            const juce::Point<float> grabPoint(centreX, slider.getHeight() * 0.25f);
+
+            if (phase < FramesPerSweep)
+            {
+                const float y = slider.getHeight() * (static_cast<float>(phase) + 0.5f) / FramesPerSweep;
+                mouse.Move(slider, { centreX, y });
+            }
+            else if (phase == FramesPerSweep)
+            {
+                mouse.Down(slider, grabPoint);
+            }
+            else if (phase < FramesPerSweep + FramesPerDrag)
+            {
+                const float offset = 3.0f * static_cast<float>(phase - FramesPerSweep);
+                mouse.Drag(slider, grabPoint.translated(0.0f, offset));
+            }
+            else if (phase == FramesPerSweep + FramesPerDrag)
+            {
+                mouse.Up(slider, grabPoint.translated(0.0f, 3.0f * FramesPerDrag));
+                mouse.Exit(slider);
+            }
+        }
+
+        audioFeed.ProcessFrame(-24.0f);
+    });
+
+    editor.reset();
+
+    if (!runner.AllWithinBudget())
+    {
+        std::cout << "Over budget" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Within budget" << std::endl;
+    return 0;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+// Editor-wide frame clock for UI animation and telemetry.
+//
+// Components schedule themselves while they have something to animate and are advanced
+// once per display refresh through a VBlankAttachment on the editor. Frame times come from
+// the hi-res millisecond counter, as JUCE 7's vblank callback (UpDownGate) passes none. A client drops off
+// the schedule by returning false once it has settled, and when nobody is scheduled the
+// vblank callback is detached, so an idle editor does no periodic work at all. Clients
+// repaint only the area that changed. Message thread only.
+class AnimationScheduler : private juce::AsyncUpdater
+{
+public:
+    class Client
+    {
+    public:
+        virtual ~Client()
+        {
+            StopAnimating();
+        }
+
+    protected:
+        // Schedules the client on the editor the component sits in. Returns false when the
+        // component isn't inside an editor yet, in which case callers should jump straight
+        // to their end state.
+        bool StartAnimating(juce::Component& component)
+        {
+            if (scheduler == nullptr)
+                scheduler = AnimationScheduler::Find(component);
+
+            if (scheduler == nullptr)
+                return false;
+
+            scheduler->schedule(*this);
+            return true;
+        }
+
+        void StopAnimating()
+        {
+            if (scheduler != nullptr)
+                scheduler->cancel(*this);
+        }
+
+        // Called once per frame while scheduled. Return false once settled.
+        virtual bool AdvanceAnimation(double frameTimeSeconds) = 0;
+
+    private:
+        friend class AnimationScheduler;
+
+        AnimationScheduler* scheduler = nullptr;
+    };
+
+    // Implemented by the editor that owns the scheduler, so components can find it.
+    class Host
+    {
+    public:
+        virtual ~Host() = default;
+        virtual AnimationScheduler& GetAnimationScheduler() = 0;
+    };
+
+    explicit AnimationScheduler(juce::Component& editorComponent)
+        : editor(editorComponent) {}
+
+    ~AnimationScheduler() override
+    {
+        cancelPendingUpdate();
+
+        for (auto* client : clients)
+            if (client != nullptr)
+                client->scheduler = nullptr;
+    }
+
+    static AnimationScheduler* Find(juce::Component& component)
+    {
+        if (auto* host = dynamic_cast<Host*>(&component))
+            return &host->GetAnimationScheduler();
+
+        if (auto* host = component.findParentComponentOfClass<Host>())
+            return &host->GetAnimationScheduler();
+
+        return nullptr;
+    }
+
+    // Runs one frame by hand, for headless runs (the paint benchmark) where no vblank
+    // ever arrives.
+    void AdvanceFrame(double frameTimeSeconds)
+    {
+        tick(frameTimeSeconds);
+    }
+
+private:
+    void schedule(Client& client)
+    {
+        if (std::find(clients.begin(), clients.end(), &client) == clients.end())
+            clients.push_back(&client);
+
+        if (vBlankAttachment == nullptr)
+            vBlankAttachment = std::make_unique<juce::VBlankAttachment>(&editor,
+                [this] { tick(juce::Time::getMillisecondCounterHiRes() * 0.001); });
+    }
+
+    // Only clears the slot, so clients can cancel themselves or others mid-tick.
+    void cancel(Client& client)
+    {
+        std::replace(clients.begin(), clients.end(), &client, static_cast<Client*>(nullptr));
+    }
+
+    void tick(double frameTimeSeconds)
+    {
+        // Indexed on purpose: clients scheduled during the loop are appended and run this frame.
+        for (size_t i = 0; i < clients.size(); ++i)
+            if (clients[i] != nullptr && !clients[i]->AdvanceAnimation(frameTimeSeconds))
+                clients[i] = nullptr;
+
+        clients.erase(std::remove(clients.begin(), clients.end(), nullptr), clients.end());
+
+        // The attachment can't be destroyed from inside its own callback.
+        if (clients.empty())
+            triggerAsyncUpdate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        if (clients.empty())
+            vBlankAttachment.reset();
+    }
+
+    juce::Component& editor;
+    std::unique_ptr<juce::VBlankAttachment> vBlankAttachment;
+    std::vector<Client*> clients;
+
+    JUCE_DECLARE_NON_COPYABLE(AnimationScheduler)
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+// Compact, versioned binary plugin state.
+//
+// Layout (little endian):
+//   uint32 Magic, uint32 Version, uint32 NumParameters
+//   float  normalised value per parameter, in processor (registry) order
+//   uint32 NumBlobs, then per blob: uint32 Tag, uint32 Size, Size bytes
+//
+// Loading is a straight read into the parameters, with no XML tree to parse or allocate.
+// Parameters are matched by position, so new parameters must be appended to the end of
+// the layout; ones missing from an older session are reset to their defaults. Blobs carry
+// extra non-parameter state and unknown tags are skipped.
+class BinaryPluginState
+{
+public:
+    static constexpr uint32_t Magic = 0x53505244; // "DRPS"
+    static constexpr uint32_t Version = 1;
+
+    struct Blob
+    {
+        uint32_t Tag = 0;
+        const void* Data = nullptr;
+        uint32_t Size = 0;
+    };
+
+    static void Write(const juce::AudioProcessor& processor, juce::MemoryBlock& destData,
+                      std::initializer_list<Blob> blobs = {})
+    {
+        const auto& parameters = processor.getParameters();
+
+        destData.reset();
+        juce::MemoryOutputStream stream(destData, false);
+
+        stream.writeInt(static_cast<int>(Magic));
+        stream.writeInt(static_cast<int>(Version));
+        stream.writeInt(parameters.size());
+
+        for (const auto* parameter : parameters)
+            stream.writeFloat(parameter->getValue());
+
+        stream.writeInt(static_cast<int>(blobs.size()));
+
+        for (const auto& blob : blobs)
+        {
+            stream.writeInt(static_cast<int>(blob.Tag));
+            stream.writeInt(static_cast<int>(blob.Size));
+            stream.write(blob.Data, blob.Size);
+        }
+    }
+
+    // Returns false when the data is not in this format (e.g. an XML session saved by an
+    // older version), leaving the parameters untouched so the caller can fall back.
+    //
+    // Values go through setValueNotifyingHost, as in APVTS::replaceState, so the host and
+    // the editor see the restored session. That notifies parameter listeners once per
+    // parameter; a processor whose listeners rebuild derived state wraps Read in its own
+    // parameter batch (see Chronoverb's setStateInformation).
+    static bool Read(juce::AudioProcessor& processor, const void* data, int sizeInBytes,
+                     const std::function<void(const Blob&)>& onBlob = nullptr)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        const auto totalSize = static_cast<size_t>(std::max(0, sizeInBytes));
+        size_t position = 0;
+
+        auto readUInt = [&](uint32_t& value)
+        {
+            if (totalSize - position < sizeof(uint32_t))
+                return false;
+
+            value = juce::ByteOrder::littleEndianInt(bytes + position);
+            position += sizeof(uint32_t);
+            return true;
+        };
+
+        uint32_t magic = 0, version = 0, numValues = 0;
+
+        if (bytes == nullptr || !readUInt(magic) || magic != Magic
+            || !readUInt(version) || version == 0 || version > Version
+            || !readUInt(numValues)
+            || (totalSize - position) / sizeof(float) < numValues)
+        {
+            return false;
+        }
+
+        const auto& parameters = processor.getParameters();
+
+        for (int i = 0; i < parameters.size(); ++i)
+        {
+            auto* parameter = parameters.getUnchecked(i);
+            float value = parameter->getDefaultValue();
+
+            if (static_cast<uint32_t>(i) < numValues)
+            {
+                const uint32_t rawValue = juce::ByteOrder::littleEndianInt(bytes + position + static_cast<size_t>(i) * sizeof(float));
+                std::memcpy(&value, &rawValue, sizeof(float));
+            }
+
+            parameter->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, value));
+        }
+
+        position += static_cast<size_t>(numValues) * sizeof(float);
+
+        uint32_t numBlobs = 0;
+
+        if (!readUInt(numBlobs))
+            return true;
+
+        for (uint32_t i = 0; i < numBlobs; ++i)
+        {
+            Blob blob;
+
+            if (!readUInt(blob.Tag) || !readUInt(blob.Size) || totalSize - position < blob.Size)
+                break;
+
+            blob.Data = bytes + position;
+            position += blob.Size;
+
+            if (onBlob != nullptr)
+                onBlob(blob);
+        }
+
+        return true;
+    }
+};
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+// Golden-output regression checks, shared by the plugins' Tools/Golden apps.
+//
+// Each app renders fixed input signals through its processor, with fixed seeds, and checks
+// the result against goldens checked in next to it (Tools/Golden/Goldens):
+//   - audio as 32-bit float WAVs, compared channel by channel, so a change that only moves
+//     one side (or moves both in opposite directions) can't cancel out in a L/R average;
+//   - MIDI as text, one event per line ("<sample> <hex bytes>"), compared exactly.
+// A golden that doesn't match, can't be read or is missing is a failure, so deleting a
+// golden can't turn the test green. With --allow-missing, missing goldens are reported as
+// skipped instead (exit SkipExitCode) - only for a local run before the first --update.
+//
+// When an output change is intended, run the app with --update to rewrite the goldens and
+// commit them with the change. Write them from a release build.
+//
+//   <App> --goldens=<folder> [--update] [--allow-missing]
+namespace GoldenRegression
+{
+    // Exit code for a --allow-missing run that found no failures but was missing goldens.
+    constexpr int SkipExitCode = 77;
+
+    struct Options
+    {
+        juce::File GoldensFolder;
+        bool Update = false;
+        bool AllowMissing = false;
+    };
+
+    // nullopt, after printing the usage, without --goldens=.
+    inline std::optional<Options> ReadOptions(const juce::ArgumentList& arguments)
+    {
+        if (!arguments.containsOption("--goldens"))
+        {
+            std::cerr << "usage: " << arguments.executableName << " --goldens=<folder> [--update] [--allow-missing]"
+                      << std::endl;
+            return std::nullopt;
+        }
+
+        Options options;
+        options.GoldensFolder = arguments.getFileForOption("--goldens");
+        options.Update = arguments.containsOption("--update");
+        options.AllowMissing = arguments.containsOption("--allow-missing");
+
+        return options;
+    }
+
+    struct ChannelResult
+    {
+        bool Passed = true;
+
+        // Printed after the channel name, e.g. "max abs 3e-07".
+        juce::String Details;
+    };
+
+    // Checks one channel of a render against the same channel of its golden. Both are the
+    // same length.
+    using ChannelComparator = std::function<ChannelResult(const std::vector<float>& golden,
+                                                          const std::vector<float>& rendered,
+                                                          double sampleRate)>;
+
+    // Passes when no sample is further than maxAbsoluteError from the golden.
+    inline ChannelComparator MaxAbsoluteErrorWithin(float maxAbsoluteError)
+    {
+        return [maxAbsoluteError](const std::vector<float>& golden, const std::vector<float>& rendered, double)
+        {
+            float largestError = 0.0f;
+
+            for (size_t i = 0; i < golden.size(); ++i)
+                largestError = std::max(largestError, std::abs(rendered[i] - golden[i]));
+
+            return ChannelResult { largestError <= maxAbsoluteError, "max abs " + juce::String(largestError) };
+        };
+    }
+
+    // One line of a MIDI golden.
+    inline juce::String DescribeMidiEvent(int64_t samplePosition, const juce::MidiMessage& message)
+    {
+        return juce::String(samplePosition) + " "
+             + juce::String::toHexString(message.getRawData(), message.getRawDataSize());
+    }
+
+    class Checker
+    {
+    public:
+        // comparatorToUse is the default for CheckAudio; only needed if some case doesn't pass
+        // its own.
+        explicit Checker(const Options& optionsToUse, ChannelComparator comparatorToUse = {})
+            : options(optionsToUse), comparator(std::move(comparatorToUse))
+        {
+            if (options.Update)
+                options.GoldensFolder.createDirectory();
+        }
+
+        // caseComparator, when set, replaces the Checker's comparator for this case only.
+        void CheckAudio(const juce::String& caseName, const juce::AudioBuffer<float>& rendered, double sampleRate,
+                        const ChannelComparator& caseComparator = {})
+        {
+            const juce::File goldenFile = options.GoldensFolder.getChildFile(caseName + ".wav");
+
+            if (options.Update)
+            {
+                report(caseName, writeAudio(goldenFile, rendered, sampleRate), "wrote " + goldenFile.getFileName());
+                return;
+            }
+
+            if (!goldenFile.existsAsFile())
+            {
+                reportMissing(caseName, goldenFile);
+                return;
+            }
+
+            juce::AudioBuffer<float> golden;
+            double goldenSampleRate = 0.0;
+
+            if (!readAudio(goldenFile, golden, goldenSampleRate))
+            {
+                report(caseName, false, "can't read " + goldenFile.getFullPathName());
+                return;
+            }
+
+            if (goldenSampleRate != sampleRate
+                || golden.getNumChannels() != rendered.getNumChannels()
+                || golden.getNumSamples() != rendered.getNumSamples())
+            {
+                report(caseName, false, "golden is " + describeFormat(golden, goldenSampleRate)
+                                        + ", render is " + describeFormat(rendered, sampleRate));
+                return;
+            }
+
+            const ChannelComparator& compare = caseComparator != nullptr ? caseComparator : comparator;
+            jassert(compare != nullptr);
+
+            bool passed = true;
+            juce::String details;
+
+            for (int channel = 0; channel < rendered.getNumChannels(); ++channel)
+            {
+                const auto result = compare(getChannel(golden, channel), getChannel(rendered, channel), sampleRate);
+
+                passed = passed && result.Passed;
+                details << "\n    " << getChannelName(channel, rendered.getNumChannels()) << "  " << result.Details
+                        << (result.Passed ? "" : "   OVER BUDGET");
+            }
+
+            report(caseName, passed, details);
+        }
+
+        // renderedEvents: DescribeMidiEvent lines, in output order.
+        void CheckMidi(const juce::String& caseName, const juce::StringArray& renderedEvents)
+        {
+            const juce::File goldenFile = options.GoldensFolder.getChildFile(caseName + ".txt");
+
+            if (options.Update)
+            {
+                const bool written = goldenFile.replaceWithText(renderedEvents.joinIntoString("\n") + "\n", false, false, "\n");
+                report(caseName, written, "wrote " + goldenFile.getFileName());
+                return;
+            }
+
+            if (!goldenFile.existsAsFile())
+            {
+                reportMissing(caseName, goldenFile);
+                return;
+            }
+
+            juce::StringArray golden;
+            golden.addLines(goldenFile.loadFileAsString());
+            golden.removeEmptyStrings();
+
+            for (int line = 0; line < juce::jmax(golden.size(), renderedEvents.size()); ++line)
+            {
+                if (golden[line] != renderedEvents[line])
+                {
+                    report(caseName, false, "event " + juce::String(line + 1) + ": golden \"" + golden[line]
+                                            + "\", render \"" + renderedEvents[line] + "\"");
+                    return;
+                }
+            }
+
+            report(caseName, true, juce::String(renderedEvents.size()) + " events");
+        }
+
+        // False once any case failed (or couldn't be written, with --update).
+        bool AllPassed() const
+        {
+            return allPassed;
+        }
+
+        // What main returns: 1 on any failure (a missing golden included), else SkipExitCode
+        // if --allow-missing let a golden be missing, else 0.
+        int GetExitCode() const
+        {
+            if (!allPassed)
+                return 1;
+
+            return numMissingGoldens > 0 ? SkipExitCode : 0;
+        }
+
+    private:
+        void report(const juce::String& caseName, bool passed, const juce::String& details)
+        {
+            std::cout << caseName << (passed ? "  ok" : "  FAILED") << (details.startsWith("\n") ? "" : "  ")
+                      << details << std::endl;
+
+            allPassed = allPassed && passed;
+        }
+
+        void reportMissing(const juce::String& caseName, const juce::File& goldenFile)
+        {
+            if (!options.AllowMissing)
+            {
+                report(caseName, false, "no golden at " + goldenFile.getFullPathName() + " (run with --update)");
+                return;
+            }
+
+            std::cout << caseName << "  SKIPPED  no golden at " << goldenFile.getFullPathName()
+                      << " (run with --update)" << std::endl;
+
+            ++numMissingGoldens;
+        }
+
+        static std::vector<float> getChannel(const juce::AudioBuffer<float>& buffer, int channel)
+        {
+            const float* samples = buffer.getReadPointer(channel);
+            return std::vector<float>(samples, samples + buffer.getNumSamples());
+        }
+
+        static juce::String getChannelName(int channel, int numChannels)
+        {
+            if (numChannels == 2)
+                return channel == 0 ? "L" : "R";
+
+            return "channel " + juce::String(channel + 1);
+        }
+
+        static juce::String describeFormat(const juce::AudioBuffer<float>& buffer, double sampleRate)
+        {
+            return juce::String(buffer.getNumChannels()) + " ch x " + juce::String(buffer.getNumSamples())
+                 + " samples at " + juce::String(sampleRate) + " Hz";
+        }
+
+        static bool readAudio(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate)
+        {
+            juce::WavAudioFormat wavFormat;
+            std::unique_ptr<juce::AudioFormatReader> reader(wavFormat.createReaderFor(file.createInputStream().release(), true));
+
+            if (reader == nullptr || reader->numChannels == 0)
+                return false;
+
+            buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+            reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+
+            sampleRate = reader->sampleRate;
+            return true;
+        }
+
+        static bool writeAudio(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate)
+        {
+            file.deleteFile();
+
+            std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+
+            if (stream == nullptr)
+                return false;
+
+            juce::WavAudioFormat wavFormat;
+            std::unique_ptr<juce::AudioFormatWriter> writer(
+                wavFormat.createWriterFor(stream.get(), sampleRate, static_cast<unsigned int>(buffer.getNumChannels()), 32, {}, 0));
+
+            if (writer == nullptr)
+                return false;
+
+            // The writer owns the stream from here on.
+            stream.release();
+
+            return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+        }
+
+        Options options;
+        ChannelComparator comparator;
+        bool allPassed = true;
+        int numMissingGoldens = 0;
+    };
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "PaintProfiler.h"
+
+// Headless paint benchmark harness, shared by the plugins' Tools/PaintBench apps.
+//
+// Runs scripted UI scenarios against an editor that never gets a window. Each frame the
+// scenario's step runs (synthetic mouse events, tab switches, audio for the meters), the
+// editor's animation clock is advanced by hand, and the whole editor is rendered with
+// paintEntireComponent into an offscreen image. The DR_PROFILE_PAINT markers give the cost
+// per component, which is checked against a ms budget.
+//
+// Every frame renders the whole editor rather than the dirty region, so the numbers are
+// an upper bound on what the same interaction costs in a host.
+//
+// Needs a ScopedJuceInitialiser_GUI and DR_PAINT_PROFILING=1. Message thread only.
+namespace PaintBenchmark
+{
+    struct Budget
+    {
+        // Per component, per paint call.
+        double ComponentAverageMs = 0.5;
+        double ComponentWorstMs = 4.0;
+
+        // One render of the whole editor.
+        double FrameAverageMs = 8.0;
+    };
+
+    // [--component-avg-ms=] [--component-worst-ms=] [--frame-avg-ms=] over the defaults.
+    inline Budget ReadBudget(const juce::ArgumentList& arguments)
+    {
+        Budget budget;
+
+        if (arguments.containsOption("--component-avg-ms"))
+            budget.ComponentAverageMs = arguments.getValueForOption("--component-avg-ms").getDoubleValue();
+
+        if (arguments.containsOption("--component-worst-ms"))
+            budget.ComponentWorstMs = arguments.getValueForOption("--component-worst-ms").getDoubleValue();
+
+        if (arguments.containsOption("--frame-avg-ms"))
+            budget.FrameAverageMs = arguments.getValueForOption("--frame-avg-ms").getDoubleValue();
+
+        return budget;
+    }
+
+    // Every component of the given type under root (root included), in paint order.
+    template <typename ComponentType>
+    std::vector<ComponentType*> FindAll(juce::Component& root)
+    {
+        std::vector<ComponentType*> found;
+
+        if (auto* match = dynamic_cast<ComponentType*>(&root))
+            found.push_back(match);
+
+        for (auto* child : root.getChildren())
+        {
+            const auto childMatches = FindAll<ComponentType>(*child);
+            found.insert(found.end(), childMatches.begin(), childMatches.end());
+        }
+
+        return found;
+    }
+
+    // Whether the component would be on screen if the editor had a window. isShowing()
+    // is always false offscreen.
+    inline bool IsVisibleInEditor(const juce::Component& component)
+    {
+        for (auto* current = &component; current != nullptr; current = current->getParentComponent())
+            if (!current->isVisible())
+                return false;
+
+        return true;
+    }
+
+    // Feeds synthetic mouse events straight to a component, as its peer would.
+    class ScriptedMouse
+    {
+    public:
+        void Move(juce::Component& component, juce::Point<float> position)
+        {
+            component.mouseMove(makeEvent(component, position, {}, false));
+        }
+
+        void Exit(juce::Component& component)
+        {
+            component.mouseExit(makeEvent(component, {}, {}, false));
+        }
+
+        void Down(juce::Component& component, juce::Point<float> position)
+        {
+            mouseDownPosition = position;
+            mouseDownTime = juce::Time::getCurrentTime();
+
+            component.mouseDown(makeEvent(component, position, juce::ModifierKeys::leftButtonModifier, false));
+        }
+
+        void Drag(juce::Component& component, juce::Point<float> position)
+        {
+            component.mouseDrag(makeEvent(component, position, juce::ModifierKeys::leftButtonModifier, true));
+        }
+
+        void Up(juce::Component& component, juce::Point<float> position)
+        {
+            component.mouseUp(makeEvent(component, position, {}, position != mouseDownPosition));
+        }
+
+    private:
+        juce::MouseEvent makeEvent(juce::Component& component,
+                                   juce::Point<float> position,
+                                   juce::ModifierKeys modifiers,
+                                   bool wasDragged) const
+        {
+            return juce::MouseEvent(source,
+                                    position,
+                                    modifiers,
+                                    juce::MouseInputSource::defaultPressure,
+                                    juce::MouseInputSource::defaultOrientation,
+                                    juce::MouseInputSource::defaultRotation,
+                                    juce::MouseInputSource::defaultTiltX,
+                                    juce::MouseInputSource::defaultTiltY,
+                                    &component,
+                                    &component,
+                                    juce::Time::getCurrentTime(),
+                                    mouseDownPosition,
+                                    mouseDownTime,
+                                    1,
+                                    wasDragged);
+        }
+
+        juce::MouseInputSource source = juce::Desktop::getInstance().getMainMouseSource();
+
+        juce::Point<float> mouseDownPosition;
+        juce::Time mouseDownTime;
+    };
+
+    // One frame of the knob drag scenario: each slider in turn is pressed, dragged 60 px up
+    // and back over FramesPerDrag frames, and released.
+    inline void StepSliderDrags(ScriptedMouse& mouse, const std::vector<juce::Slider*>& sliders, int frameIndex)
+    {
+        constexpr int FramesPerDrag = 20;
+        constexpr float DragDistance = 60.0f;
+
+        if (sliders.empty())
+            return;
+
+        auto& slider = *sliders[static_cast<size_t>(frameIndex / FramesPerDrag) % sliders.size()];
+        const int phase = frameIndex % FramesPerDrag;
+
+        const juce::Point<float> centre = slider.getLocalBounds().getCentre().toFloat();
+
+        if (phase == 0)
+        {
+            mouse.Down(slider, centre);
+        }
+        else if (phase == FramesPerDrag - 1)
+        {
+            mouse.Up(slider, centre);
+        }
+        else
+        {
+            // Up for the first half, back down for the second.
+            const float progress = static_cast<float>(phase) / static_cast<float>(FramesPerDrag - 1);
+            const float offset = DragDistance * (1.0f - std::abs(2.0f * progress - 1.0f));
+
+            mouse.Drag(slider, centre.translated(0.0f, -offset));
+        }
+    }
+
+    class Runner
+    {
+    public:
+        static constexpr double FrameIntervalSeconds = 1.0 / 60.0;
+
+        using FrameStep = std::function<void(int frameIndex)>;
+
+        // advanceAnimation runs the editor's AnimationScheduler for one frame time.
+        Runner(juce::Component& editorToRender,
+               std::function<void(double frameTimeSeconds)> advanceAnimationFunction,
+               const Budget& budgetToCheck)
+            : editor(editorToRender),
+              advanceAnimation(std::move(advanceAnimationFunction)),
+              budget(budgetToCheck),
+              canvas(juce::Image::ARGB, std::max(1, editorToRender.getWidth()), std::max(1, editorToRender.getHeight()), true)
+        {
+            PaintProfiler::GetInstance()->StopReporting();
+        }
+
+        // Renders numFrames frames of one scenario and prints its report.
+        void Run(const juce::String& scenarioName, int numFrames, const FrameStep& step)
+        {
+            // Whatever setup painted doesn't count.
+            PaintProfiler::GetInstance()->TakeStats();
+
+            double totalFrameMs = 0.0;
+            double worstFrameMs = 0.0;
+
+            for (int frameIndex = 0; frameIndex < numFrames; ++frameIndex)
+            {
+                step(frameIndex);
+
+                frameTimeSeconds += FrameIntervalSeconds;
+                advanceAnimation(frameTimeSeconds);
+
+                juce::Graphics graphics(canvas);
+
+                const auto startTicks = juce::Time::getHighResolutionTicks();
+                editor.paintEntireComponent(graphics, true);
+                const double frameMs = juce::Time::highResolutionTicksToSeconds(
+                    juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+
+                totalFrameMs += frameMs;
+                worstFrameMs = std::max(worstFrameMs, frameMs);
+            }
+
+            const double averageFrameMs = totalFrameMs / std::max(1, numFrames);
+            const bool frameWithinBudget = averageFrameMs <= budget.FrameAverageMs;
+
+            std::cout << scenarioName << " (" << numFrames << " frames): frame avg "
+                      << juce::String(averageFrameMs, 3) << " ms, worst " << juce::String(worstFrameMs, 3)
+                      << " ms" << (frameWithinBudget ? "" : "   OVER BUDGET") << "\n";
+
+            withinBudget = withinBudget && frameWithinBudget;
+
+            auto stats = PaintProfiler::GetInstance()->TakeStats();
+
+            std::sort(stats.begin(), stats.end(),
+                [](const PaintProfiler::Stats& a, const PaintProfiler::Stats& b) { return a.TotalMs > b.TotalMs; });
+
+            for (const auto& entry : stats)
+            {
+                const double averageMs = entry.TotalMs / entry.Calls;
+                const bool componentWithinBudget = averageMs <= budget.ComponentAverageMs
+                                                   && entry.WorstMs <= budget.ComponentWorstMs;
+
+                std::cout << "    " << juce::String(entry.Name).paddedRight(' ', 44)
+                          << juce::String(entry.Calls).paddedLeft(' ', 7) << " paints"
+                          << "   avg " << juce::String(averageMs, 3) << " ms"
+                          << "   worst " << juce::String(entry.WorstMs, 3) << " ms"
+                          << (componentWithinBudget ? "" : "   OVER BUDGET") << "\n";
+
+                withinBudget = withinBudget && componentWithinBudget;
+            }
+        }
+
+        // False once any scenario went over budget.
+        bool AllWithinBudget() const
+        {
+            return withinBudget;
+        }
+
+    private:
+        juce::Component& editor;
+        std::function<void(double)> advanceAnimation;
+        Budget budget;
+
+        juce::Image canvas;
+        double frameTimeSeconds = 0.0;
+        bool withinBudget = true;
+    };
+}
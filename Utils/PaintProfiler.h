@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+// Opt-in paint timing, to get per-component numbers before and after UI changes. Shared by
+// every plugin in the repo: each one adds this folder to its include path.
+//
+// Build with DR_PAINT_PROFILING=1 (cmake -DDR_PAINT_PROFILING=ON) and put
+// DR_PROFILE_PAINT("Name") at the top of a paint() or LookAndFeel draw call. Every couple
+// of seconds the profiler logs, per name: calls, average and worst ms per call, and the
+// ms per second spent there. Compiles to nothing when disabled.
+//
+// The headless paint benchmarks (Tools/PaintBench) always build with it on and read the
+// numbers back through TakeStats() instead of the log.
+#ifndef DR_PAINT_PROFILING
+ #define DR_PAINT_PROFILING 0
+#endif
+
+class PaintProfiler : private juce::Timer,
+                      private juce::DeletedAtShutdown
+{
+public:
+    static constexpr int ReportIntervalMilliseconds = 2000;
+
+    struct Stats
+    {
+        const char* Name = nullptr;
+
+        int Calls = 0;
+        double TotalMs = 0.0;
+        double WorstMs = 0.0;
+    };
+
+    // Message thread only.
+    class ScopedPaint
+    {
+    public:
+        explicit ScopedPaint(const char* newName)
+            : name(newName), startTicks(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedPaint()
+        {
+            const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+            PaintProfiler::GetInstance()->record(name, juce::Time::highResolutionTicksToSeconds(elapsedTicks) * 1000.0);
+        }
+
+    private:
+        const char* name;
+        juce::int64 startTicks;
+    };
+
+    // Message thread only. Freed by DeletedAtShutdown.
+    static PaintProfiler* GetInstance()
+    {
+        if (instance == nullptr)
+            instance = new PaintProfiler();
+
+        return instance;
+    }
+
+    // Returns everything recorded since the last report or call, and starts over.
+    std::vector<Stats> TakeStats()
+    {
+        std::vector<Stats> taken;
+
+        for (auto& entry : stats)
+        {
+            if (entry.Calls > 0)
+                taken.push_back(entry);
+
+            entry = Stats { entry.Name };
+        }
+
+        return taken;
+    }
+
+    // For callers that read TakeStats() themselves.
+    void StopReporting()
+    {
+        stopTimer();
+    }
+
+private:
+    PaintProfiler()
+    {
+        startTimer(ReportIntervalMilliseconds);
+    }
+
+    ~PaintProfiler() override
+    {
+        instance = nullptr;
+    }
+
+    void record(const char* name, double milliseconds)
+    {
+        auto found = std::find_if(stats.begin(), stats.end(),
+            [name](const Stats& entry) { return entry.Name == name; });
+
+        if (found == stats.end())
+            found = stats.insert(stats.end(), Stats { name });
+
+        found->Calls++;
+        found->TotalMs += milliseconds;
+        found->WorstMs = std::max(found->WorstMs, milliseconds);
+    }
+
+    void timerCallback() override
+    {
+        const double seconds = ReportIntervalMilliseconds / 1000.0;
+
+        for (const auto& entry : TakeStats())
+        {
+            juce::Logger::writeToLog(juce::String(entry.Name)
+                + ": " + juce::String(entry.Calls) + " paints"
+                + ", avg " + juce::String(entry.TotalMs / entry.Calls, 3) + " ms"
+                + ", worst " + juce::String(entry.WorstMs, 3) + " ms"
+                + ", " + juce::String(entry.TotalMs / seconds, 2) + " ms/s");
+        }
+    }
+
+    inline static PaintProfiler* instance = nullptr;
+
+    std::vector<Stats> stats;
+};
+
+#if DR_PAINT_PROFILING
+ #define DR_PROFILE_PAINT(name) const PaintProfiler::ScopedPaint JUCE_JOIN_MACRO(paintProfile, __LINE__) (name)
+#else
+ #define DR_PROFILE_PAINT(name)
+#endif